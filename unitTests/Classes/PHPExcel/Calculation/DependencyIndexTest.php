@@ -0,0 +1,29 @@
+<?php
+
+class DependencyIndexTest extends PHPUnit_Framework_TestCase
+{
+    public function testFind()
+    {
+        $index = new \ZExcel\Calculation\DependencyIndex();
+        for ($row = 1; $row <= 5000; ++$row) {
+            $index->add('B' . $row, 1, $row, 1, $row, $row);
+        }
+        $index->add('SUM', 1, 1, 1, 1048576, 'sum');
+        $index->add('C', 3, 10, 5, 20, 'c');
+
+        $this->assertEquals(array('B42' => 42, 'SUM' => 'sum'), $index->find(1, 42, 1, 42));
+        $this->assertEquals(array('C' => 'c'), $index->find(4, 15, 4, 15));
+        $this->assertEquals(array(), $index->find(2, 1, 2, 1048576));
+        $this->assertEquals(array('SUM' => 'sum'), $index->find(1, 6000, 1, 6000));
+
+        $found = $index->find(1, 4990, 3, 1048576);
+        $this->assertCount(12, $found);
+        $this->assertEquals(4990, $found['B4990']);
+        $this->assertEquals('sum', $found['SUM']);
+
+        $index->remove('SUM');
+        $this->assertEquals(array('B42' => 42), $index->find(1, 42, 1, 42));
+        $this->assertFalse($index->has('SUM'));
+        $this->assertTrue($index->has('C'));
+    }
+}
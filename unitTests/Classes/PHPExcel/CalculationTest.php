@@ -23,4 +23,438 @@ class CalculationTest extends PHPUnit_Framework_TestCase
     {
         return new testDataFileIterator('rawTestData/CalculationBinaryComparisonOperation.data');
     }
+
+    /**
+     * @dataProvider providerArrayArithmetic
+     */
+    public function testArrayArithmetic($formula, $expectedResult)
+    {
+        \ZExcel\Calculation\Functions::setCompatibilityMode(\ZExcel\Calculation\Functions::COMPATIBILITY_EXCEL);
+        $result = \ZExcel\Calculation::getInstance()->_calculateFormulaValue($formula);
+        $this->assertEquals($expectedResult, $result);
+    }
+
+    public function providerArrayArithmetic()
+    {
+        return array(
+            array('=SUM({1,2,3}*{4,5,6})', 32),
+            array('=SUM({1,2,3}*{4;5})', 54),
+            array('=SUM({1,2;3,4}+10)', 50),
+            array('=SUM(-{1,2,3})', -6),
+            array('=SUM(({1,2,3}>1)*1)', 2),
+            array('=SUM({1,2,3}^2)', 14),
+        );
+    }
+
+    public function testCompiledFormulaeAreSharedBetweenCells()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $sheet = $workbook->getActiveSheet();
+        $sheet->setCellValue('A1', 2)
+            ->setCellValue('A2', -5)
+            ->setCellValue('B1', '=ABS(A2)+SUM(A1,A2,4)')
+            ->setCellValue('B2', '=ABS(A2)+SUM(A1,A2,4)')
+            ->setCellValue('B3', '=SUM({1,2;3,4})');
+
+        $this->assertEquals(6, $sheet->getCell('B1')->getCalculatedValue());
+        $this->assertEquals(6, $sheet->getCell('B2')->getCalculatedValue());
+        $this->assertEquals(10, $sheet->getCell('B3')->getCalculatedValue());
+    }
+
+    public function testTraceKeepsMostRecentEvents()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $sheet = $workbook->getActiveSheet();
+        $sheet->setCellValue('A1', 2)
+            ->setCellValue('A2', 3)
+            ->setCellValue('B1', '=A1+A2')
+            ->setCellValue('B2', '=SUM(A1:A2)');
+
+        $calculation = \ZExcel\Calculation::getInstance($workbook);
+        $calculation->getDebugLog()->setWriteTrace(true, 2);
+        $calculation->calculateCellValue($sheet->getCell('B1'));
+        $calculation->calculateCellValue($sheet->getCell('B1'));
+        $calculation->calculateCellValue($sheet->getCell('B2'));
+
+        $trace = $calculation->getDebugLog()->getTrace();
+        $this->assertCount(2, $trace);
+        $this->assertEquals('Worksheet!B1', $trace[0]['cell']);
+        $this->assertTrue($trace[0]['cacheHit']);
+        $this->assertEquals(2, $trace[0]['dependencies']);
+        $this->assertEquals('Worksheet!B2', $trace[1]['cell']);
+        $this->assertEquals('=SUM(A1:A2)', $trace[1]['formula']);
+        $this->assertFalse($trace[1]['cacheHit']);
+        $this->assertEquals(1, $trace[1]['dependencies']);
+    }
+
+    public function testRangeOperandsSkipEmptyCells()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $sheet = $workbook->getActiveSheet();
+        $sheet->setCellValue('A1', 1)
+            ->setCellValue('A3', 2)
+            ->setCellValue('A4', '=A1*10')
+            ->setCellValue('B1', '=SUM(A1:A100000)')
+            ->setCellValue('B2', '=COUNT(A1:A100000)');
+
+        $this->assertEquals(13, $sheet->getCell('B1')->getCalculatedValue());
+        $this->assertEquals(3, $sheet->getCell('B2')->getCalculatedValue());
+        $this->assertCount(4, $sheet->extractCalculationBlock(1, 1, 1, 100000));
+        $this->assertCount(1, $sheet->extractCalculationBlock(1, 1, 50, 100000));
+    }
+
+    public function testRangeShapeIncludesEmptyRows()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $sheet = $workbook->getActiveSheet();
+        $sheet->setCellValue('A1', 1)
+            ->setCellValue('A3', 2)
+            ->setCellValue('B1', '=ROWS(A1:A10)')
+            ->setCellValue('B2', '=COUNTBLANK(A1:A10)')
+            ->setCellValue('B3', '=SUMPRODUCT(A1:A10,Other!A1:A10)')
+            ->setCellValue('B4', '=COUNTIF(A1:A10,"")')
+            ->setCellValue('B5', '=SUMIF(A1:A10,"",Other!A1:A10)')
+            ->setCellValue('B6', '=SUMPRODUCT(--(A1:A10=""))')
+            ->setCellValue('B7', '=COUNTBLANK(INDIRECT("A1:A10"))')
+            ->setCellValue('B8', '=COUNTBLANK(OFFSET(A1,0,0,10,1))');
+        $other = $workbook->createSheet();
+        $other->setTitle('Other');
+        $other->fromArray(array(array(3), array(5), array(7), array(9), array(11)));
+
+        $this->assertEquals(10, $sheet->getCell('B1')->getCalculatedValue());
+        $this->assertEquals(8, $sheet->getCell('B2')->getCalculatedValue());
+        $this->assertEquals(17, $sheet->getCell('B3')->getCalculatedValue());
+        $this->assertEquals(8, $sheet->getCell('B4')->getCalculatedValue());
+        $this->assertEquals(25, $sheet->getCell('B5')->getCalculatedValue());
+        $this->assertEquals(8, $sheet->getCell('B6')->getCalculatedValue());
+        $this->assertEquals(8, $sheet->getCell('B7')->getCalculatedValue());
+        $this->assertEquals(8, $sheet->getCell('B8')->getCalculatedValue());
+    }
+
+    public function testCalculationCacheIsPartitionedByWorksheet()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $calculation = \ZExcel\Calculation::getInstance($workbook);
+
+        $calculation->saveValueToCache('Sheet1', 'A1', 1);
+        $calculation->saveValueToCache('Sheet2', 'A1', 2);
+        $calculation->clearCalculationCacheForWorksheet('Sheet1');
+        $this->assertFalse($calculation->getValueFromCache('Sheet1', 'A1'));
+        $this->assertEquals(2, $calculation->getValueFromCache('Sheet2', 'A1'));
+
+        $calculation->renameCalculationCacheForWorksheet('Sheet2', 'Renamed');
+        $this->assertFalse($calculation->getValueFromCache('Sheet2', 'A1'));
+        $this->assertEquals(2, $calculation->getValueFromCache('Renamed', 'A1'));
+
+        $calculation->setCalculationCacheLimit(2);
+        $calculation->saveValueToCache('Sheet3', 'A1', 3);
+        $calculation->saveValueToCache('Sheet3', 'A2', 4);
+        $this->assertFalse($calculation->getValueFromCache('Renamed', 'A1'));
+        $this->assertEquals(3, $calculation->getValueFromCache('Sheet3', 'A1'));
+        $this->assertEquals(4, $calculation->getValueFromCache('Sheet3', 'A2'));
+    }
+
+    public function testChangedCellsInvalidateOnlyTheirDependents()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $calculation = \ZExcel\Calculation::getInstance($workbook);
+        $sheet = $workbook->getActiveSheet();
+        $other = $workbook->createSheet();
+        $other->setTitle('Other');
+        $other->setCellValue('A1', 10);
+        $other->setCellValue('A2', 20);
+        $sheet->setCellValue('A1', 1)
+            ->setCellValue('B1', '=A1*2')
+            ->setCellValue('B2', '=SUM(Other!A1:A2)')
+            ->setCellValue('B3', '=INDIRECT("Other!A1")+1')
+            ->setCellValue('B4', '=B1+1');
+
+        $this->assertEquals(2, $sheet->getCell('B1')->getCalculatedValue());
+        $this->assertEquals(30, $sheet->getCell('B2')->getCalculatedValue());
+        $this->assertEquals(11, $sheet->getCell('B3')->getCalculatedValue());
+        $this->assertEquals(3, $sheet->getCell('B4')->getCalculatedValue());
+
+        $other->setCellValue('A1', 100);
+        $this->assertEquals(2, $calculation->getValueFromCache($sheet->getTitle(), 'B1'));
+        $this->assertEquals(3, $calculation->getValueFromCache($sheet->getTitle(), 'B4'));
+        $this->assertEquals(120, $sheet->getCell('B2')->getCalculatedValue());
+        $this->assertEquals(101, $sheet->getCell('B3')->getCalculatedValue());
+
+        $sheet->setCellValue('A1', 5);
+        $this->assertFalse($calculation->getValueFromCache($sheet->getTitle(), 'B4'));
+        $this->assertEquals(120, $calculation->getValueFromCache($sheet->getTitle(), 'B2'));
+        $this->assertEquals(11, $sheet->getCell('B4')->getCalculatedValue());
+    }
+
+    public function testBlockWritesInvalidateOnlyTheFormulaeReadingTheBlock()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $calculation = \ZExcel\Calculation::getInstance($workbook);
+        $sheet = $workbook->getActiveSheet();
+        for ($row = 1; $row <= 200; ++$row) {
+            $sheet->setCellValue('A' . $row, $row);
+            $sheet->setCellValue('B' . $row, '=A' . $row . '*2');
+            $this->assertEquals($row * 2, $sheet->getCell('B' . $row)->getCalculatedValue());
+        }
+
+        $sheet->setCellValues(
+            array_fill(0, 11, array(1)),
+            'A50',
+            array('A' => \ZExcel\Cell\DataType::TYPE_NUMERIC)
+        );
+
+        $this->assertEquals(98, $calculation->getValueFromCache($sheet->getTitle(), 'B49'));
+        $this->assertFalse($calculation->getValueFromCache($sheet->getTitle(), 'B55'));
+        $this->assertEquals(122, $calculation->getValueFromCache($sheet->getTitle(), 'B61'));
+        $this->assertEquals(2, $sheet->getCell('B55')->getCalculatedValue());
+    }
+
+    public function testCalculationCacheLimitKeepsTheWorksheetBeingCalculated()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $calculation = \ZExcel\Calculation::getInstance($workbook);
+        $calculation->setCalculationCacheLimit(4);
+
+        $calculation->saveValueToCache('Sheet1', 'A1', 1);
+        $calculation->saveValueToCache('Sheet2', 'A1', 1);
+        $calculation->saveValueToCache('Sheet2', 'A2', 2);
+        $calculation->saveValueToCache('Sheet2', 'A3', 3);
+        $calculation->saveValueToCache('Sheet2', 'A4', 4);
+
+        //    Room is made for a quarter of the limit, starting with the other worksheets
+        $this->assertFalse($calculation->getValueFromCache('Sheet1', 'A1'));
+        $this->assertEquals(3, $calculation->getValueFromCache('Sheet2', 'A3'));
+        $this->assertEquals(4, $calculation->getValueFromCache('Sheet2', 'A4'));
+        $statistics = $calculation->getCalculationCacheStatistics();
+        $this->assertEquals(3, $statistics['entries']);
+    }
+
+    public function testCrossSheetReferencesFollowRenamedWorksheets()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $data = $workbook->createSheet();
+        $data->setTitle('Data');
+        $data->setCellValue('A1', 21);
+
+        $this->assertSame($data, $workbook->getSheetByName('Data'));
+
+        $data->setTitle('Source');
+        $this->assertNull($workbook->getSheetByName('Data'));
+        $this->assertSame($data, $workbook->getSheetByName('Source'));
+
+        $sheet = $workbook->getSheet(0);
+        $sheet->setCellValue('A1', '=Source!A1*2');
+        $this->assertEquals(42, $sheet->getCell('A1')->getCalculatedValue());
+
+        $workbook->removeSheetByIndex($workbook->getIndex($data));
+        $this->assertFalse($workbook->sheetNameExists('Source'));
+    }
+
+    public function testWorkbookKeepsItsCalculationEngine()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $calculation = \ZExcel\Calculation::getInstance($workbook);
+
+        $this->assertSame($calculation, $workbook->getCalculationEngine());
+        $this->assertSame($calculation, \ZExcel\Calculation::getInstance($workbook));
+        $this->assertNotSame($calculation, \ZExcel\Calculation::getInstance(new \ZExcel\ZExcel()));
+
+        $sheet = $workbook->getActiveSheet();
+        $sheet->setCellValue('A1', 2);
+        $sheet->setCellValue('B1', '=A1*3');
+        $calculation->resetCalculationCacheStatistics();
+
+        $this->assertEquals(6, $sheet->getCell('B1')->getCalculatedValue());
+        $this->assertEquals(6, $sheet->getCell('B1')->getCalculatedValue());
+        $statistics = $calculation->getCalculationCacheStatistics();
+        $this->assertEquals(1, $statistics['hits']);
+        $this->assertEquals(1, $statistics['misses']);
+
+        $sheet->setCellValue('A1', 5);
+        $this->assertEquals(15, $sheet->getCell('B1')->getCalculatedValue());
+    }
+
+    public function testRecalculateEvaluatesEachFormulaOnce()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $sheet = $workbook->getActiveSheet();
+        $data = $workbook->createSheet();
+        $data->setTitle('Data');
+        $data->setCellValue('A1', 4);
+        $data->setCellValue('A2', '=A1*2');
+
+        $sheet->setCellValue('C1', '=SUM(A1:B2)');
+        $sheet->setCellValue('A1', '=Data!A2+1');
+        $sheet->setCellValue('B2', '=A1*10');
+
+        $statistics = $workbook->recalculate(array('slowest' => 2));
+
+        $this->assertEquals(4, $statistics['formulae']);
+        $this->assertEquals(0, $statistics['errors']);
+        $this->assertEquals(0, $statistics['cycles']);
+        $this->assertEquals(1, $statistics['sheets']['Data']['formulae']);
+        $this->assertCount(2, $statistics['slowest']);
+        // Every formula was computed once, each reference to a formula cell was a cache hit
+        $this->assertEquals(4, $statistics['cache']['misses']);
+        $this->assertEquals(99, $sheet->getCell('C1')->getOldCalculatedValue());
+        $this->assertEquals(90, $sheet->getCell('B2')->getOldCalculatedValue());
+    }
+
+    public function testRecalculateDoesNotDependOnTheCacheSettings()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $sheet = $workbook->getActiveSheet();
+        $sheet->setCellValue('A1', 4);
+        $sheet->setCellValue('A2', '=A1*2');
+        $sheet->setCellValue('A3', '=A2+A2');
+        $sheet->setCellValue('A4', '=A2+A3');
+        $calculation = $workbook->getCalculationEngine();
+        $calculation->disableCalculationCache();
+        $calculation->setCalculationCacheLimit(1);
+
+        $statistics = $workbook->recalculate();
+
+        $this->assertEquals(3, $statistics['cache']['misses']);
+        $this->assertEquals(24, $sheet->getCell('A4')->getOldCalculatedValue());
+        $this->assertFalse($calculation->getCalculationCacheEnabled());
+        $this->assertEquals(1, $calculation->getCalculationCacheLimit());
+    }
+
+    public function testTrustedCalculatedValuesStandUntilAnInputChanges()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $sheet = $workbook->getActiveSheet();
+        $sheet->setCellValue('A1', 2);
+        $sheet->setCellValue('A2', '=A1*10');
+        $sheet->setCellValue('A3', '=A2+1');
+        $sheet->setCellValue('B1', '=7');
+        // Values as read from a file, deliberately different from what the formulae give
+        $sheet->getCell('A2')->setCalculatedValue(100);
+        $sheet->getCell('A3')->setCalculatedValue(101);
+        $sheet->getCell('B1')->setCalculatedValue(8);
+
+        $workbook->getCalculationEngine()->setTrustCachedValues(true);
+        $this->assertEquals(101, $sheet->getCell('A3')->getCalculatedValue());
+
+        $sheet->setCellValue('A1', 3);
+        $this->assertEquals(31, $sheet->getCell('A3')->getCalculatedValue());
+        $this->assertEquals(30, $sheet->getCell('A2')->getOldCalculatedValue());
+        // B1 does not depend on A1
+        $this->assertEquals(8, $sheet->getCell('B1')->getCalculatedValue());
+    }
+
+    public function testQueuedChangesAreResolvedAtTheNextTrustedRead()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $sheet = $workbook->getActiveSheet();
+        $sheet->setCellValue('C1', '=SUM(A1:A100)');
+        $sheet->setCellValue('C2', '=C1+1');
+        $sheet->setCellValue('D1', '=B1');
+        $sheet->getCell('C1')->setCalculatedValue(1000);
+        $sheet->getCell('C2')->setCalculatedValue(1001);
+        $sheet->getCell('D1')->setCalculatedValue(7);
+
+        $workbook->getCalculationEngine()->setTrustCachedValues(true);
+        $this->assertEquals(1001, $sheet->getCell('C2')->getCalculatedValue());
+
+        for ($row = 1; $row <= 50; ++$row) {
+            $sheet->setCellValue('A' . $row, 1);
+            $sheet->setCellValue('A' . $row, 2);
+        }
+        // Typed values written to new cells are reported as one block
+        $sheet->setCellValues(array_fill(0, 50, array(1)), 'A51', array('A' => \ZExcel\Cell\DataType::TYPE_NUMERIC));
+
+        $this->assertEquals(151, $sheet->getCell('C2')->getCalculatedValue());
+        $this->assertEquals(7, $sheet->getCell('D1')->getCalculatedValue());
+    }
+
+    public function testDynamicFormulaeAndTheirDependentsAreNeverTrusted()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $sheet = $workbook->getActiveSheet();
+        $sheet->setCellValue('B1', 5);
+        $sheet->setCellValue('A1', '=INDIRECT("B1")');
+        $sheet->setCellValue('A2', '=A1+1');
+        $sheet->setCellValue('A3', '=ROWS(C1:C2)');
+        $sheet->getCell('A1')->setCalculatedValue(1);
+        $sheet->getCell('A2')->setCalculatedValue(100);
+        $sheet->getCell('A3')->setCalculatedValue(9);
+
+        $workbook->getCalculationEngine()->setTrustCachedValues(true);
+        $this->assertEquals(5, $sheet->getCell('A1')->getCalculatedValue());
+        $this->assertEquals(6, $sheet->getCell('A2')->getCalculatedValue());
+        $this->assertEquals(9, $sheet->getCell('A3')->getCalculatedValue());
+
+        // INDIRECT reads B1 without referencing it
+        $sheet->setCellValue('B1', 7);
+        $this->assertEquals(8, $sheet->getCell('A2')->getCalculatedValue());
+    }
+
+    public function testDeletedCellsInvalidateTrustedCalculatedValues()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $sheet = $workbook->getActiveSheet();
+        $sheet->setCellValue('A1', 2);
+        $sheet->setCellValue('A2', '=A1*10');
+        $sheet->getCell('A2')->setCalculatedValue(100);
+
+        $workbook->getCalculationEngine()->setTrustCachedValues(true);
+        $this->assertEquals(100, $sheet->getCell('A2')->getCalculatedValue());
+
+        $sheet->getCellCacheController()->deleteCacheData('A1');
+        $this->assertEquals(0, $sheet->getCell('A2')->getCalculatedValue());
+    }
+
+    public function testRecalculateReplacesTrustedCalculatedValues()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $sheet = $workbook->getActiveSheet();
+        $sheet->setCellValue('A1', 2);
+        $sheet->setCellValue('A2', '=A1*10');
+        $sheet->getCell('A2')->setCalculatedValue(100);
+        $calculation = $workbook->getCalculationEngine();
+        $calculation->setTrustCachedValues(true);
+
+        $statistics = $workbook->recalculate();
+
+        $this->assertEquals(1, $statistics['cache']['misses']);
+        $this->assertEquals(20, $sheet->getCell('A2')->getOldCalculatedValue());
+        $this->assertTrue($calculation->getTrustCachedValues());
+        $this->assertEquals(20, $sheet->getCell('A2')->getCalculatedValue());
+    }
+
+    public function testLocaleFormulaRoundTrip()
+    {
+        $directory = sys_get_temp_dir() . DIRECTORY_SEPARATOR . 'zexcel_locale_' . uniqid();
+        mkdir($directory . DIRECTORY_SEPARATOR . 'fr', 0777, true);
+        file_put_contents(
+            $directory . DIRECTORY_SEPARATOR . 'fr' . DIRECTORY_SEPARATOR . 'functions',
+            "## French function names\nIF = SI\nSUM = SOMME\nTRUE = VRAI\nFALSE = FAUX\n"
+        );
+        file_put_contents(
+            $directory . DIRECTORY_SEPARATOR . 'fr' . DIRECTORY_SEPARATOR . 'config',
+            "ArgumentSeparator = ;\n"
+        );
+
+        $calculation = \ZExcel\Calculation::getInstance();
+        \ZExcel\Calculation::setLocaleFileDirectory($directory);
+        $this->assertTrue($calculation->setLocale('fr_fr'));
+
+        $english = '=IF(SUM(A1,2)>3,"a,b",TRUE)';
+        $localised = $calculation->_translateFormulaToLocale($english);
+        $this->assertEquals('=SI(SOMME(A1;2)>3;"a,b";VRAI)', $localised);
+        $this->assertEquals($english, $calculation->_translateFormulaToEnglish($localised));
+
+        //    Tables parsed once are reused when switching back to the locale
+        $this->assertTrue($calculation->setLocale('en_us'));
+        $this->assertTrue($calculation->setLocale('fr_fr'));
+        $this->assertEquals($localised, $calculation->_translateFormulaToLocale($english));
+
+        $calculation->setLocale('en_us');
+        \ZExcel\Calculation::setLocaleFileDirectory(null);
+        unlink($directory . DIRECTORY_SEPARATOR . 'fr' . DIRECTORY_SEPARATOR . 'functions');
+        unlink($directory . DIRECTORY_SEPARATOR . 'fr' . DIRECTORY_SEPARATOR . 'config');
+        rmdir($directory . DIRECTORY_SEPARATOR . 'fr');
+        rmdir($directory);
+    }
 }
@@ -0,0 +1,48 @@
+<?php
+
+
+class CoordinateTest extends PHPUnit_Framework_TestCase
+{
+
+    public function setUp()
+    {
+        
+    }
+
+    /**
+     * @dataProvider providerCoordinates
+     */
+    public function testParse($coordinate, $column, $row)
+    {
+        $packed = \ZExcel\Cell\Coordinate::parse($coordinate);
+        $this->assertEquals($column, \ZExcel\Cell\Coordinate::column($packed));
+        $this->assertEquals($row, \ZExcel\Cell\Coordinate::row($packed));
+        $this->assertEquals(str_replace('$', '', $coordinate), \ZExcel\Cell\Coordinate::format($packed));
+    }
+
+    public function providerCoordinates()
+    {
+        return array(
+            array('A1', 1, 1),
+            array('$B$7', 2, 7),
+            array('AA10', 27, 10),
+            array('XFD1048576', 16384, 1048576),
+        );
+    }
+
+    public function testInvalidCoordinates()
+    {
+        foreach (array('', 'A', '1', 'A1:B2', 'AAAA1', 'A12345678', '$$A1', 'A$1$', 'a1') as $coordinate) {
+            $this->assertEquals(\ZExcel\Cell\Coordinate::INVALID, \ZExcel\Cell\Coordinate::parse($coordinate), $coordinate);
+        }
+        $this->assertEquals(\ZExcel\Cell\Coordinate::pack(1, 1), \ZExcel\Cell\Coordinate::parse('a1', true));
+    }
+
+    public function testR1C1()
+    {
+        $packed = \ZExcel\Cell\Coordinate::parseR1C1('R7C2');
+        $this->assertEquals(\ZExcel\Cell\Coordinate::parse('B7'), $packed);
+        $this->assertEquals('R7C2', \ZExcel\Cell\Coordinate::formatR1C1($packed));
+        $this->assertEquals(\ZExcel\Cell\Coordinate::INVALID, \ZExcel\Cell\Coordinate::parseR1C1('R7'));
+    }
+}
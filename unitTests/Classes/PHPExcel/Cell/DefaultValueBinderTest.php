@@ -78,4 +78,36 @@ class DefaultValueBinderTest extends PHPUnit_Framework_TestCase
         $result = call_user_func(array('\ZExcel\Cell\DefaultValueBinder','dataTypeForValue'), $objRichText);
         $this->assertEquals($expectedResult, $result);
     }
+
+    public function testEachValueIsBoundThroughOnePath()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $worksheet = $workbook->getActiveSheet();
+        \ZExcel\Cell::setValueBinder(new \ZExcel\Cell\DefaultValueBinder());
+        \ZExcel\Cell\DefaultValueBinder::resetBindingCounters();
+        for ($row = 1; $row <= 20; ++$row) {
+            $worksheet->setCellValue('A' . $row, (string) ($row * 1.5));
+        }
+        $worksheet->setCellValue('A21', '007');
+
+        $counters = \ZExcel\Cell\DefaultValueBinder::getBindingCounters();
+        $this->assertEquals(20, $counters[\ZExcel\Cell\DataType::TYPE_NUMERIC]);
+        $this->assertEquals(1, $counters[\ZExcel\Cell\DataType::TYPE_STRING]);
+        $this->assertSame(30.0, $worksheet->getCell('A20')->getValue());
+        $this->assertEquals(\ZExcel\Cell\DataType::TYPE_STRING, $worksheet->getCell('A21')->getDataType());
+
+        \ZExcel\Cell::setValueBinder(new \ZExcel\Cell\AdvancedValueBinder());
+        \ZExcel\Cell\DefaultValueBinder::resetBindingCounters();
+        $worksheet->setCellValue('B1', 'plain text');
+        $worksheet->setCellValue('B2', '12');
+        $worksheet->setCellValue('B3', '50%');
+
+        $counters = \ZExcel\Cell\DefaultValueBinder::getBindingCounters();
+        $this->assertEquals(1, $counters['plain']);
+        $this->assertEquals(1, $counters['advanced']);
+        $this->assertEquals(1, $counters[\ZExcel\Cell\DataType::TYPE_STRING]);
+        $this->assertEquals(1, $counters[\ZExcel\Cell\DataType::TYPE_NUMERIC]);
+        $this->assertEquals(0.5, $worksheet->getCell('B3')->getValue());
+        \ZExcel\Cell::setValueBinder(new \ZExcel\Cell\DefaultValueBinder());
+    }
 }
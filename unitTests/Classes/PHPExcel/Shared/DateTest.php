@@ -181,4 +181,33 @@ class DateTest extends PHPUnit_Framework_TestCase
     {
         return new testDataFileIterator('rawTestData/Shared/DateTimeExcelToPHP1900Timezone.data');
     }
+
+    /**
+     * @dataProvider providerDateTimeExcelToCivil
+     */
+    public function testDateTimeExcelToCivil()
+    {
+        $args = func_get_args();
+        $expectedResult = array_pop($args);
+        call_user_func(array('\ZExcel\Shared\Date','setExcelCalendar'), array_shift($args));
+        $result = call_user_func_array(array('\ZExcel\Shared\Date','excelToCivil'), $args);
+        call_user_func(array('\ZExcel\Shared\Date','setExcelCalendar'), \ZExcel\Shared\Date::CALENDAR_WINDOWS_1900);
+        $this->assertEquals($expectedResult, $result);
+    }
+
+    public function providerDateTimeExcelToCivil()
+    {
+        return new testDataFileIterator('rawTestData/Shared/DateTimeExcelToCivil.data');
+    }
+
+    public function testDateTimeExcelToPHPObjectMatchesExcelToPHP()
+    {
+        call_user_func(array('\ZExcel\Shared\Date','setExcelCalendar'), \ZExcel\Shared\Date::CALENDAR_WINDOWS_1900);
+        foreach (array(1, 59, 61, 25569, 39611, 1234.56789, 12345.6789, 2958465) as $excelDate) {
+            $result = \ZExcel\Shared\Date::ExcelToPHPObject($excelDate);
+            $expectedResult = gmdate('Y-m-d H:i:s', \ZExcel\Shared\Date::ExcelToPHP($excelDate));
+            $this->assertEquals($expectedResult, $result->format('Y-m-d H:i:s'), "Excel date $excelDate");
+        }
+        $this->assertEquals('1900-03-01', \ZExcel\Shared\Date::ExcelToPHPObject(60)->format('Y-m-d'));
+    }
 }
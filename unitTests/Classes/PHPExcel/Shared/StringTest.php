@@ -76,4 +76,25 @@ class StringTest extends PHPUnit_Framework_TestCase
         $result = call_user_func(array('\ZExcel\Shared\Stringg','getCurrencyCode'));
         $this->assertEquals($expectedResult, $result);
     }
+
+    public function testControlCharacterOOXML2PHP()
+    {
+        $this->assertEquals('plain text', \ZExcel\Shared\Stringg::ControlCharacterOOXML2PHP('plain text'));
+        $this->assertEquals("a\x01b\x1F", \ZExcel\Shared\Stringg::ControlCharacterOOXML2PHP('a_x0001_b_x001F_'));
+        $this->assertEquals("_x_x\x08_", \ZExcel\Shared\Stringg::ControlCharacterOOXML2PHP('_x_x_x0008__'));
+        // Tab, lowercase digits, printable characters and truncated sequences are left as they are
+        $this->assertEquals('_x0009_ _x001f_ _x0041_ _x000', \ZExcel\Shared\Stringg::ControlCharacterOOXML2PHP('_x0009_ _x001f_ _x0041_ _x000'));
+    }
+
+    public function testControlCharacterPHP2OOXML()
+    {
+        $this->assertEquals("plain\ttext\n", \ZExcel\Shared\Stringg::ControlCharacterPHP2OOXML("plain\ttext\n"));
+        $this->assertEquals('_x0000_é_x001B_x', \ZExcel\Shared\Stringg::ControlCharacterPHP2OOXML("\x00é\x1Bx"));
+
+        $value = "line\x0Bbreak\x7F" . implode('', array_map('chr', range(0, 31)));
+        $this->assertEquals(
+            $value,
+            \ZExcel\Shared\Stringg::ControlCharacterOOXML2PHP(\ZExcel\Shared\Stringg::ControlCharacterPHP2OOXML($value))
+        );
+    }
 }
@@ -333,4 +333,326 @@ class AutoFilterTest extends PHPUnit_Framework_TestCase
         $result = clone $this->_testAutoFilterObject;
         $this->assertInstanceOf('\ZExcel\Worksheet\AutoFilter', $result);
     }
+
+    public function testShowHideRowsWithCustomFilter()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $worksheet = $workbook->getActiveSheet();
+        $worksheet->fromArray(array(array('Value'), array(1), array(5), array(3), array(8)));
+        $worksheet->setAutoFilter('A1:A5');
+
+        $autoFilter = $worksheet->getAutoFilter();
+        $autoFilter->getColumn('A')
+            ->setFilterType(\ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_CUSTOMFILTER)
+            ->createRule()
+            ->setRule(\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_GREATERTHAN, 3)
+            ->setRuleType(\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_CUSTOMFILTER);
+
+        $result = $autoFilter->showHideRows();
+        $this->assertInstanceOf('\ZExcel\Worksheet\AutoFilter', $result);
+
+        $visibility = array();
+        foreach (range(1, 5) as $row) {
+            $visibility[$row] = $worksheet->getRowDimension($row)->getVisible();
+        }
+        $this->assertEquals(array(1 => true, 2 => false, 3 => true, 4 => false, 5 => true), $visibility);
+    }
+
+    private function filteredWorksheet($values, $filterType, $rules, $join = null)
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $worksheet = $workbook->getActiveSheet();
+        $data = array(array('Heading'));
+        foreach ($values as $value) {
+            $data[] = array($value);
+        }
+        $worksheet->fromArray($data);
+        $lastRow = count($data);
+        $worksheet->setAutoFilter('A1:A' . $lastRow);
+
+        $column = $worksheet->getAutoFilter()->getColumn('A')->setFilterType($filterType);
+        foreach ($rules as $rule) {
+            list($operator, $value, $grouping, $ruleType) = $rule;
+            $column->createRule()->setRule($operator, $value, $grouping)->setRuleType($ruleType);
+        }
+        if ($join !== null) {
+            $column->setJoin($join);
+        }
+
+        $worksheet->getAutoFilter()->showHideRows();
+
+        return $worksheet;
+    }
+
+    /**
+     * @dataProvider providerShowHideRows
+     */
+    public function testShowHideRows($values, $filterType, $rules, $join, $expectedResult)
+    {
+        $worksheet = $this->filteredWorksheet($values, $filterType, $rules, $join);
+        $this->assertTrue($worksheet->getRowDimension(1)->getVisible());
+
+        $result = array();
+        foreach (range(2, count($values) + 1) as $row) {
+            $result[] = $worksheet->getRowDimension($row)->getVisible();
+        }
+        $this->assertEquals($expectedResult, $result);
+    }
+
+    public function providerShowHideRows()
+    {
+        $equal = \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_EQUAL;
+
+        return array(
+            //    Simple filter values, including blanks
+            array(
+                array('a', 'b', null, 'c', 'b'),
+                \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_FILTER,
+                array(
+                    array($equal, 'b', null, \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_FILTER),
+                    array($equal, '', null, \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_FILTER),
+                ),
+                null,
+                array(false, true, true, false, true),
+            ),
+            //    Date group: March 2012 (15-Mar-2012, 15-Apr-2012, 15-Mar-2011, 01-Mar-2012, blank)
+            array(
+                array(40983, 41014, 40617, 40969, null),
+                \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_FILTER,
+                array(
+                    array(
+                        $equal,
+                        array('year' => 2012, 'month' => 3),
+                        null,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP
+                    ),
+                ),
+                null,
+                array(true, false, false, true, false),
+            ),
+            //    Date group: two days, 15-Mar-2011 or 01-Mar-2012
+            array(
+                array(40983, 41014, 40617, 40969, null),
+                \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_FILTER,
+                array(
+                    array(
+                        $equal,
+                        array('year' => 2011, 'month' => 3, 'day' => 15),
+                        null,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP
+                    ),
+                    array(
+                        $equal,
+                        array('year' => 2012, 'month' => 3, 'day' => 1),
+                        null,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP
+                    ),
+                ),
+                null,
+                array(false, false, true, true, false),
+            ),
+            //    Custom filter: wildcard OR exact match
+            array(
+                array('apple', 'banana', 'Apricot', 'cherry', 12),
+                \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_CUSTOMFILTER,
+                array(
+                    array($equal, 'ap*', null, \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_CUSTOMFILTER),
+                    array($equal, 'cherry', null, \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_CUSTOMFILTER),
+                ),
+                \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_COLUMN_JOIN_OR,
+                array(true, false, true, true, false),
+            ),
+            //    Custom filter: numeric range, AND join
+            array(
+                array(1, 2, 4, 5, 7, null),
+                \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_CUSTOMFILTER,
+                array(
+                    array(
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_GREATERTHANOREQUAL,
+                        2,
+                        null,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_CUSTOMFILTER
+                    ),
+                    array(
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_LESSTHAN,
+                        5,
+                        null,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_CUSTOMFILTER
+                    ),
+                ),
+                \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_COLUMN_JOIN_AND,
+                array(false, true, true, false, false, false),
+            ),
+            //    Dynamic filter: above average (average 4)
+            array(
+                array(1, 2, 3, 10, 'text'),
+                \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_DYNAMICFILTER,
+                array(
+                    array(
+                        $equal,
+                        '',
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_ABOVEAVERAGE,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMICFILTER
+                    ),
+                ),
+                null,
+                array(false, false, false, true, false),
+            ),
+            //    Dynamic filter: below average (average 4)
+            array(
+                array(1, 2, 3, 10),
+                \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_DYNAMICFILTER,
+                array(
+                    array(
+                        $equal,
+                        '',
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_BELOWAVERAGE,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMICFILTER
+                    ),
+                ),
+                null,
+                array(true, true, true, false),
+            ),
+            //    Dynamic filter: March of any year
+            array(
+                array(40983, 41334, 41000, null),
+                \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_DYNAMICFILTER,
+                array(
+                    array(
+                        $equal,
+                        '',
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_MARCH,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMICFILTER
+                    ),
+                ),
+                null,
+                array(true, true, false, false),
+            ),
+            //    Dynamic filter: second quarter of any year
+            array(
+                array(41000, 41090, 41091, 40999),
+                \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_DYNAMICFILTER,
+                array(
+                    array(
+                        $equal,
+                        '',
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_QUARTER_2,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMICFILTER
+                    ),
+                ),
+                null,
+                array(true, true, false, false),
+            ),
+            //    Top 2 by value, with a duplicated best value; zero and blanks are ignored
+            array(
+                array(5, 9, 9, 3, 0, 7),
+                \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_TOPTENFILTER,
+                array(
+                    array(
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_TOPTEN_BY_VALUE,
+                        2,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_TOPTEN_TOP,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_TOPTENFILTER
+                    ),
+                ),
+                null,
+                array(false, true, true, false, false, false),
+            ),
+            //    Bottom 2 by value
+            array(
+                array(5, 9, 1, 3, 0, null),
+                \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_TOPTENFILTER,
+                array(
+                    array(
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_TOPTEN_BY_VALUE,
+                        2,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_TOPTEN_BOTTOM,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_TOPTENFILTER
+                    ),
+                ),
+                null,
+                array(false, false, true, true, false, false),
+            ),
+            //    Top 30 percent of 10 data rows, i.e. the 3 best values
+            array(
+                array(4, 8, 15, 16, 23, 42, 8, 15, 4, 1),
+                \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_TOPTENFILTER,
+                array(
+                    array(
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_TOPTEN_PERCENT,
+                        30,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_TOPTEN_TOP,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_TOPTENFILTER
+                    ),
+                ),
+                null,
+                array(false, false, false, true, true, true, false, false, false, false),
+            ),
+            //    Top 5 percent of 10 data rows still selects the best value
+            array(
+                array(4, 8, 15, 16, 23, 42, 8, 15, 4, 1),
+                \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_TOPTENFILTER,
+                array(
+                    array(
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_TOPTEN_PERCENT,
+                        5,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_TOPTEN_TOP,
+                        \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_TOPTENFILTER
+                    ),
+                ),
+                null,
+                array(false, false, false, false, false, true, false, false, false, false),
+            ),
+        );
+    }
+
+    public function testShowHideRowsRecordsTopTenThreshold()
+    {
+        //    The 3 best values are 9, 9 and 7
+        $worksheet = $this->filteredWorksheet(
+            array(5, 9, 9, 3, 7),
+            \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_TOPTENFILTER,
+            array(
+                array(
+                    \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_TOPTEN_BY_VALUE,
+                    3,
+                    \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_TOPTEN_TOP,
+                    \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_TOPTENFILTER
+                ),
+            )
+        );
+
+        $result = $worksheet->getAutoFilter()->getColumn('A')->getAttribute('maxVal');
+        $this->assertEquals(7, $result);
+    }
+
+    /**
+     * @dataProvider providerDynamicDateRange
+     */
+    public function testDynamicDateRange()
+    {
+        $args = func_get_args();
+        $expectedResult = array_pop($args);
+        $method = new ReflectionMethod('\ZExcel\Worksheet\AutoFilter', '_dynamicDateRange');
+        $method->setAccessible(true);
+        $result = $method->invokeArgs(null, $args);
+        $this->assertEquals($expectedResult, $result);
+    }
+
+    public function providerDynamicDateRange()
+    {
+        return new testDataFileIterator('rawTestData/Worksheet/AutoFilterDynamicDateRange.data');
+    }
+
+    public function testSerialDateRollsMonthsIntoAdjacentYears()
+    {
+        $method = new ReflectionMethod('\ZExcel\Worksheet\AutoFilter', '_serialDate');
+        $method->setAccessible(true);
+
+        $this->assertEquals(42370, $method->invoke(null, 2016, 1));
+        $this->assertEquals(42370, $method->invoke(null, 2015, 13));
+        $this->assertEquals(42339, $method->invoke(null, 2016, 0));
+        $this->assertEquals(42278, $method->invoke(null, 2016, -2));
+        $this->assertEquals(42461, $method->invoke(null, 2015, 16));
+    }
 }
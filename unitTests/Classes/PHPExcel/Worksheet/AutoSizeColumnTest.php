@@ -0,0 +1,67 @@
+<?php
+
+class AutoSizeColumnTest extends PHPUnit_Framework_TestCase
+{
+    private function columnWidth($worksheet, $column)
+    {
+        $worksheet->calculateColumnWidths();
+        return $worksheet->getColumnDimension($column)->getWidth();
+    }
+
+    private function autoSizedWorksheet()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $worksheet = $workbook->getActiveSheet();
+        $worksheet->getColumnDimension('A')->setAutoSize(true);
+        $worksheet->setCellValue('A1', 'short');
+        $worksheet->setCellValue('A2', 'a somewhat longer text');
+        return $worksheet;
+    }
+
+    public function testWrittenCellsAreMeasuredAgain()
+    {
+        $worksheet = $this->autoSizedWorksheet();
+        $initialWidth = $this->columnWidth($worksheet, 'A');
+
+        $worksheet->setCellValue('A3', 'a much, much longer text than any other cell of the column');
+        $widerWidth = $this->columnWidth($worksheet, 'A');
+        $this->assertGreaterThan($initialWidth, $widerWidth);
+
+        $worksheet->setCellValue('A3', 'tiny');
+        $this->assertEquals($initialWidth, $this->columnWidth($worksheet, 'A'));
+    }
+
+    public function testDeletedCellsNoLongerCount()
+    {
+        $worksheet = $this->autoSizedWorksheet();
+        $initialWidth = $this->columnWidth($worksheet, 'A');
+
+        $worksheet->setCellValue('A3', 'a much, much longer text than any other cell of the column');
+        $this->assertGreaterThan($initialWidth, $this->columnWidth($worksheet, 'A'));
+
+        $worksheet->getCellCacheController()->deleteCacheData('A3');
+        $this->assertEquals($initialWidth, $this->columnWidth($worksheet, 'A'));
+    }
+
+    public function testMergedCellsNoLongerCount()
+    {
+        $worksheet = $this->autoSizedWorksheet();
+        $worksheet->setCellValue('A3', 'a much, much longer text than any other cell of the column');
+        $widerWidth = $this->columnWidth($worksheet, 'A');
+
+        $worksheet->mergeCells('A3:B3');
+        $this->assertLessThan($widerWidth, $this->columnWidth($worksheet, 'A'));
+
+        $worksheet->unmergeCells('A3:B3');
+        $this->assertEquals($widerWidth, $this->columnWidth($worksheet, 'A'));
+    }
+
+    public function testDefaultFontChangeIsMeasuredAgain()
+    {
+        $worksheet = $this->autoSizedWorksheet();
+        $initialWidth = $this->columnWidth($worksheet, 'A');
+
+        $worksheet->getParent()->getDefaultStyle()->getFont()->setSize(30);
+        $this->assertGreaterThan($initialWidth, $this->columnWidth($worksheet, 'A'));
+    }
+}
@@ -23,4 +23,75 @@ class CellCollectionTest extends PHPUnit_Framework_TestCase
             \ZExcel\CachedObjectStorageFactory::finalize();
         }
     }
+
+    public function testPinnedCellIsNotReloaded()
+    {
+        $methods = \ZExcel\CachedObjectStorageFactory::getCacheStorageMethods();
+        foreach ($methods as $method) {
+            \ZExcel\CachedObjectStorageFactory::initialize($method);
+            $workbook = new \ZExcel\ZExcel();
+            $worksheet = $workbook->getActiveSheet();
+            $worksheet->setCellValue('A1', 1);
+            $worksheet->setCellValue('A2', '=A1+1');
+            $cells = $worksheet->getCellCacheController();
+
+            $this->assertTrue($cells->pinCell('A2'), "Cache method \"$method\".");
+            $pinned = $cells->getCacheData('A2');
+            $cells->getCacheData('A1');
+            $this->assertSame($pinned, $cells->getCacheData('A2'), "Cache method \"$method\".");
+            $this->assertEquals(2, $pinned->getCalculatedValue(), "Cache method \"$method\".");
+            $cells->unpinCell('A2');
+
+            $this->assertFalse($cells->pinCell('B1'), "Cache method \"$method\".");
+            \ZExcel\CachedObjectStorageFactory::finalize();
+        }
+    }
+
+    public function testHighestRowAndColumnFollowDeletions()
+    {
+        $methods = \ZExcel\CachedObjectStorageFactory::getCacheStorageMethods();
+        foreach ($methods as $method) {
+            \ZExcel\CachedObjectStorageFactory::initialize($method);
+            $workbook = new \ZExcel\ZExcel();
+            $worksheet = $workbook->getActiveSheet();
+            $worksheet->setCellValue('B2', 1);
+            $worksheet->setCellValue('D2', 2);
+            $worksheet->setCellValue('C9', 3);
+            $cells = $worksheet->getCellCacheController();
+
+            $this->assertEquals(array('row' => 9, 'column' => 'D'), $cells->getHighestRowAndColumn(), "Cache method \"$method\".");
+            $this->assertEquals('D', $cells->getHighestColumn(2), "Cache method \"$method\".");
+            $this->assertEquals(9, $cells->getHighestRow('C'), "Cache method \"$method\".");
+
+            $cells->deleteCacheData('C9');
+            $cells->deleteCacheData('D2');
+            $this->assertEquals(array('row' => 2, 'column' => 'B'), $cells->getHighestRowAndColumn(), "Cache method \"$method\".");
+            $this->assertEquals('B', $cells->getHighestColumn(2), "Cache method \"$method\".");
+            $this->assertEquals(0, $cells->getHighestRow('C'), "Cache method \"$method\".");
+
+            $cells->removeRow(2);
+            $this->assertEquals(array('row' => 1, 'column' => 'A'), $cells->getHighestRowAndColumn(), "Cache method \"$method\".");
+            \ZExcel\CachedObjectStorageFactory::finalize();
+        }
+    }
+
+    public function testSortedCellListAfterInterleavedInserts()
+    {
+        $methods = \ZExcel\CachedObjectStorageFactory::getCacheStorageMethods();
+        foreach ($methods as $method) {
+            \ZExcel\CachedObjectStorageFactory::initialize($method);
+            $workbook = new \ZExcel\ZExcel();
+            $worksheet = $workbook->getActiveSheet();
+            foreach (array('B2', 'AA2', 'A10', 'C2', 'A1', 'Z10', 'B10') as $cellID) {
+                $worksheet->setCellValue($cellID, $cellID);
+            }
+            $this->assertEquals(array('A1', 'B2', 'C2', 'AA2', 'A10', 'B10', 'Z10'), $worksheet->getCellCollection(), "Cache method \"$method\".");
+
+            $worksheet->getCellCacheController()->deleteCacheData('C2');
+            $worksheet->setCellValue('A2', 'A2');
+            $worksheet->setCellValue('AB10', 'AB10');
+            $this->assertEquals(array('A1', 'A2', 'B2', 'AA2', 'A10', 'B10', 'Z10', 'AB10'), $worksheet->getCellCollection(), "Cache method \"$method\".");
+            \ZExcel\CachedObjectStorageFactory::finalize();
+        }
+    }
 }
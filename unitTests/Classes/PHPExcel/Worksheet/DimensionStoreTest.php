@@ -0,0 +1,47 @@
+<?php
+
+class DimensionStoreTest extends PHPUnit_Framework_TestCase
+{
+    public function testViewsReadAndWriteTheStore()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $worksheet = $workbook->getActiveSheet();
+        $store = $worksheet->getRowDimensionStore();
+
+        $store->setSize(7, 30.5);
+        $store->setFlag(7, \ZExcel\Worksheet\DimensionStore::FLAG_HIDDEN);
+
+        $this->assertNull($worksheet->getRowDimension(8, false));
+
+        $rowDimension = $worksheet->getRowDimension(7, false);
+        $this->assertEquals(30.5, $rowDimension->getRowHeight());
+        $this->assertFalse($rowDimension->getVisible());
+        $this->assertNull($rowDimension->getXfIndex());
+
+        $rowDimension->setVisible(true)->setOutlineLevel(2);
+        $this->assertFalse($store->hasFlag(7, \ZExcel\Worksheet\DimensionStore::FLAG_HIDDEN));
+        $this->assertEquals(2, $store->getOutlineLevel(7));
+
+        $copy = clone $rowDimension;
+        $rowDimension->setRowHeight(12);
+        $this->assertEquals(30.5, $copy->getRowHeight());
+        $this->assertEquals(2, $copy->getOutlineLevel());
+    }
+
+    public function testHighestRowAndColumnFollowTheDimensions()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $worksheet = $workbook->getActiveSheet();
+
+        $worksheet->getCell('B2')->setValue(1);
+        $worksheet->getColumnDimensionStore()->setSize('AA', 20);
+        $worksheet->getRowDimensionStore()->setSize(500, 20);
+
+        $this->assertEquals(500, $worksheet->getHighestRow());
+        $this->assertEquals('AA', $worksheet->getHighestColumn());
+        $this->assertEquals(2, $worksheet->getHighestDataRow());
+
+        $worksheet->getRowDimensionStore()->remove(500);
+        $this->assertEquals(2, $worksheet->getHighestRow());
+    }
+}
@@ -0,0 +1,36 @@
+<?php
+
+class MergeIndexTest extends PHPUnit_Framework_TestCase
+{
+    public function testFind()
+    {
+        $index = new \ZExcel\Worksheet\MergeIndex(array('C1:D2' => 'C1:D2', 'A1:B1' => 'A1:B1', 'F2:H3' => 'F2:H3'));
+
+        $this->assertEquals('A1:B1', $index->find(2, 1));
+        $this->assertEquals('C1:D2', $index->find(3, 2));
+        $this->assertEquals('F2:H3', $index->find(8, 3));
+        $this->assertNull($index->find(5, 2));
+        $this->assertNull($index->find(1, 4));
+
+        $index->remove('C1:D2');
+        $this->assertNull($index->find(3, 2));
+        $this->assertEquals('F2:H3', $index->find(6, 2));
+    }
+
+    public function testCellMergeRangeFollowsMergeAndUnmerge()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $worksheet = $workbook->getActiveSheet();
+        $worksheet->setCellValue('A1', 'title');
+        $worksheet->setCellValue('B2', 'blanked');
+        $worksheet->mergeCells('A1:C2');
+
+        $this->assertNull($worksheet->getCell('B2')->getValue());
+        $this->assertEquals('A1:C2', $worksheet->getCell('C2')->getMergeRange());
+        $this->assertTrue($worksheet->getCell('A1')->isMergeRangeValueCell());
+        $this->assertFalse($worksheet->getCell('B2')->isMergeRangeValueCell());
+
+        $worksheet->unmergeCells('A1:C2');
+        $this->assertFalse($worksheet->getCell('C2')->isInMergeRange());
+    }
+}
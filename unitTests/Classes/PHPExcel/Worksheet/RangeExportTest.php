@@ -0,0 +1,63 @@
+<?php
+
+class RangeExportTest extends PHPUnit_Framework_TestCase
+{
+    public $worksheet;
+
+    public function setUp()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $this->worksheet = $workbook->getActiveSheet();
+        $this->worksheet->fromArray(
+            array(
+                array(1, 'a', 2.5),
+                array(2, 'b', null),
+                array(3, 'c', 4.5),
+            )
+        );
+        $this->worksheet->setCellValue('D1', '=A1+C1');
+    }
+
+    public function testRangeToColumnVectors()
+    {
+        $result = $this->worksheet->rangeToColumnVectors('A1:D3');
+        $this->assertEquals(array(1, 2, 3), $result[0]);
+        $this->assertEquals(array('a', 'b', 'c'), $result[1]);
+        $this->assertEquals(array(2.5, null, 4.5), $result[2]);
+        $this->assertEquals(3.5, $result[3][0]);
+    }
+
+    public function testRangeToColumnVectorsRawDoubles()
+    {
+        $result = $this->worksheet->rangeToColumnVectors('A1:A3', array('rawDoubles' => true, 'returnCellRef' => true));
+        $this->assertSame(array(1 => 1.0, 2 => 2.0, 3 => 3.0), $result['A']);
+    }
+
+    public function testRangeToRowBatch()
+    {
+        $result = $this->worksheet->rangeToRowBatch('A2:C3', array('nullValue' => ''));
+        $this->assertEquals(array(array(2, 'b', ''), array(3, 'c', 4.5)), $result);
+    }
+
+    public function testRowBatchIterator()
+    {
+        $batches = array();
+        foreach ($this->worksheet->getRowBatchIterator('A1:B3', 2) as $startRow => $batch) {
+            $batches[$startRow] = $batch;
+        }
+        $this->assertEquals(array(1, 3), array_keys($batches));
+        $this->assertEquals(array(array(1, 'a'), array(2, 'b')), $batches[1]);
+        $this->assertEquals(array(array(3, 'c')), $batches[3]);
+    }
+
+    public function testRangeToArrayReturnsRichTextAsPlainText()
+    {
+        $richText = new \ZExcel\RichText();
+        $richText->createText('Hello ');
+        $richText->createTextRun('World')->getFont()->setBold(true);
+        $this->worksheet->getCell('B2')->setValue($richText);
+
+        $this->assertSame(array(array('Hello World')), $this->worksheet->rangeToArray('B2:B2'));
+        $this->assertSame(array(array('Hello World')), $this->worksheet->rangeToArray('B2:B2', null, false));
+    }
+}
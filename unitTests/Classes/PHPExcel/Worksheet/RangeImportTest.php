@@ -0,0 +1,63 @@
+<?php
+
+class RangeImportTest extends PHPUnit_Framework_TestCase
+{
+    public function testFromArrayFillsConsecutiveColumns()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $worksheet = $workbook->getActiveSheet();
+        $worksheet->fromArray(array(array(1, 'a', 2.5), array(2, null, 4.5)), null, 'B2');
+
+        $this->assertEquals(array(array(1, 'a', 2.5), array(2, null, 4.5)), $worksheet->rangeToArray('B2:D3', null, false, false));
+        $this->assertEquals('D', $worksheet->getHighestColumn());
+        $this->assertEquals(3, $worksheet->getHighestRow());
+        $this->assertFalse($worksheet->cellExists('C3'));
+    }
+
+    public function testSetCellValuesWithColumnTypes()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $worksheet = $workbook->getActiveSheet();
+        $rows = function () {
+            for ($i = 1; $i <= 3; ++$i) {
+                yield array('00' . $i, $i, '=B' . $i . '*2');
+            }
+        };
+        $worksheet->setCellValues(
+            $rows(),
+            'A1',
+            array('A' => \ZExcel\Cell\DataType::TYPE_STRING, 1 => \ZExcel\Cell\DataType::TYPE_NUMERIC)
+        );
+
+        $this->assertSame('003', $worksheet->getCell('A3')->getValue());
+        $this->assertEquals(\ZExcel\Cell\DataType::TYPE_STRING, $worksheet->getCell('A3')->getDataType());
+        $this->assertSame(2.0, $worksheet->getCell('B2')->getValue());
+        $this->assertEquals(\ZExcel\Cell\DataType::TYPE_FORMULA, $worksheet->getCell('C2')->getDataType());
+        $this->assertEquals(6, $worksheet->getCell('C3')->getCalculatedValue());
+    }
+
+    public function testSetCellValuesInvalidatesEveryWrittenCell()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $worksheet = $workbook->getActiveSheet();
+        $worksheet->setCellValue('D1', '=B2*10');
+        $this->assertEquals(0, $worksheet->getCell('D1')->getCalculatedValue());
+
+        // Typed values are written straight into new cells; B2 is the last cell of the block, not the first
+        $worksheet->setCellValues(
+            array(array(1, 2), array(3, 4)),
+            'A1',
+            array('A' => \ZExcel\Cell\DataType::TYPE_NUMERIC, 'B' => \ZExcel\Cell\DataType::TYPE_NUMERIC)
+        );
+        $this->assertEquals(40, $worksheet->getCell('D1')->getCalculatedValue());
+    }
+
+    /**
+     * @expectedException \ZExcel\Exception
+     */
+    public function testSetCellValuesRejectsUnknownTypes()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $workbook->getActiveSheet()->setCellValues(array(array(1)), 'A1', array(0 => 'x'));
+    }
+}
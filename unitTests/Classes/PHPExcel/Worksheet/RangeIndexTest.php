@@ -0,0 +1,67 @@
+<?php
+
+class RangeIndexTest extends PHPUnit_Framework_TestCase
+{
+    public function testFind()
+    {
+        $index = new \ZExcel\Worksheet\RangeIndex(array('A1:A100000' => 1, 'C3 E1:F2' => 2));
+
+        $this->assertEquals('A1:A100000', $index->find(1, 99999));
+        $this->assertEquals('C3 E1:F2', $index->find(3, 3));
+        $this->assertEquals('C3 E1:F2', $index->find(6, 2));
+        $this->assertNull($index->find(2, 1));
+        $this->assertNull($index->find(1, 100001));
+
+        $index->add('A5:C5');
+        $this->assertEquals('A5:C5', $index->find(1, 5));
+        $this->assertEquals('A1:A100000', $index->find(1, 6));
+
+        $index->remove('A5:C5');
+        $this->assertEquals('A1:A100000', $index->find(1, 5));
+    }
+
+    public function testFindAmongManyAreas()
+    {
+        $index = new \ZExcel\Worksheet\RangeIndex();
+        for ($row = 1; $row <= 5000; ++$row) {
+            $index->add('A' . $row . ':C' . $row . ' E' . ($row * 3));
+        }
+        $index->add('B1:B1048576');
+        $index->add('C2500:D2600');
+
+        $this->assertEquals('A4000:C4000 E12000', $index->find(1, 4000));
+        $this->assertEquals('A4000:C4000 E12000', $index->find(5, 12000));
+        $this->assertEquals('B1:B1048576', $index->find(2, 4000));
+        $this->assertEquals('B1:B1048576', $index->find(2, 1048576));
+        $this->assertEquals('C2500:D2600', $index->find(3, 2550));
+        $this->assertEquals('A2601:C2601 E7803', $index->find(3, 2601));
+        $this->assertNull($index->find(4, 2601));
+        $this->assertNull($index->find(5, 12001));
+        $this->assertNull($index->find(1, 5001));
+
+        $index->remove('B1:B1048576');
+        $this->assertEquals('A4000:C4000 E12000', $index->find(2, 4000));
+        $this->assertNull($index->find(2, 5001));
+    }
+
+    public function testRulesAreSharedByTheCellsOfTheirRange()
+    {
+        $workbook = new \ZExcel\ZExcel();
+        $worksheet = $workbook->getActiveSheet();
+
+        $validation = new \ZExcel\Cell\DataValidation();
+        $worksheet->setDataValidation('B1:B50000 D1', $validation);
+
+        $this->assertSame($validation, $worksheet->getCell('B42000')->getDataValidation());
+        $this->assertTrue($worksheet->dataValidationExists('D1'));
+        $this->assertFalse($worksheet->dataValidationExists('C1'));
+        $this->assertCount(1, $worksheet->getDataValidationCollection());
+
+        $conditional = new \ZExcel\Style\Conditional();
+        $worksheet->duplicateConditionalStyle(array($conditional), 'A1:C20000');
+
+        $this->assertSame(array($conditional), $worksheet->getConditionalStyles('C19999'));
+        $this->assertSame(array(), $worksheet->getConditionalStyles('D1'));
+        $this->assertCount(1, $worksheet->getConditionalStylesCollection());
+    }
+}
@@ -0,0 +1,39 @@
+<?php
+
+/**
+ * Benchmark of repeated getCalculatedValue calls on a workbook, reporting the
+ * calculation cache hit rate of the workbook calculation engine
+ *
+ * Usage: php calculationCache.php [number of rows] [number of passes]
+ */
+
+$rows = isset($argv[1]) ? (int) $argv[1] : 2000;
+$passes = isset($argv[2]) ? (int) $argv[2] : 5;
+
+$workbook = new \ZExcel\ZExcel();
+$sheet = $workbook->getActiveSheet();
+for ($row = 1; $row <= $rows; ++$row) {
+    $sheet->setCellValue('A' . $row, $row);
+    $sheet->setCellValue('B' . $row, '=A' . $row . '*2');
+    $sheet->setCellValue('C' . $row, '=B' . $row . '+SUM(A1:A' . $row . ')');
+}
+
+$calculation = $workbook->getCalculationEngine();
+$calculation->resetCalculationCacheStatistics();
+
+for ($pass = 1; $pass <= $passes; ++$pass) {
+    $start = microtime(true);
+    for ($row = 1; $row <= $rows; ++$row) {
+        $sheet->getCell('C' . $row)->getCalculatedValue();
+    }
+    $statistics = $calculation->getCalculationCacheStatistics();
+    printf(
+        "pass %d: %8.1f ms, %d hits, %d misses (%.1f%% hit rate), %d cached values\n",
+        $pass,
+        (microtime(true) - $start) * 1000,
+        $statistics['hits'],
+        $statistics['misses'],
+        100 * $statistics['hits'] / max(1, $statistics['hits'] + $statistics['misses']),
+        $statistics['entries']
+    );
+}
@@ -0,0 +1,59 @@
+<?php
+
+/**
+ * Benchmark of the _xHHHH_ control character codec of \ZExcel\Shared\Stringg
+ * against the former str_replace implementation, over a shared strings corpus
+ *
+ * Usage: php controlCharacters.php [number of strings]
+ */
+
+$count = isset($argv[1]) ? (int) $argv[1] : 200000;
+
+// Former implementation: one str_replace with a search/replace pair per control character
+$controlCharacters = array();
+for ($i = 0; $i <= 31; ++$i) {
+    if ($i != 9 && $i != 10 && $i != 13) {
+        $controlCharacters['_x' . sprintf('%04s', strtoupper(dechex($i))) . '_'] = chr($i);
+    }
+}
+
+// Shared strings corpus: mostly short labels and sentences, some with underscores,
+// and about one string in a hundred holding an escaped control character
+mt_srand(42);
+$words = array('Total', 'Revenue', 'Q1', 'Q2', 'customer_id', 'Région', 'north', 'south', 'été', 'order_date', 'N/A', 'ok');
+$decoded = array();
+for ($i = 0; $i < $count; ++$i) {
+    $value = '';
+    for ($j = mt_rand(1, 8); $j > 0; --$j) {
+        $value .= $words[mt_rand(0, count($words) - 1)] . ' ';
+    }
+    if (mt_rand(0, 99) == 0) {
+        $value .= chr(mt_rand(0, 8)) . 'end';
+    }
+    $decoded[] = $value;
+}
+$encoded = array();
+foreach ($decoded as $value) {
+    $encoded[] = str_replace(array_values($controlCharacters), array_keys($controlCharacters), $value);
+}
+
+function bench($label, $callback, array $values)
+{
+    $start = microtime(true);
+    foreach ($values as $value) {
+        $callback($value);
+    }
+    printf("%-28s %8.1f ms\n", $label, (microtime(true) - $start) * 1000);
+}
+
+printf("%d shared strings\n", $count);
+
+bench('str_replace decode', function ($value) use ($controlCharacters) {
+    return str_replace(array_keys($controlCharacters), array_values($controlCharacters), $value);
+}, $encoded);
+bench('Stringg decode', array('\ZExcel\Shared\Stringg', 'ControlCharacterOOXML2PHP'), $encoded);
+
+bench('str_replace encode', function ($value) use ($controlCharacters) {
+    return str_replace(array_values($controlCharacters), array_keys($controlCharacters), $value);
+}, $decoded);
+bench('Stringg encode', array('\ZExcel\Shared\Stringg', 'ControlCharacterPHP2OOXML'), $decoded);
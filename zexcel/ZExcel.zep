@@ -27,6 +27,13 @@ class ZExcel
      */
     private workSheetCollection = [];
 
+    /**
+     * Worksheets of the collection, indexed by title
+     *
+     * @var PHPExcel_Worksheet[]
+     */
+    private workSheetsByTitle = [];
+
     /**
      * Calculation Engine
      *
@@ -340,7 +347,9 @@ class ZExcel
 
         // Initialise worksheet collection and add one worksheet
         let this->workSheetCollection = [];
+        let this->workSheetsByTitle = [];
         let this->workSheetCollection[] = new \ZExcel\Worksheet(this);
+        this->rebuildSheetTitleIndex();
         let this->activeSheetIndex = 0;
         
 
@@ -385,19 +394,305 @@ class ZExcel
             this->workSheetCollection[k]->disconnectCells();
         }
         
-        let this->_workSheetCollection = [];
+        let this->workSheetCollection = [];
+        let this->workSheetsByTitle = [];
     }
 
     /**
-     * Return the calculation engine for this worksheet
+     * Return the calculation engine for this workbook
      *
-     * @return PHPExcel_Calculation
+     * @return \ZExcel\Calculation
      */
-    public function getCalculationEngine() -> <\ZExcel\Calculation>
+    public function getCalculationEngine()
     {
         return this->calculationEngine;
     }
 
+    /**
+     * Recalculate every formula of the workbook
+     *
+     * Each formula cell is evaluated once, after the formula cells it references, and its result
+     * is stored as its calculated value (see \ZExcel\Cell::getOldCalculatedValue), even when the
+     * calculation engine trusts the calculated values stored in formula cells
+     *
+     * Options:
+     *     resetCache    boolean    Discard the calculation cache first (default true)
+     *     slowest       integer    Number of slowest formulae to report (default 10)
+     *
+     * @param array options
+     * @return array Number of formulae, of formulae that failed ("errors") and of cyclic references,
+     *                  total time, formulae and time per worksheet, calculation cache statistics and
+     *                  slowest formulae
+     */
+    public function recalculate(array options = []) -> array
+    {
+        var calculation, result, e;
+        boolean trustCachedValues, cacheEnabled;
+        int cacheLimit, slowestCount = 10;
+
+        if (isset(options["slowest"])) {
+            let slowestCount = (int) options["slowest"];
+        }
+
+        let calculation = this->calculationEngine;
+
+        if (!isset(options["resetCache"]) || options["resetCache"]) {
+            calculation->clearCalculationCache();
+        }
+
+        calculation->resetCalculationCacheStatistics();
+
+        // The values of the formula cells referenced are read back from the calculation cache, so it is kept
+        // whole for the run; stored calculated values are replaced, not returned
+        let trustCachedValues = calculation->getTrustCachedValues();
+        let cacheEnabled = calculation->getCalculationCacheEnabled();
+        let cacheLimit = calculation->getCalculationCacheLimit();
+
+        if (!cacheEnabled) {
+            calculation->setCalculationCacheEnabled(true);
+        }
+
+        calculation->setCalculationCacheLimit(0);
+        calculation->setTrustCachedValues(false);
+
+        try {
+            let result = this->recalculateFormulae(calculation, slowestCount);
+        } catch \Exception, e {
+            // Stored values may not all have been replaced: none is trusted until evaluated again
+            this->restoreCalculationSettings(calculation, trustCachedValues, cacheEnabled, cacheLimit, null);
+            throw e;
+        }
+
+        // Every stored value is up to date again, except those of the formulae that failed
+        this->restoreCalculationSettings(calculation, trustCachedValues, cacheEnabled, cacheLimit, result[1]);
+
+        return result[0];
+    }
+
+    /**
+     * Evaluate every formula of the workbook in dependency order, for recalculate()
+     *
+     * @param \ZExcel\Calculation calculation
+     * @param int                  slowestCount Number of slowest formulae to report
+     * @return array Statistics, as returned by recalculate(), and the formula cells that failed,
+     *                  each as [worksheet title, cell address]
+     */
+    private function recalculateFormulae(<\ZExcel\Calculation> calculation, int slowestCount) -> array
+    {
+        var worksheet, title, cellID, cell, key, node, reference, refTitle, dependency,
+            stack, start, elapsed, totalStart, e;
+        int top, position, cycles = 0, errors = 0;
+        array formulae = [], sheetFormulae = [], dependencies = [], state = [], order = [],
+            timings = [], sheets = [], slowest = [], failed = [];
+
+        let totalStart = microtime(true);
+
+        // Collect the formula cells of every worksheet
+        for worksheet in this->workSheetCollection {
+            let title = worksheet->getTitle();
+            let sheetFormulae[title] = [];
+            let sheets[title] = ["formulae": 0, "time": 0.0];
+
+            for cellID in worksheet->getCellCollection(false) {
+                if (worksheet->getCell(cellID)->getDataType() == \ZExcel\Cell\DataType::TYPE_FORMULA) {
+                    let sheetFormulae[title][cellID] = true;
+                    let formulae[title . "!" . cellID] = [title, cellID];
+                }
+            }
+        }
+
+        // Link each formula cell to the formula cells it references
+        for key, node in formulae {
+            let dependencies[key] = [];
+
+            try {
+                for reference in calculation->getFormulaReferences(this->workSheetsByTitle[node[0]]->getCell(node[1])) {
+                    let refTitle = reference[0] === null ? node[0] : reference[0];
+
+                    if (isset(sheetFormulae[refTitle])) {
+                        for cellID in self::formulaCellsInRange(sheetFormulae[refTitle], reference[1]) {
+                            let dependencies[key][] = refTitle . "!" . cellID;
+                        }
+                    }
+                }
+            } catch \ZExcel\Exception, e {
+                // The error is reported when the formula is evaluated
+            }
+        }
+
+        // Order the formula cells so that each one comes after the formula cells it references
+        for key, _ in formulae {
+            if (isset(state[key])) {
+                continue;
+            }
+
+            let state[key] = 1;
+            let stack = [[key, 0]];
+
+            while (!empty(stack)) {
+                let top = count(stack) - 1;
+                let node = stack[top][0];
+                let position = stack[top][1];
+
+                if (position < count(dependencies[node])) {
+                    let stack[top][1] = position + 1;
+                    let dependency = dependencies[node][position];
+
+                    if (!isset(state[dependency])) {
+                        let state[dependency] = 1;
+                        let stack[] = [dependency, 0];
+                    } elseif (state[dependency] == 1) {
+                        // Still being visited: the reference closes a cycle
+                        let cycles++;
+                    }
+                } else {
+                    array_pop(stack);
+                    let state[node] = 2;
+                    let order[] = node;
+                }
+            }
+        }
+
+        // Evaluate: the values of the formula cells referenced are already in the calculation cache
+        for key in order {
+            let node = formulae[key];
+            let cell = this->workSheetsByTitle[node[0]]->getCell(node[1]);
+            let start = microtime(true);
+
+            try {
+                cell->setCalculatedValue(cell->getCalculatedValue());
+            } catch \ZExcel\Exception, e {
+                let errors++;
+                let failed[] = node;
+            }
+
+            let elapsed = microtime(true) - start;
+            let timings[key] = elapsed;
+            let sheets[node[0]]["formulae"] = sheets[node[0]]["formulae"] + 1;
+            let sheets[node[0]]["time"] = sheets[node[0]]["time"] + elapsed;
+        }
+
+        arsort(timings);
+
+        for key, elapsed in array_slice(timings, 0, slowestCount, true) {
+            let node = formulae[key];
+            let slowest[] = [
+                "cell": key,
+                "formula": this->workSheetsByTitle[node[0]]->getCell(node[1])->getValue(),
+                "time": elapsed
+            ];
+        }
+
+        return [
+            [
+                "formulae": count(formulae),
+                "errors": errors,
+                "cycles": cycles,
+                "time": microtime(true) - totalStart,
+                "sheets": sheets,
+                "cache": calculation->getCalculationCacheStatistics(),
+                "slowest": slowest
+            ],
+            failed
+        ];
+    }
+
+    /**
+     * Give the calculation engine back the settings recalculate() changed
+     *
+     * @param \ZExcel\Calculation calculation
+     * @param boolean              trustCachedValues Trust the calculated values stored in formula cells
+     * @param boolean              cacheEnabled      Calculation cache enabled
+     * @param int                  cacheLimit        Maximum number of values held in the calculation cache
+     * @param array|null           stale             Formula cells whose stored value is not to be trusted,
+     *                                               each as [worksheet title, cell address]; null for every formula cell
+     */
+    private function restoreCalculationSettings(<\ZExcel\Calculation> calculation, boolean trustCachedValues, boolean cacheEnabled, int cacheLimit, var stale)
+    {
+        var worksheet, cellID, node;
+
+        calculation->setCalculationCacheLimit(cacheLimit);
+
+        if (!cacheEnabled) {
+            calculation->setCalculationCacheEnabled(false);
+        }
+
+        if (!trustCachedValues) {
+            return;
+        }
+
+        calculation->setTrustCachedValues(true);
+
+        if (stale === null) {
+            let stale = [];
+
+            for worksheet in this->workSheetCollection {
+                for cellID in worksheet->getCellCollection(false) {
+                    if (worksheet->getCell(cellID)->getDataType() == \ZExcel\Cell\DataType::TYPE_FORMULA) {
+                        let stale[] = [worksheet->getTitle(), cellID];
+                    }
+                }
+            }
+        }
+
+        for node in stale {
+            calculation->cellValueChanged(node[0], node[1]);
+        }
+    }
+
+    /**
+     * List the formula cells of a worksheet within a cell or range
+     *
+     * @param array  cells     Formula cells of the worksheet, indexed by coordinate
+     * @param string cellRange Cell or range (e.g. A1 or $A$1:B5)
+     * @return string[]
+     */
+    private static function formulaCellsInRange(array cells, string cellRange) -> array
+    {
+        var boundaries, cellID, columnLetters;
+        int firstColumn, firstRow, lastColumn, lastRow, column, row, packed;
+        array found = [];
+
+        let cellRange = str_replace("$", "", cellRange);
+
+        if (strpos(cellRange, ":") === false) {
+            return isset(cells[cellRange]) ? [cellRange] : [];
+        }
+
+        let boundaries = \ZExcel\Cell::rangeBoundaries(cellRange);
+        let firstColumn = min(boundaries[0][0], boundaries[1][0]);
+        let lastColumn = max(boundaries[0][0], boundaries[1][0]);
+        let firstRow = min(boundaries[0][1], boundaries[1][1]);
+        let lastRow = max(boundaries[0][1], boundaries[1][1]);
+
+        // Walk the range or the formula cells, whichever is smaller
+        if ((lastColumn - firstColumn + 1) * (lastRow - firstRow + 1) <= count(cells)) {
+            for column in range(firstColumn, lastColumn) {
+                let columnLetters = \ZExcel\Cell::stringFromColumnIndex(column - 1);
+
+                for row in range(firstRow, lastRow) {
+                    let cellID = columnLetters . row;
+
+                    if (isset(cells[cellID])) {
+                        let found[] = cellID;
+                    }
+                }
+            }
+        } else {
+            for cellID, _ in cells {
+                let packed = \ZExcel\Cell\Coordinate::parse(cellID);
+                let column = \ZExcel\Cell\Coordinate::column(packed);
+                let row = \ZExcel\Cell\Coordinate::row(packed);
+
+                if (column >= firstColumn && column <= lastColumn && row >= firstRow && row <= lastRow) {
+                    let found[] = cellID;
+                }
+            }
+        }
+
+        return found;
+    }
+
     /**
      * Get properties
      *
@@ -475,7 +770,38 @@ class ZExcel
      */
     public function sheetNameExists(string pSheetName) -> boolean
     {
-        return (this->getSheetByName(pSheetName) !== null);
+        return isset(this->workSheetsByTitle[pSheetName]);
+    }
+
+    /**
+     * Update the title index after a worksheet of this workbook has been renamed
+     *
+     * @param  ZExcel\Worksheet pSheet    The renamed worksheet
+     * @param  string           oldTitle  Title of the worksheet before the rename
+     */
+    public function sheetTitleChanged(<\ZExcel\Worksheet> pSheet, string oldTitle)
+    {
+        if (!isset(this->workSheetsByTitle[oldTitle]) || this->workSheetsByTitle[oldTitle] !== pSheet) {
+            // The worksheet is not (yet) part of this workbook
+            return;
+        }
+
+        unset(this->workSheetsByTitle[oldTitle]);
+        let this->workSheetsByTitle[pSheet->getTitle()] = pSheet;
+    }
+
+    /**
+     * Rebuild the title index from the worksheet collection
+     */
+    private function rebuildSheetTitleIndex()
+    {
+        var worksheet;
+
+        let this->workSheetsByTitle = [];
+
+        for worksheet in this->workSheetCollection {
+            let this->workSheetsByTitle[worksheet->getTitle()] = worksheet;
+        }
     }
 
     /**
@@ -513,6 +839,8 @@ class ZExcel
             }
         }
 
+        let this->workSheetsByTitle[pSheet->getTitle()] = pSheet;
+
         if (pSheet->getParent() == null) {
             pSheet->rebindParent(this);
         }
@@ -528,13 +856,20 @@ class ZExcel
      */
     public function removeSheetByIndex(int pIndex = 0)
     {
-        var numSheets;
+        var numSheets, worksheet, title;
         
         let numSheets = count(this->workSheetCollection);
 
         if (pIndex > numSheets - 1) {
             throw new \ZExcel\Exception("You tried to remove a sheet by the out of bounds index: " . pIndex . ". The actual number of sheets is " . numSheets . ".");
         } else {
+            let worksheet = this->workSheetCollection[pIndex];
+            let title = worksheet->getTitle();
+            
+            if (isset(this->workSheetsByTitle[title]) && this->workSheetsByTitle[title] === worksheet) {
+                unset(this->workSheetsByTitle[title]);
+            }
+            
             array_splice(this->workSheetCollection, pIndex, 1);
         }
         // Adjust active sheet index if necessary
@@ -580,15 +915,8 @@ class ZExcel
      */
     public function getSheetByName(string pName = "")
     {
-        var worksheet, workSheetCount = 0, i = 0;
-        
-        let workSheetCount = count(this->workSheetCollection) - 1;
-        
-        for i in range(0, workSheetCount) {
-            let worksheet = this->workSheetCollection[i]; 
-            if (worksheet->getTitle() === pName) {
-                return worksheet;
-            }
+        if (isset(this->workSheetsByTitle[pName])) {
+            return this->workSheetsByTitle[pName];
         }
         
         return null;
@@ -867,6 +1195,8 @@ class ZExcel
             let this->workSheetCollection[i] = this->workSheetCollection[i]->copy();
             this->workSheetCollection[i]->rebindParent(this);
         }
+        
+        this->rebuildSheetTitleIndex();
 
         return copied;
     }
@@ -878,12 +1208,20 @@ class ZExcel
     {
         var vars, key, val;
         
+        // The clone gets a calculation engine of its own, with an empty cache
+        let this->calculationEngine = null;
+        
         let vars = get_object_vars(this);
         for key, val in vars {
             if (is_object(val) || (is_array(val))) {
                 let this->{key} = unserialize(serialize(val));
             }
         }
+        
+        let this->calculationEngine = \ZExcel\Calculation::getInstance(this);
+        
+        // The title index must refer to the cloned worksheets, not to separately unserialized copies
+        this->rebuildSheetTitleIndex();
     }
 
     /**
@@ -1081,7 +1419,7 @@ class ZExcel
      */
     public function garbageCollect()
     {
-        var i, map, index, cellXf, sheet, cell, cellID, rowDimension, columnDimension, countNeededCellXfs;
+        var i, map, index, cellXf, sheet, cell, cellID, dimensions, key, xfIndex, countNeededCellXfs;
         
         // how many references are there to each cellXf ?
         array countReferencesCellXf = [];
@@ -1098,15 +1436,22 @@ class ZExcel
             }
 
             // from row dimensions
-            for rowDimension in sheet->getRowDimensions() {
-                if (rowDimension->getXfIndex() !== null) {
-                    let countReferencesCellXf[rowDimension->getXfIndex()] = countReferencesCellXf[rowDimension->getXfIndex()] + 1;
+            let dimensions = sheet->getRowDimensionStore();
+
+            for key in dimensions->getKeys() {
+                let xfIndex = dimensions->getXfIndex(key);
+
+                if (xfIndex !== null) {
+                    let countReferencesCellXf[xfIndex] = countReferencesCellXf[xfIndex] + 1;
                 }
             }
 
             // from column dimensions
-            for columnDimension in sheet->getColumnDimensions() {
-                let countReferencesCellXf[columnDimension->getXfIndex()] = countReferencesCellXf[columnDimension->getXfIndex()] + 1;
+            let dimensions = sheet->getColumnDimensionStore();
+
+            for key in dimensions->getKeys() {
+                let xfIndex = dimensions->getXfIndex(key);
+                let countReferencesCellXf[xfIndex] = countReferencesCellXf[xfIndex] + 1;
             }
         }
 
@@ -1145,15 +1490,21 @@ class ZExcel
             }
 
             // for all row dimensions
-            for rowDimension in sheet->getRowDimensions() {
-                if (rowDimension->getXfIndex() !== null) {
-                    rowDimension->setXfIndex(map[rowDimension->getXfIndex()]);
+            let dimensions = sheet->getRowDimensionStore();
+
+            for key in dimensions->getKeys() {
+                let xfIndex = dimensions->getXfIndex(key);
+
+                if (xfIndex !== null) {
+                    dimensions->setXfIndex(key, map[xfIndex]);
                 }
             }
 
             // for all column dimensions
-            for columnDimension in sheet->getColumnDimensions() {
-                columnDimension->setXfIndex(map[columnDimension->getXfIndex()]);
+            let dimensions = sheet->getColumnDimensionStore();
+
+            for key in dimensions->getKeys() {
+                dimensions->setXfIndex(key, map[dimensions->getXfIndex(key)]);
             }
 
             // also do garbage collection for all the sheets
@@ -61,6 +61,7 @@ class Apc extends CacheBase implements ICache
         }
         
         let this->cellCache[pCoord] = true;
+        this->indexCell(pCoord);
 
         let this->currentObjectID = pCoord;
         let this->currentObject = cell;
@@ -117,6 +118,10 @@ class Apc extends CacheBase implements ICache
         if (pCoord === this->currentObjectID) {
             return this->currentObject;
         }
+
+        if (isset(this->pinnedCells[pCoord])) {
+            return this->activatePinnedCell(pCoord);
+        }
         
         this->storeData();
 
@@ -226,6 +231,9 @@ class Apc extends CacheBase implements ICache
 
         let this->cellCache = [];
 
+        let this->pinnedCells = [];
+        let this->pinCounts = [];
+
         //    detach ourself from the worksheet, so that it can then delete this object successfully
         let this->parent = null;
     }
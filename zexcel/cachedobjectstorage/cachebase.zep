@@ -38,6 +38,78 @@ abstract class CacheBase
      */
     protected cellCache = [];
 
+    /**
+     * Cells pinned in memory while they are in use (e.g. during a recalculation),
+     *        indexed by their coordinate address within the worksheet
+     *
+     * @var \ZExcel\Cell[]
+     */
+    protected pinnedCells = [];
+
+    /**
+     * Number of outstanding pins for each pinned cell
+     *
+     * @var integer[]
+     */
+    protected pinCounts = [];
+
+    /**
+     * Column indexes of the cells held in each row, indexed by row number then column index
+     * Rows and the columns of each row are kept in ascending order, except for the ones flagged below
+     *
+     * @var array
+     */
+    protected rowColumns = [];
+
+    /**
+     * Are the rows of rowColumns in ascending order?
+     *
+     * @var boolean
+     */
+    protected rowsAreSorted = true;
+
+    /**
+     * Rows whose columns may be out of order, indexed by row number
+     *
+     * @var boolean[]
+     */
+    protected unsortedRows = [];
+
+    /**
+     * Row numbers of the cells held in each column, indexed by column index then row number
+     *
+     * @var array
+     */
+    protected columnRows = [];
+
+    /**
+     * Highest column index of each row, for the rows where it is known
+     *
+     * @var integer[]
+     */
+    protected rowHighestColumns = [];
+
+    /**
+     * Highest row number of each column, for the columns where it is known
+     *
+     * @var integer[]
+     */
+    protected columnHighestRows = [];
+
+    /**
+     * Highest row number holding a cell, or -1 while unknown
+     *
+     * @var integer
+     */
+    protected highestRow = 0;
+
+    /**
+     * Highest column index holding a cell, or -1 while unknown
+     *
+     * @var integer
+     */
+    protected highestColumn = 0;
+
     /**
      * Initialise this new cell collection
      *
@@ -90,6 +162,9 @@ abstract class CacheBase
             let this->currentObjectID = toAddress;
         }
         
+        this->forgetPinnedCell(fromAddress);
+        this->forgetPinnedCell(toAddress);
+        
         let this->currentCellIsDirty = true;
         
         if (isset(this->cellCache[fromAddress])) {
@@ -97,6 +172,10 @@ abstract class CacheBase
             unset(this->cellCache[fromAddress]);
         }
 
+        if (this->unindexCell(fromAddress)) {
+            this->indexCell(toAddress);
+        }
+
         return true;
     }
     
@@ -114,7 +193,15 @@ abstract class CacheBase
      */
     public function updateCacheData(<\ZExcel\Cell> cell)
     {
-        return this->addCacheData(cell->getCoordinate(), cell);
+        var pCoord;
+        
+        let pCoord = cell->getCoordinate();
+        
+        if (isset(this->pinnedCells[pCoord])) {
+            let this->pinnedCells[pCoord] = cell;
+        }
+        
+        return this->addCacheData(pCoord, cell);
     }
 
     /**
@@ -130,13 +217,247 @@ abstract class CacheBase
             let this->currentObjectID = null;
             let this->currentObject = null;
         }
+        
+        this->forgetPinnedCell(pCoord);
 
         if (is_object(this->cellCache[pCoord])) {
             this->cellCache[pCoord]->detach();
             unset(this->cellCache[pCoord]);
         }
+
+        this->unindexCell(pCoord);
+        this->notifyCellDeleted(pCoord);
+        
+        let this->currentCellIsDirty = false;
+    }
+
+    /**
+     * Tell the worksheet that a cell has been deleted
+     *
+     * @param    string        pCoord        Coordinate address of the deleted cell
+     */
+    protected function notifyCellDeleted(string pCoord)
+    {
+        if (this->parent !== null) {
+            this->parent->cellDeleted(pCoord);
+        }
+    }
+
+    /**
+     * Record a cell address in the row and column index
+     * Called by the cache backends whenever a cell is added or updated
+     *
+     * @param    string        pCoord        Coordinate address of the cell
+     */
+    protected function indexCell(string pCoord)
+    {
+        int packed, row, column;
+        
+        let packed = \ZExcel\Cell\Coordinate::parse(pCoord);
+        
+        if (packed == \ZExcel\Cell\Coordinate::INVALID) {
+            return;
+        }
+        
+        let row = \ZExcel\Cell\Coordinate::row(packed);
+        let column = \ZExcel\Cell\Coordinate::column(packed);
+        
+        if (isset(this->rowColumns[row][column])) {
+            return;
+        }
+        
+        // Appending after the highest row, or after the highest column of a row, keeps row-major order;
+        //    anything else is flagged, and sorted when the sorted cell list is next requested
+        if (!isset(this->rowColumns[row])) {
+            if (this->highestRow < 0 || this->highestRow > row) {
+                let this->rowsAreSorted = false;
+            }
+            
+            let this->rowColumns[row][column] = true;
+            let this->rowHighestColumns[row] = column;
+        } else {
+            if (!isset(this->rowHighestColumns[row]) || this->rowHighestColumns[row] > column) {
+                let this->unsortedRows[row] = true;
+            }
+            
+            let this->rowColumns[row][column] = true;
+            
+            // Known maximums only ever grow on insert; unknown ones are worked out when queried
+            if (isset(this->rowHighestColumns[row]) && this->rowHighestColumns[row] < column) {
+                let this->rowHighestColumns[row] = column;
+            }
+        }
+        
+        if (!isset(this->columnRows[column])) {
+            let this->columnRows[column][row] = true;
+            let this->columnHighestRows[column] = row;
+        } else {
+            let this->columnRows[column][row] = true;
+            
+            if (isset(this->columnHighestRows[column]) && this->columnHighestRows[column] < row) {
+                let this->columnHighestRows[column] = row;
+            }
+        }
+        
+        if (this->highestRow >= 0 && this->highestRow < row) {
+            let this->highestRow = row;
+        }
+        if (this->highestColumn >= 0 && this->highestColumn < column) {
+            let this->highestColumn = column;
+        }
+    }
+
+    /**
+     * Drop a cell address from the row and column index
+     *
+     * @param    string        pCoord        Coordinate address of the cell
+     * @return    boolean        false if the address was not indexed
+     */
+    protected function unindexCell(string pCoord) -> boolean
+    {
+        int packed, row, column;
+        
+        let packed = \ZExcel\Cell\Coordinate::parse(pCoord);
+        
+        if (packed == \ZExcel\Cell\Coordinate::INVALID) {
+            return false;
+        }
+        
+        let row = \ZExcel\Cell\Coordinate::row(packed);
+        let column = \ZExcel\Cell\Coordinate::column(packed);
+        
+        if (!isset(this->rowColumns[row][column])) {
+            return false;
+        }
+        
+        unset(this->rowColumns[row][column]);
+        unset(this->columnRows[column][row]);
+        
+        if (empty(this->rowColumns[row])) {
+            unset(this->rowColumns[row]);
+            unset(this->rowHighestColumns[row]);
+            unset(this->unsortedRows[row]);
+            
+            if (this->highestRow == row) {
+                let this->highestRow = -1;
+            }
+        } elseif (isset(this->rowHighestColumns[row]) && this->rowHighestColumns[row] == column) {
+            unset(this->rowHighestColumns[row]);
+        }
+        
+        if (empty(this->columnRows[column])) {
+            unset(this->columnRows[column]);
+            unset(this->columnHighestRows[column]);
+            
+            if (this->highestColumn == column) {
+                let this->highestColumn = -1;
+            }
+        } elseif (isset(this->columnHighestRows[column]) && this->columnHighestRows[column] == row) {
+            unset(this->columnHighestRows[column]);
+        }
+        
+        if (empty(this->rowColumns)) {
+            let this->highestRow = 0;
+            let this->highestColumn = 0;
+            let this->rowsAreSorted = true;
+        }
+        
+        return true;
+    }
+
+    /**
+     * Pin a cell in memory, so that fetching it again while it is pinned returns the same
+     *        object instead of reloading it from the cache backend.
+     * Pins are counted; each call must be balanced by a call to unpinCell()
+     *
+     * @param    string        pCoord        Coordinate address of the cell to pin
+     * @return    boolean        false if there is no cell at that address
+     */
+    public function pinCell(string pCoord) -> boolean
+    {
+        var cell;
+        
+        if (isset(this->pinCounts[pCoord])) {
+            let this->pinCounts[pCoord] = this->pinCounts[pCoord] + 1;
+            
+            return true;
+        }
+        
+        let cell = this->getCacheData(pCoord);
+        
+        if (cell === null) {
+            return false;
+        }
+        
+        let this->pinnedCells[pCoord] = cell;
+        let this->pinCounts[pCoord] = 1;
+        
+        return true;
+    }
+
+    /**
+     * Release a pin taken with pinCell()
+     *
+     * @param    string        pCoord        Coordinate address of the cell to unpin
+     */
+    public function unpinCell(string pCoord)
+    {
+        if (!isset(this->pinCounts[pCoord])) {
+            return;
+        }
+        
+        if (this->pinCounts[pCoord] > 1) {
+            let this->pinCounts[pCoord] = this->pinCounts[pCoord] - 1;
+        } else {
+            this->forgetPinnedCell(pCoord);
+        }
+    }
+
+    /**
+     * Is a cell pinned in memory?
+     *
+     * @param    string        pCoord        Coordinate address of the cell to check
+     * @return    boolean
+     */
+    public function isCellPinned(string pCoord) -> boolean
+    {
+        return isset(this->pinCounts[pCoord]);
+    }
+
+    /**
+     * Drop a cell from the pinned cells, whatever its number of outstanding pins
+     *
+     * @param    string        pCoord        Coordinate address of the cell
+     */
+    protected function forgetPinnedCell(string pCoord)
+    {
+        if (!isset(this->pinCounts[pCoord])) {
+            return;
+        }
+        
+        unset(this->pinnedCells[pCoord]);
+        unset(this->pinCounts[pCoord]);
+    }
+
+    /**
+     * Make a pinned cell the currently active cell without reloading it from the cache backend
+     *
+     * @param    string        pCoord        Coordinate address of a pinned cell
+     * @return    \ZExcel\Cell
+     */
+    protected function activatePinnedCell(string pCoord)
+    {
+        this->storeData();
         
+        let this->currentObjectID = pCoord;
+        let this->currentObject = this->pinnedCells[pCoord];
+        // The stored copy is up to date, unless the cell is changed again
         let this->currentCellIsDirty = false;
+        
+        //    Re-attach this as the cell's parent, storeData() may have detached it
+        this->currentObject->attach(this);
+        
+        return this->currentObject;
     }
 
     /**
@@ -150,26 +471,44 @@ abstract class CacheBase
     }
 
     /**
-     * Sort the list of all cell addresses currently held in cache by row and column
+     * Get the list of all cell addresses currently held in cache, sorted by row and column
+     *
+     * The row and column index is kept in that order as cells are added,
+     *        so only the rows that received out-of-order cells need sorting here
      *
      * @return    string[]
      */
     public function getSortedCellList()
     {
-        var coord, column, row;
-        array sortKeys = [];
+        var rowColumns, row, columns, column;
+        array cellList = [], letters = [];
         
-        let row = "";
-        let column = "";
+        if (!this->rowsAreSorted) {
+            let rowColumns = this->rowColumns;
+            ksort(rowColumns);
+            let this->rowColumns = rowColumns;
+            let this->rowsAreSorted = true;
+        }
         
-        for coord in this->getCellList() {
-            sscanf(coord, "%[A-Z]%d", column, row);
-            let sortKeys[sprintf("%09d%3s", row, column)] = coord;
+        for row, _ in this->unsortedRows {
+            let columns = this->rowColumns[row];
+            ksort(columns);
+            let this->rowColumns[row] = columns;
+        }
+        
+        let this->unsortedRows = [];
+        
+        for row, columns in this->rowColumns {
+            for column, _ in columns {
+                if (!isset(letters[column])) {
+                    let letters[column] = \ZExcel\Cell::stringFromColumnIndex(column - 1);
+                }
+                
+                let cellList[] = letters[column] . row;
+            }
         }
 
-        ksort(sortKeys);
-
-        return array_values(sortKeys);
+        return cellList;
     }
 
     /**
@@ -179,31 +518,18 @@ abstract class CacheBase
      */
     public function getHighestRowAndColumn()
     {
-        var coord, highestRow, highestColumn, c, r;
-        array col, row;
-        
-        // Lookup highest column and highest row
-        let col = ["A": "1A"];
-        let row = [1];
-        
-        let c = "";
-        let r = "";
-        
-        for coord in this->getCellList() {
-            sscanf(coord, "%[A-Z]%d", c, r);
-            let row[r] = r;
-            let col[c] = strlen(c).c;
+        // A deletion may have left the extents unknown: only then look at the rows and columns held
+        if (this->highestRow < 0) {
+            let this->highestRow = empty(this->rowColumns) ? 0 : max(array_keys(this->rowColumns));
         }
         
-        if (!empty(row)) {
-            // Determine highest column and row
-            let highestRow = max(row);
-            let highestColumn = substr(max(col), 1);
+        if (this->highestColumn < 0) {
+            let this->highestColumn = empty(this->columnRows) ? 0 : max(array_keys(this->columnRows));
         }
 
         return [
-            "row": highestRow,
-            "column": highestColumn
+            "row": max(1, this->highestRow),
+            "column": \ZExcel\Cell::stringFromColumnIndex(max(1, this->highestColumn) - 1)
         ];
     }
 
@@ -224,14 +550,15 @@ abstract class CacheBase
      */
     public function getCurrentColumn()
     {
-        var column, row;
+        int packed;
         
-        let row = "";
-        let column = "";
+        let packed = \ZExcel\Cell\Coordinate::parse((string) this->currentObjectID);
         
-        sscanf(this->currentObjectID, "%[A-Z]%d", column, row);
+        if (packed == \ZExcel\Cell\Coordinate::INVALID) {
+            return "";
+        }
         
-        return column;
+        return \ZExcel\Cell::stringFromColumnIndex(\ZExcel\Cell\Coordinate::column(packed) - 1);
     }
 
     /**
@@ -241,14 +568,15 @@ abstract class CacheBase
      */
     public function getCurrentRow()
     {
-        var column, row;
+        int packed;
         
-        let row = "";
-        let column = "";
+        let packed = \ZExcel\Cell\Coordinate::parse((string) this->currentObjectID);
         
-        sscanf(this->currentObjectID, "%[A-Z]%d", column, row);
+        if (packed == \ZExcel\Cell\Coordinate::INVALID) {
+            return 0;
+        }
         
-        return (int) row;
+        return \ZExcel\Cell\Coordinate::row(packed);
     }
 
     /**
@@ -260,27 +588,25 @@ abstract class CacheBase
      */
     public function getHighestColumn(string row = null)
     {
-        var colRow, coord, c, r;
-        array columnList;
+        var colRow;
+        int rowNumber;
     
         if (row == null) {
             let colRow = this->getHighestRowAndColumn();
             return colRow["column"];
         }
 
-        let columnList = [1];
+        let rowNumber = (int) row;
         
-        let c = "";
-        let r = "";
+        if (!isset(this->rowColumns[rowNumber])) {
+            return "A";
+        }
         
-        for coord in this->getCellList() {
-            sscanf(coord, "%[A-Z]%d", c, r);
-            if (r != row) {
-                continue;
-            }
-            let columnList[] = \ZExcel\Cell::columnIndexFromString(c);
+        if (!isset(this->rowHighestColumns[rowNumber])) {
+            let this->rowHighestColumns[rowNumber] = max(array_keys(this->rowColumns[rowNumber]));
         }
-        return \ZExcel\Cell::stringFromColumnIndex(max(columnList) - 1);
+        
+        return \ZExcel\Cell::stringFromColumnIndex(this->rowHighestColumns[rowNumber] - 1);
     }
 
     /**
@@ -292,30 +618,25 @@ abstract class CacheBase
      */
     public function getHighestRow(string column = null)
     {
-        var colRow, coord, c, r;
-        array rowList;
+        var colRow;
+        int columnIndex;
         
         if (column == null) {
             let colRow = this->getHighestRowAndColumn();
             return colRow["row"];
         }
 
-        let rowList = [0];
+        let columnIndex = \ZExcel\Cell::columnIndexFromString(column);
         
-        let c = "";
-        let r = "";
+        if (!isset(this->columnRows[columnIndex])) {
+            return 0;
+        }
         
-        for coord in this->getCellList() {
-            sscanf(coord, "%[A-Z]%d", c, r);
-            
-            if (c != column) {
-                continue;
-            }
-            
-            let rowList[] = r;
+        if (!isset(this->columnHighestRows[columnIndex])) {
+            let this->columnHighestRows[columnIndex] = max(array_keys(this->columnRows[columnIndex]));
         }
 
-        return max(rowList);
+        return this->columnHighestRows[columnIndex];
     }
 
     /**
@@ -352,6 +673,10 @@ abstract class CacheBase
 
         let this->parent = parent;
         
+        //    Pins belong to the original collection
+        let this->pinnedCells = [];
+        let this->pinCounts = [];
+        
         if ((this->currentObject !== null) && (is_object(this->currentObject))) {
             this->currentObject->attach(this);
         }
@@ -365,17 +690,17 @@ abstract class CacheBase
      */
     public function removeRow(row)
     {
-        var coord, c, r;
+        var column;
+        int rowNumber;
         
-        let c = "";
-        let r = "";
+        let rowNumber = (int) row;
         
-        for coord in this->getCellList() {
-            sscanf(coord, "%[A-Z]%d", c, r);
-            
-            if (r == row) {
-                this->deleteCacheData(coord);
-            }
+        if (!isset(this->rowColumns[rowNumber])) {
+            return;
+        }
+        
+        for column in array_keys(this->rowColumns[rowNumber]) {
+            this->deleteCacheData(\ZExcel\Cell::stringFromColumnIndex(column - 1) . rowNumber);
         }
     }
 
@@ -387,16 +712,17 @@ abstract class CacheBase
      */
     public function removeColumn(column)
     {
-        var coord, c, r;
+        var rowNumber;
+        int columnIndex;
         
-        let c = "";
-        let r = "";
+        let columnIndex = \ZExcel\Cell::columnIndexFromString(column);
         
-        for coord in this->getCellList() {
-            sscanf(coord, "%[A-Z]%d", c, r);
-            if (c == column) {
-                this->deleteCacheData(coord);
-            }
+        if (!isset(this->columnRows[columnIndex])) {
+            return;
+        }
+        
+        for rowNumber in array_keys(this->columnRows[columnIndex]) {
+            this->deleteCacheData(strtoupper(column) . rowNumber);
         }
     }
 
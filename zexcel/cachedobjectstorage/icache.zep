@@ -68,6 +68,21 @@ interface ICache
      */
     public function copyCellCollection(<\ZExcel\Worksheet> parent);
 
+    /**
+     * Pin a cell in memory until it is released with unpinCell()
+     *
+     * @param    string        pCoord        Coordinate address of the cell to pin
+     * @return    boolean
+     */
+    public function pinCell(string pCoord) -> boolean;
+
+    /**
+     * Release a pin taken with pinCell()
+     *
+     * @param    string        pCoord        Coordinate address of the cell to unpin
+     */
+    public function unpinCell(string pCoord);
+
     /**
      * Identify whether the caching method is currently available
      * Some methods are dependent on the availability of certain extensions being enabled in the PHP build
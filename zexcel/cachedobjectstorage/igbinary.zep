@@ -36,6 +36,8 @@ class Igbinary extends CacheBase implements ICache
             this->storeData();
         }
 
+        this->indexCell(pCoord);
+
         let this->currentObjectID = pCoord;
         let this->currentObject = cell;
         let this->currentCellIsDirty = true;
@@ -56,6 +58,10 @@ class Igbinary extends CacheBase implements ICache
         if (pCoord === this->currentObjectID) {
             return this->currentObject;
         }
+
+        if (isset(this->pinnedCells[pCoord])) {
+            return this->activatePinnedCell(pCoord);
+        }
         this->storeData();
 
         //    Check if the entry that has been requested actually exists
@@ -104,6 +110,9 @@ class Igbinary extends CacheBase implements ICache
         }
         let this->cellCache = [];
 
+        let this->pinnedCells = [];
+        let this->pinCounts = [];
+
         //    detach ourself from the worksheet, so that it can then delete this object successfully
         let this->parent = null;
     }    //    function unsetWorksheetCells()
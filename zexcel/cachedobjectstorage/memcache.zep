@@ -66,6 +66,7 @@ class Memcache extends CacheBase implements ICache
             this->storeData();
         }
         let this->cellCache[pCoord] = true;
+        this->indexCell(pCoord);
 
         let this->currentObjectID = pCoord;
         let this->currentObject = cell;
@@ -118,6 +119,10 @@ class Memcache extends CacheBase implements ICache
         if (pCoord === this->currentObjectID) {
             return this->currentObject;
         }
+
+        if (isset(this->pinnedCells[pCoord])) {
+            return this->activatePinnedCell(pCoord);
+        }
         this->storeData();
 
         //    Check if the entry that has been requested actually exists
@@ -222,6 +227,9 @@ class Memcache extends CacheBase implements ICache
 
         let this->cellCache = [];
 
+        let this->pinnedCells = [];
+        let this->pinCounts = [];
+
         //    detach ourself from the worksheet, so that it can then delete this object successfully
         let this->parent = null;
     }
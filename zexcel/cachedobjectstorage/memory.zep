@@ -26,6 +26,7 @@ class Memory extends CacheBase implements ICache
         }
         
         let this->cellCache[pCoord] = cell;
+        this->indexCell(pCoord);
 
         //    Set current entry to the new/updated entry
         let this->currentObjectID = pCoord;
@@ -94,6 +95,9 @@ class Memory extends CacheBase implements ICache
 
         let this->cellCache = [];
 
+        let this->pinnedCells = [];
+        let this->pinCounts = [];
+
         //    detach ourself from the worksheet, so that it can then delete this object successfully
         let this->parent = null;
     }
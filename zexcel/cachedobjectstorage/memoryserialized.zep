@@ -35,6 +35,8 @@ class MemorySerialized extends CacheBase implements ICache
             this->storeData();
         }
 
+        this->indexCell(pCoord);
+
         let this->currentObjectID = pCoord;
         let this->currentObject = cell;
         let this->currentCellIsDirty = true;
@@ -54,6 +56,10 @@ class MemorySerialized extends CacheBase implements ICache
         if (pCoord === this->currentObjectID) {
             return this->currentObject;
         }
+
+        if (isset(this->pinnedCells[pCoord])) {
+            return this->activatePinnedCell(pCoord);
+        }
         this->storeData();
 
         //    Check if the entry that has been requested actually exists
@@ -100,6 +106,9 @@ class MemorySerialized extends CacheBase implements ICache
         }
         let this->cellCache = [];
 
+        let this->pinnedCells = [];
+        let this->pinCounts = [];
+
         //    detach ourself from the worksheet, so that it can then delete this object successfully
         let this->parent = null;
     }
@@ -51,6 +51,8 @@ class SQLite extends CacheBase implements ICache
             this->storeData();
         }
 
+        this->indexCell(pCoord);
+
         let this->currentObjectID = pCoord;
         let this->currentObject = cell;
         let this->currentCellIsDirty = true;
@@ -73,6 +75,10 @@ class SQLite extends CacheBase implements ICache
         if (pCoord === this->currentObjectID) {
             return this->currentObject;
         }
+
+        if (isset(this->pinnedCells[pCoord])) {
+            return this->activatePinnedCell(pCoord);
+        }
         this->storeData();
 
         let query = "SELECT value FROM kvp_" . this->TableName . " WHERE id='" . pCoord . "'";
@@ -146,12 +152,17 @@ class SQLite extends CacheBase implements ICache
             let this->currentObject = null;
         }
 
+        this->forgetPinnedCell(pCoord);
+
         //    Check if the requested entry exists in the cache
         let query = "DELETE FROM kvp_" . this->TableName . " WHERE id='" . pCoord . "'";
         if (!this->DBHandle->queryExec(query)) {
             throw new \ZExcel\Exception(sqlite_error_string(this->DBHandle->lastError()));
         }
 
+        this->unindexCell(pCoord);
+        this->notifyCellDeleted(pCoord);
+
         let this->currentCellIsDirty = false;
     }
 
@@ -171,6 +182,9 @@ class SQLite extends CacheBase implements ICache
             let this->currentObjectID = toAddress;
         }
 
+        this->forgetPinnedCell(fromAddress);
+        this->forgetPinnedCell(toAddress);
+
         let query = "DELETE FROM kvp_" . this->TableName . " WHERE id='" . toAddress . "'";
         let result = this->DBHandle->exec(query);
         
@@ -184,6 +198,10 @@ class SQLite extends CacheBase implements ICache
             throw new \ZExcel\Exception(this->DBHandle->lastErrorMsg());
         }
 
+        if (this->unindexCell(fromAddress)) {
+            this->indexCell(toAddress);
+        }
+
         return true;
     }
 
@@ -228,6 +246,10 @@ class SQLite extends CacheBase implements ICache
         
         this->storeData();
 
+        //    Pins belong to the original collection
+        let this->pinnedCells = [];
+        let this->pinCounts = [];
+
         //    Get a new id for the new table name
         let tableName = str_replace(".", "_", this->getUniqueID());
         if (!this->DBHandle->queryExec("CREATE TABLE kvp_" . tableName . " (id VARCHAR(12) PRIMARY KEY, value BLOB) AS SELECT * FROM kvp_" . this->TableName)
@@ -251,6 +273,9 @@ class SQLite extends CacheBase implements ICache
             let this->currentObject = null;
             let this->currentObjectID = null;
         }
+        let this->pinnedCells = [];
+        let this->pinCounts = [];
+
         //    detach ourself from the worksheet, so that it can then delete this object successfully
         let this->parent = null;
 
@@ -87,6 +87,8 @@ class SQLite3 extends CacheBase implements ICache
             this->storeData();
         }
 
+        this->indexCell(pCoord);
+
         let this->currentObjectID = pCoord;
         let this->currentObject = cell;
         let this->currentCellIsDirty = true;
@@ -108,6 +110,10 @@ class SQLite3 extends CacheBase implements ICache
         if (pCoord === this->currentObjectID) {
             return this->currentObject;
         }
+
+        if (isset(this->pinnedCells[pCoord])) {
+            return this->activatePinnedCell(pCoord);
+        }
         
         this->storeData();
 
@@ -181,6 +187,8 @@ class SQLite3 extends CacheBase implements ICache
             let this->currentObject = null;
         }
 
+        this->forgetPinnedCell(pCoord);
+
         //    Check if the requested entry exists in the cache
         this->deleteQuery->bindValue("id", pCoord, SQLITE3_TEXT);
         
@@ -190,6 +198,9 @@ class SQLite3 extends CacheBase implements ICache
             throw new \ZExcel\Exception(this->DBHandle->lastErrorMsg());
         }
 
+        this->unindexCell(pCoord);
+        this->notifyCellDeleted(pCoord);
+
         let this->currentCellIsDirty = false;
     }
 
@@ -208,6 +219,9 @@ class SQLite3 extends CacheBase implements ICache
             let this->currentObjectID = toAddress;
         }
 
+        this->forgetPinnedCell(fromAddress);
+        this->forgetPinnedCell(toAddress);
+
         this->deleteQuery->bindValue("id", toAddress, SQLITE3_TEXT);
         
         let result = this->deleteQuery->execute();
@@ -225,6 +239,10 @@ class SQLite3 extends CacheBase implements ICache
             throw new \ZExcel\Exception(this->DBHandle->lastErrorMsg());
         }
 
+        if (this->unindexCell(fromAddress)) {
+            this->indexCell(toAddress);
+        }
+
         return true;
     }
 
@@ -271,6 +289,10 @@ class SQLite3 extends CacheBase implements ICache
         
         this->storeData();
 
+        //    Pins belong to the original collection
+        let this->pinnedCells = [];
+        let this->pinCounts = [];
+
         //    Get a new id for the new table name
         let tableName = str_replace(".", "_", this->getUniqueID());
         if (!this->DBHandle->exec("CREATE TABLE kvp_".tableName." (id VARCHAR(12) PRIMARY KEY, value BLOB) AS SELECT * FROM kvp_".this->TableName)
@@ -294,6 +316,9 @@ class SQLite3 extends CacheBase implements ICache
             let this->currentObject = null;
             let this->currentObjectID = null;
         }
+        let this->pinnedCells = [];
+        let this->pinCounts = [];
+
         //    detach ourself from the worksheet, so that it can then delete this object successfully
         let this->parent = null;
 
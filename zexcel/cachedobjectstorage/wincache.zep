@@ -65,6 +65,8 @@ class Wincache extends CacheBase implements ICache
         }
         
         let this->cellCache[pCoord] = true;
+        this->indexCell(pCoord);
+
         let this->currentObjectID = pCoord;
         let this->currentObject = cell;
         let this->currentCellIsDirty = true;
@@ -118,6 +120,10 @@ class Wincache extends CacheBase implements ICache
         if (pCoord === this->currentObjectID) {
             return this->currentObject;
         }
+
+        if (isset(this->pinnedCells[pCoord])) {
+            return this->activatePinnedCell(pCoord);
+        }
         
         this->storeData();
 
@@ -236,6 +242,9 @@ class Wincache extends CacheBase implements ICache
 
         let this->cellCache = [];
 
+        let this->pinnedCells = [];
+        let this->pinCounts = [];
+
         //    detach ourself from the worksheet, so that it can then delete this object successfully
         let this->parent = null;
     }
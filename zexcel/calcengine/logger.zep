@@ -28,6 +28,34 @@ class Logger
      */
     private debugLog = [];
 
+    /**
+     * Flag to determine whether per-cell trace events should be recorded by the calculation engine
+     *
+     * @var boolean
+     */
+    private writeTrace = false;
+
+    /**
+     * Maximum number of trace events kept; once full, the oldest events are overwritten
+     *
+     * @var integer
+     */
+    private traceCapacity = 1024;
+
+    /**
+     * Ring buffer of trace events
+     *
+     * @var array[]
+     */
+    private traceEvents = [];
+
+    /**
+     * Slot in the ring buffer that the next trace event will be written to
+     *
+     * @var integer
+     */
+    private traceNext = 0;
+
     /**
      * The calculation engine cell reference stack
      *
@@ -85,6 +113,120 @@ class Logger
         return this->echoDebugLog;
     }
 
+    /**
+     * Enable/Disable recording of per-cell trace events
+     *
+     * @param  boolean pValue
+     * @param  integer capacity  Number of events kept in the ring buffer
+     * @throws \ZExcel\Exception
+     */
+    public function setWriteTrace(boolean pValue = false, int capacity = 1024)
+    {
+        if (capacity < 1) {
+            throw new \ZExcel\Exception("Trace capacity must be at least 1.");
+        }
+
+        if (capacity != this->traceCapacity) {
+            let this->traceCapacity = capacity;
+            this->clearTrace();
+        }
+
+        let this->writeTrace = pValue;
+    }
+
+    /**
+     * Return whether per-cell trace events are recorded
+     *
+     * @return  boolean
+     */
+    public function getWriteTrace() -> boolean
+    {
+        return this->writeTrace;
+    }
+
+    /**
+     * Record the calculation of a cell
+     *
+     * @param  string  cellReference  Cell reference (e.g. Worksheet!A1)
+     * @param  string  formula        Formula of the cell
+     * @param  float   duration       Time taken, in seconds, including the calculation of its precedents
+     * @param  boolean cacheHit       Whether the value was served from the calculation cache
+     * @param  mixed   dependencies   Number of cell, range and named range references, or null if unknown
+     */
+    public function writeTraceEvent(string cellReference, string formula, double duration, boolean cacheHit, var dependencies = null)
+    {
+        if (!this->writeTrace) {
+            return;
+        }
+
+        let this->traceEvents[this->traceNext] = [
+            "cell": cellReference,
+            "formula": formula,
+            "duration": duration,
+            "cacheHit": cacheHit,
+            "dependencies": dependencies
+        ];
+
+        let this->traceNext = (this->traceNext + 1) % this->traceCapacity;
+    }
+
+    /**
+     * Return the recorded trace events, oldest first
+     *
+     * @return  array[]
+     */
+    public function getTrace() -> array
+    {
+        if (count(this->traceEvents) < this->traceCapacity || this->traceNext == 0) {
+            return array_values(this->traceEvents);
+        }
+
+        return array_merge(
+            array_slice(this->traceEvents, this->traceNext),
+            array_slice(this->traceEvents, 0, this->traceNext)
+        );
+    }
+
+    /**
+     * Clear the recorded trace events
+     */
+    public function clearTrace()
+    {
+        let this->traceEvents = [];
+        let this->traceNext = 0;
+    }
+
+    /**
+     * Write the recorded trace events to a CSV file, oldest first
+     *
+     * @param  string  pFilename
+     * @throws \ZExcel\Exception
+     */
+    public function exportTrace(string pFilename)
+    {
+        var fileHandle, event;
+
+        let fileHandle = fopen(pFilename, "w");
+
+        if (fileHandle === false) {
+            throw new \ZExcel\Exception("Could not open " . pFilename . " for writing.");
+        }
+
+        fputcsv(fileHandle, ["cell", "formula", "duration", "cacheHit", "dependencies"]);
+
+        for event in this->getTrace() {
+            fputcsv(fileHandle, [
+                event["cell"],
+                event["formula"],
+                sprintf("%.6F", event["duration"]),
+                event["cacheHit"] ? 1 : 0,
+                event["dependencies"]
+            ]);
+        }
+
+        fclose(fileHandle);
+    }
+
     /**
      * Write an entry to the calculation engine debug log
      */
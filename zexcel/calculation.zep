@@ -26,6 +26,19 @@ class Calculation
     const RETURN_ARRAY_AS_VALUE = "value";
     const RETURN_ARRAY_AS_ARRAY = "array";
 
+    /** bytecode opcodes (@see compileTokens) */
+    const OPCODE_VALUE       = 1;
+    const OPCODE_CONSTANT    = 2;
+    const OPCODE_BINARY      = 3;
+    const OPCODE_UNARY       = 4;
+    const OPCODE_CELL        = 5;
+    const OPCODE_CALL        = 6;
+    const OPCODE_NAMED_RANGE = 7;
+    const OPCODE_ERROR       = 8;
+
+    /* Maximum number of compiled formulae kept in memory */
+    const COMPILED_FORMULAE_LIMIT = 4096;
+
     private static returnArrayAsType = self::RETURN_ARRAY_AS_VALUE;
 
 
@@ -48,21 +61,134 @@ class Calculation
     private workbook;
 
     /**
-     * List of instances of the calculation engine that we've instantiated for individual workbooks
+     * Calculation cache, partitioned by worksheet title and then indexed by cell address
+     *
+     * @access    private
+     * @var array
+     */
+    private _calculationCache = [];
+
+    /**
+     * Number of values held in the calculation cache
+     *
+     * @access    private
+     * @var integer
+     */
+    private calculationCacheCount = 0;
+
+    /**
+     * Maximum number of values held in the calculation cache (0 for no limit)
+     *
+     * @access    private
+     * @var integer
+     */
+    private calculationCacheLimit = 0;
+
+    /**
+     * Areas read by the formulae whose values were cached, in a spatial index per worksheet read from, indexed by
+     *    worksheet title. Areas are keyed "Worksheet!A1|area" (e.g. "Summary!B2|1,1,1,10"), with the formula
+     *    worksheet title and cell address as payload
      *
      * @access    private
-     * @var \ZExcel\Calculation[]
+     * @var \ZExcel\Calculation\DependencyIndex[]
      */
-    private static _workbookSets;
+    private calculationCacheDependents = [];
 
     /**
-     * Calculation cache
+     * Keys of the areas in calculationCacheDependents read by each formula, indexed by "Worksheet!A1"
+     *    (e.g. ["Summary!B2" => [["Data", "Summary!B2|1,1,1,10"]]])
      *
      * @access    private
      * @var array
      */
-    private _calculationCache = [];
+    private calculationCacheReads = [];
+
+    /**
+     * Formula cells being calculated, innermost last, as [worksheet title, cell address]
+     *
+     * @access    private
+     * @var array
+     */
+    private calculationCacheReaderStack = [];
+
+    /**
+     * Number of calculation cache lookups answered from the cache
+     *
+     * @access    private
+     * @var integer
+     */
+    private calculationCacheHits = 0;
+
+    /**
+     * Number of calculation cache lookups that missed
+     *
+     * @access    private
+     * @var integer
+     */
+    private calculationCacheMisses = 0;
+
+    /**
+     * Return the calculated value stored in a formula cell (e.g. as read from a file) instead of
+     *    evaluating the formula, until a cell the formula depends on changes
+     *
+     * @access    private
+     * @var boolean
+     */
+    private trustCachedValues = false;
+
+    /**
+     * Formula cells whose stored calculated value is no longer trusted, indexed by "Worksheet!A1"
+     *
+     * @access    private
+     * @var array
+     */
+    private staleFormulae = [];
+
+    /**
+     * Cells (or blocks of cells) changed since stale formulae were last looked for, indexed by worksheet title
+     *    and then by cell address or range (e.g. ["Data" => ["A1" => true, "B1:C10" => true]])
+     *
+     * @access    private
+     * @var array
+     */
+    private pendingChanges = [];
+
+    /**
+     * Areas read by formula cells, in a spatial index per worksheet read from, indexed by worksheet title
+     *    Areas are keyed "Worksheet!A1|area", with the formula worksheet title and cell address as payload
+     *    Built when first needed
+     *
+     * @access    private
+     * @var \ZExcel\Calculation\DependencyIndex[]
+     */
+    private formulaDependents = null;
+
+    /**
+     * Areas held in formulaDependents for each formula cell, as [worksheet title read from, area key],
+     *    indexed by "Worksheet!A1"
+     *
+     * @access    private
+     * @var array
+     */
+    private indexedFormulae = [];
+
+    /**
+     * Formula cells whose references are only known when evaluated (volatile functions, INDIRECT, OFFSET,
+     *    named ranges), as [worksheet title, cell address] indexed by "Worksheet!A1"
+     *
+     * @access    private
+     * @var array
+     */
+    private dynamicFormulae = [];
 
+    /**
+     * Formula cells whose stored calculated value is never trusted: the dynamic formulae and the formulae
+     *    depending on them, indexed by "Worksheet!A1"
+     *
+     * @access    private
+     * @var array
+     */
+    private volatileFormulae = [];
 
     /**
      * Calculation cache enabled
@@ -71,6 +197,42 @@ class Calculation
      * @var boolean
      */
     private calculationCacheEnabled = true;
+
+    /**
+     * Bytecode for formulae that have already been compiled, indexed by formula
+     *
+     * @access    private
+     * @var array
+     */
+    private static compiledFormulae = [];
+
+    /**
+     * Function handlers resolved from the function tables, indexed by function name
+     *
+     * @access    private
+     * @var array
+     */
+    private static functionHandlers = [];
+
+    /**
+     * Functions whose result does not only depend on the cells their formula references
+     *
+     * @access    private
+     * @var array
+     */
+    private static dynamicFunctions = [
+        "CELL": true,       "INDIRECT": true,      "INFO": true,
+        "NOW": true,        "OFFSET": true,        "RAND": true,
+        "RANDBETWEEN": true, "TODAY": true
+    ];
+
+    /**
+     * Set by _parseFormula() when the token stack depends on the worksheet of the cell being parsed
+     *
+     * @access    private
+     * @var boolean
+     */
+    private parseUsesCellContext = false;
     
     /**
      * List of operators that can be used within formulae
@@ -131,8 +293,6 @@ class Calculation
      */
     private _cyclicReferenceStack;
 
-    private cellStack = [];
-
     /**
      * Number of iterations for cyclic formulae
      *
@@ -177,6 +337,14 @@ class Calculation
      */
     private static _validLocaleLanguages = ["en"];        //  English     (default language)
     
+    /**
+     * Directory holding a subdirectory of function and config files for each locale language
+     *
+     * @var string
+     *
+     */
+    private static localeFileDirectory = "PHPExcel/locale";
+    
     /**
      * Locale-specific argument separator for function arguments
      *
@@ -191,6 +359,14 @@ class Calculation
     private static functionReplaceToExcel = null;
     private static functionReplaceFromLocale = null;
     private static functionReplaceToLocale = null;
+    
+    /**
+     * Parsed locale tables (function names, argument separator, booleans and translation
+     * expressions), indexed by locale
+     *
+     * @var array
+     */
+    private static localeTables = [];
             
     /**
      * Locale-specific translations for Excel constants (True, False and Null)
@@ -2067,7 +2243,7 @@ class Calculation
     {
         var localeFileDirectory, filename;
         
-        let localeFileDirectory = "PHPExcel/locale/";
+        let localeFileDirectory = self::localeFileDirectory;
         
         for filename in glob(localeFileDirectory . "/*",GLOB_ONLYDIR) {
             let filename = substr(filename, strlen(localeFileDirectory) + 1);
@@ -2080,6 +2256,9 @@ class Calculation
     /**
      * Get an instance of this class
      *
+     * A workbook owns a single calculation engine for its whole lifetime, so that its calculation
+     * cache and dependency state are shared by every caller
+     *
      * @access  public
      * @param   PHPExcel workbook  Injected workbook for working with a PHPExcel object,
      *                                    or null to create a standalone claculation engine
@@ -2087,11 +2266,17 @@ class Calculation
      */
     public static function getInstance(<\ZExcel\ZExcel> workbook = null) -> <\ZExcel\Calculation>
     {
+        var instance;
+        
         if (workbook !== null) {
-            if (isset(self::_workbookSets[workbook->getID()])) {
-                return self::_workbookSets[workbook->getID()];
+            let instance = self::getExistingInstance(workbook);
+            
+            if (instance === null) {
+                //    Only while the workbook is being constructed
+                let instance = new \ZExcel\Calculation(workbook);
             }
-            return new \ZExcel\Calculation(workbook);
+            
+            return instance;
         }
         
         if (!isset(self::_instance) || (self::_instance === null)) {
@@ -2101,6 +2286,18 @@ class Calculation
         return self::_instance;
     }
     
+    /**
+     * Get the calculation engine instance of a workbook, without creating one if there is none yet
+     *
+     * @access    public
+     * @param    \ZExcel\ZExcel    workbook
+     * @return \ZExcel\Calculation|null
+     */
+    public static function getExistingInstance(<\ZExcel\ZExcel> workbook)
+    {
+        return workbook->getCalculationEngine();
+    }
+    
     public function __destruct()
     {
         let this->workbook = null;
@@ -2242,141 +2439,757 @@ class Calculation
     public function clearCalculationCache()
     {
         let this->_calculationCache = [];
+        let this->calculationCacheCount = 0;
+        let this->calculationCacheDependents = [];
+        let this->calculationCacheReads = [];
     }
 
     /**
-     * Clear calculation cache for a specified worksheet
+     * Get the calculation cache statistics
+     *
+     * @return array    Number of lookups answered from the cache ("hits") or not ("misses"),
+     *                    and number of values held in the cache ("entries")
+     */
+    public function getCalculationCacheStatistics() -> array
+    {
+        return [
+            "hits": this->calculationCacheHits,
+            "misses": this->calculationCacheMisses,
+            "entries": this->calculationCacheCount
+        ];
+    }
+
+    /**
+     * Reset the calculation cache hit and miss counters
+     */
+    public function resetCalculationCacheStatistics()
+    {
+        let this->calculationCacheHits = 0;
+        let this->calculationCacheMisses = 0;
+    }
+
+    /**
+     * Get the maximum number of values held in the calculation cache
+     *
+     * @return integer    0 if there is no limit
+     */
+    public function getCalculationCacheLimit() -> int
+    {
+        return this->calculationCacheLimit;
+    }
+
+    /**
+     * Set the maximum number of values held in the calculation cache
+     *    When the limit is reached, the values cached first are discarded, those of the worksheet being
+     *    calculated last
+     *
+     * @param integer pValue    0 for no limit
+     */
+    public function setCalculationCacheLimit(int pValue = 0)
+    {
+        let this->calculationCacheLimit = max(0, pValue);
+
+        if (this->calculationCacheLimit > 0) {
+            this->trimCalculationCache(this->calculationCacheLimit);
+        }
+    }
+
+    /**
+     * Clear calculation cache for a specified worksheet, and for the formulae that read from it
      *
      * @param string worksheetName
      */
     public function clearCalculationCacheForWorksheet(var worksheetName)
     {
-        if (isset(this->_calculationCache[worksheetName])) {
-            unset(this->_calculationCache[worksheetName]);
-        }
+        this->invalidateCalculationCache(worksheetName, "A1:XFD1048576");
     }
     
-    public function renameCalculationCacheForWorksheet(fromWorksheetName, toWorksheetName)
+    /**
+     * Move the cached values of a worksheet to its new title
+     *
+     * @param string fromWorksheetName
+     * @param string toWorksheetName
+     */
+    public function renameCalculationCacheForWorksheet(var fromWorksheetName, var toWorksheetName)
     {
+        var source, sourceIndex, index, area, reader, readerKey, key;
+        array dependents = [], reads = [];
+
         if (isset(this->_calculationCache[fromWorksheetName])) {
             let this->_calculationCache[toWorksheetName] = this->_calculationCache[fromWorksheetName];
             unset(this->_calculationCache[fromWorksheetName]);
         }
+
+        //    Area keys hold the title of the formula worksheet: index the areas again
+        for source, sourceIndex in this->calculationCacheDependents {
+            if (source == fromWorksheetName) {
+                let source = toWorksheetName;
+            }
+
+            let index = new \ZExcel\Calculation\DependencyIndex();
+            let dependents[source] = index;
+
+            for area in sourceIndex->getAreas() {
+                let reader = area[4];
+
+                if (reader[0] == fromWorksheetName) {
+                    let reader[0] = toWorksheetName;
+                }
+
+                let readerKey = reader[0] . "!" . reader[1];
+                let key = readerKey . "|" . area[0] . "," . area[1] . "," . area[2] . "," . area[3];
+                index->add(key, area[0], area[1], area[2], area[3], reader);
+                let reads[readerKey][] = [source, key];
+            }
+        }
+
+        let this->calculationCacheDependents = dependents;
+        let this->calculationCacheReads = reads;
+
+        if (this->trustCachedValues) {
+            this->renameTrustedValuesForWorksheet(fromWorksheetName, toWorksheetName);
+        }
     }
 
     /**
-     * Get the currently defined locale code
+     * Move the stale formulae and pending changes of a worksheet to its new title
      *
-     * @return string
+     * @param string fromWorksheetName
+     * @param string toWorksheetName
      */
-    public function getLocale()
+    private function renameTrustedValuesForWorksheet(string fromWorksheetName, string toWorksheetName)
     {
-        return self::_localeLanguage;
+        var key, prefix;
+        array staleFormulae = [];
+
+        let prefix = fromWorksheetName . "!";
+
+        for key, _ in this->staleFormulae {
+            if (strpos(key, prefix) === 0) {
+                let key = toWorksheetName . "!" . substr(key, strlen(prefix));
+            }
+
+            let staleFormulae[key] = true;
+        }
+
+        let this->staleFormulae = staleFormulae;
+
+        if (isset(this->pendingChanges[fromWorksheetName])) {
+            let this->pendingChanges[toWorksheetName] = this->pendingChanges[fromWorksheetName];
+            unset(this->pendingChanges[fromWorksheetName]);
+        }
+
+        //    Formulae refer to worksheets by title: index them again when next needed
+        let this->formulaDependents = null;
+        let this->indexedFormulae = [];
+        let this->dynamicFormulae = [];
+        let this->volatileFormulae = [];
     }
 
     /**
-     * Set the locale code
+     * Invalidate the calculated values that may depend on a cell whose value has changed
+     *
+     * @param string worksheetName
+     * @param string cellID         Cell address, or range of a block of cells (e.g. A1:C10)
+     */
+    public function cellValueChanged(string worksheetName, string cellID)
+    {
+        if (this->calculationCacheCount > 0) {
+            this->invalidateCalculationCache(worksheetName, cellID);
+        }
+        
+        //    Looking for the formulae depending on the cell visits other cells of the store, so it waits for the next read
+        if (this->trustCachedValues) {
+            let this->pendingChanges[worksheetName][cellID] = true;
+        }
+    }
+
+    /**
+     * Is trusting the calculated values stored in formula cells enabled?
      *
-     * @param string locale  The locale to use for formula translation
      * @return boolean
      */
-    public function setLocale(string locale = "en_us")
+    public function getTrustCachedValues() -> boolean
+    {
+        return this->trustCachedValues;
+    }
+
+    /**
+     * Enable or disable trusting the calculated values stored in formula cells
+     *
+     * While enabled, getCalculatedValue returns the value stored in a formula cell (e.g. the value read
+     *    from a file) without evaluating the formula, until a cell the formula depends on, directly or
+     *    through other formulae, changes. Enable it once the workbook is loaded.
+     *    Formulae calling volatile functions (NOW, RAND...), INDIRECT or OFFSET, or reading named ranges,
+     *    and the formulae depending on them, are always evaluated.
+     *
+     * @param boolean pValue
+     * @return \ZExcel\Calculation
+     */
+    public function setTrustCachedValues(boolean pValue = true) -> <\ZExcel\Calculation>
     {
-        var language, functionNamesFile, localeFunction, localeFunctions, fName, lfName, tmp, configFile, localeSettings, localeSetting, settingName, settingValue;
+        let this->trustCachedValues = pValue;
+        let this->staleFormulae = [];
+        let this->pendingChanges = [];
+        let this->formulaDependents = null;
+        let this->indexedFormulae = [];
+        let this->dynamicFormulae = [];
+        let this->volatileFormulae = [];
         
-        //    Identify our locale and language
-        let language = strtolower(locale);
-        let locale = language;
+        return this;
+    }
+
+    /**
+     * Can the calculated value stored in a formula cell be returned without evaluating the formula?
+     *
+     * @param \ZExcel\Cell pCell Formula cell
+     * @return boolean
+     */
+    public function isCalculatedValueTrusted(<\ZExcel\Cell> pCell) -> boolean
+    {
+        var cellCollection, cellID, key;
         
-        if (strpos(locale,"_") !== false) {
-            let language = explode("_",locale);
-            let language = language[0];
+        if (!this->trustCachedValues || pCell->getOldCalculatedValue() === null) {
+            return false;
         }
-
-        if (count(self::_validLocaleLanguages) == 1) {
-            self::_loadLocales();
+        
+        let cellCollection = pCell->getParent();
+        let cellID = pCell->getCoordinate();
+        
+        if (!empty(this->pendingChanges) || this->formulaDependents === null) {
+            //    Pin the cell while other cells of the store are visited
+            cellCollection->pinCell(cellID);
+            this->markChangedDependentsStale();
+            cellCollection->getCacheData(cellID);
+            cellCollection->unpinCell(cellID);
         }
+        
+        let key = cellCollection->getParent()->getTitle() . "!" . cellID;
+        
+        return !isset(this->staleFormulae[key]) && !isset(this->volatileFormulae[key]);
+    }
 
-        //    Test whether we have any language data for this language (any locale)
-        if (in_array(language,self::_validLocaleLanguages)) {
-            //    initialise language/locale settings
-            let self::_localeFunctions = [];
-            let self::_localeArgumentSeparator = ",";
-            let self::localeBoolean = ["TRUE": "TRUE", "FALSE": "FALSE", "NULL": "NULL"];
-            
-            //    Default is English, if user isn"t requesting english, then read the necessary data from the locale files
-            if (locale != "en_us") {
-                //    Search for a file with a list of function names for locale
-                let functionNamesFile = "ZExcel" . DIRECTORY_SEPARATOR . "locale" . DIRECTORY_SEPARATOR . str_replace("_",DIRECTORY_SEPARATOR,locale) . DIRECTORY_SEPARATOR . "functions";
-                
-                if (!file_exists(functionNamesFile)) {
-                    //    If there isn"t a locale specific function file, look for a language specific function file
-                    let functionNamesFile = "ZExcel" . DIRECTORY_SEPARATOR . "locale" . DIRECTORY_SEPARATOR . language . DIRECTORY_SEPARATOR . "functions";
-                    
-                    if (!file_exists(functionNamesFile)) {
-                        return false;
-                    }
-                }
-                
-                //    Retrieve the list of locale or language specific function names
-                let localeFunctions = file(functionNamesFile, FILE_IGNORE_NEW_LINES | FILE_SKIP_EMPTY_LINES);
+    /**
+     * Note that the calculated value stored in a formula cell is up to date again
+     *
+     * @param \ZExcel\Cell pCell Formula cell
+     */
+    public function calculatedValueRefreshed(<\ZExcel\Cell> pCell)
+    {
+        unset(this->staleFormulae[pCell->getWorksheet()->getTitle() . "!" . pCell->getCoordinate()]);
+    }
+
+    /**
+     * Mark the formula cells depending on the cells changed since the last call as stale
+     */
+    private function markChangedDependentsStale()
+    {
+        var changes, title, cellIDs, cellID, worksheet, formulaCellID;
+        array queue = [];
+        
+        let changes = this->pendingChanges;
+        let this->pendingChanges = [];
+        
+        if (this->formulaDependents === null) {
+            this->indexFormulaDependents();
+        } else {
+            //    Changed formula cells may read from other cells now
+            for title, cellIDs in changes {
+                let worksheet = this->workbook->getSheetByName(title);
                 
-                for localeFunction in localeFunctions {
-                    let localeFunction = explode("##", localeFunction);
-                    let localeFunction = localeFunction[0];    //    Strip out comments
-                    
-                    if (strpos(localeFunction,"=") !== false) {
-                        let tmp = explode("=",localeFunction);
-                        let fName = trim(tmp[0]);
-                        let lfName = trim(tmp[1]);
+                for cellID, _ in cellIDs {
+                    if (strpos(cellID, ":") === false) {
+                        this->forgetFormulaDependent(title, cellID);
                         
-                        if ((isset(self::PHPExcelFunctions[fName])) && (lfName != "") && (fName != lfName)) {
-                            let self::_localeFunctions[fName] = lfName;
+                        if (worksheet !== null && worksheet->cellExists(cellID)) {
+                            this->indexFormulaDependent(worksheet, cellID);
+                        }
+                    } elseif (worksheet !== null) {
+                        //    A block of cells was written at once: every cell it held is still there
+                        for formulaCellID in this->cellsInBlock(worksheet, cellID) {
+                            this->forgetFormulaDependent(title, formulaCellID);
+                            this->indexFormulaDependent(worksheet, formulaCellID);
                         }
                     }
                 }
-                //    Default the TRUE and FALSE constants to the locale names of the TRUE() and FALSE() functions
-                if (isset(self::_localeFunctions["TRUE"])) {
-                    let self::localeBoolean["TRUE"] = self::_localeFunctions["TRUE"];
-                }
-                
-                if (isset(self::_localeFunctions["FALSE"])) {
-                    let self::localeBoolean["FALSE"] = self::_localeFunctions["FALSE"];
-                }
+            }
+        }
+        
+        //    Follow every change at once, each dependent formula being reached once
+        for title, cellIDs in changes {
+            for cellID, _ in cellIDs {
+                let queue[] = [title, cellID];
+                
+                if (strpos(cellID, ":") === false) {
+                    let this->staleFormulae[title . "!" . cellID] = true;
+                }
+            }
+        }
+        
+        let this->staleFormulae = this->collectDependents(queue, this->staleFormulae);
+        
+        //    The index changed: so may have the formulae depending on dynamic formulae
+        let this->volatileFormulae = this->collectDependents(
+            array_values(this->dynamicFormulae),
+            array_fill_keys(array_keys(this->dynamicFormulae), true)
+        );
+    }
 
-                let configFile = "PHPExcel" . DIRECTORY_SEPARATOR . "locale" . DIRECTORY_SEPARATOR . str_replace("_", DIRECTORY_SEPARATOR, locale) . DIRECTORY_SEPARATOR . "config";
+    /**
+     * Find the formula cells depending, directly or through other formulae, on cells
+     *
+     * @param array queue   Cells (or blocks of cells) to start from, each as [worksheet title, cell address or range]
+     * @param array reached Formula cells already found, indexed by "Worksheet!A1"; their dependents are not looked for
+     * @return array Formula cells found, added to reached
+     */
+    private function collectDependents(array queue, array reached) -> array
+    {
+        var item, reader, key, boundaries, index, readers;
+        
+        while (!empty(queue)) {
+            let item = array_pop(queue);
+            
+            if (!isset(this->formulaDependents[item[0]])) {
+                continue;
+            }
+            
+            let boundaries = \ZExcel\Cell::rangeBoundaries(item[1]);
+            let index = this->formulaDependents[item[0]];
+            
+            let readers = index->find(
+                min(boundaries[0][0], boundaries[1][0]),
+                min(boundaries[0][1], boundaries[1][1]),
+                max(boundaries[0][0], boundaries[1][0]),
+                max(boundaries[0][1], boundaries[1][1])
+            );
+            
+            for reader in readers {
+                let key = reader[0] . "!" . reader[1];
                 
-                if (!file_exists(configFile)) {
-                    let configFile = "PHPExcel" . DIRECTORY_SEPARATOR . "locale" . DIRECTORY_SEPARATOR . language . DIRECTORY_SEPARATOR . "config";
+                if (!isset(reached[key])) {
+                    let reached[key] = true;
+                    let queue[] = reader;
+                }
+            }
+        }
+        
+        return reached;
+    }
+
+    /**
+     * List the cells of a worksheet that exist within a block
+     *
+     * @param \ZExcel\Worksheet worksheet
+     * @param string             block     Range of the block (e.g. A1:C10)
+     * @return string[]
+     */
+    private function cellsInBlock(<\ZExcel\Worksheet> worksheet, string block) -> array
+    {
+        var boundaries, cellID, columnLetters, cellIDs;
+        int firstColumn, firstRow, lastColumn, lastRow, column, row, packed;
+        array found = [];
+        
+        let boundaries = \ZExcel\Cell::rangeBoundaries(block);
+        let firstColumn = min(boundaries[0][0], boundaries[1][0]);
+        let firstRow = min(boundaries[0][1], boundaries[1][1]);
+        let lastColumn = max(boundaries[0][0], boundaries[1][0]);
+        let lastRow = max(boundaries[0][1], boundaries[1][1]);
+        let cellIDs = worksheet->getCellCollection(false);
+        
+        //    Walk the block or the cells of the worksheet, whichever is smaller
+        if ((lastColumn - firstColumn + 1) * (lastRow - firstRow + 1) <= count(cellIDs)) {
+            for column in range(firstColumn, lastColumn) {
+                let columnLetters = \ZExcel\Cell::stringFromColumnIndex(column - 1);
+                
+                for row in range(firstRow, lastRow) {
+                    if (worksheet->cellExists(columnLetters . row)) {
+                        let found[] = columnLetters . row;
+                    }
                 }
+            }
+        } else {
+            for cellID in cellIDs {
+                let packed = \ZExcel\Cell\Coordinate::parse(cellID);
+                let column = \ZExcel\Cell\Coordinate::column(packed);
+                let row = \ZExcel\Cell\Coordinate::row(packed);
                 
-                if (file_exists(configFile)) {
-                    let localeSettings = file(configFile, FILE_IGNORE_NEW_LINES | FILE_SKIP_EMPTY_LINES);
-                    
-                    for localeSetting in localeSettings {
-                        let localeSetting = explode("##",localeSetting);    //    Strip out comments
-                        let localeSetting = localeSetting[0];
-                        
-                        if (strpos(localeSetting,"=") !== false) {
-                            let settingName = explode("=", localeSetting);
-                            
-                            let settingValue = settingName[1];
-                            let settingName = strtoupper(trim(settingName[0]));
-                            
-                            switch (settingName) {
-                                case "ARGUMENTSEPARATOR" :
-                                    let self::_localeArgumentSeparator = trim(settingValue);
-                                    break;
+                if (column >= firstColumn && column <= lastColumn && row >= firstRow && row <= lastRow) {
+                    let found[] = cellID;
+                }
+            }
+        }
+        
+        return found;
+    }
+
+    /**
+     * Index the areas read by every formula cell of the workbook
+     */
+    private function indexFormulaDependents()
+    {
+        var worksheet, cellID;
+        
+        let this->formulaDependents = [];
+        let this->indexedFormulae = [];
+        let this->dynamicFormulae = [];
+        
+        if (this->workbook === null) {
+            return;
+        }
+        
+        for worksheet in this->workbook->getAllSheets() {
+            for cellID in worksheet->getCellCollection(false) {
+                this->indexFormulaDependent(worksheet, cellID);
+            }
+        }
+    }
+
+    /**
+     * Index the areas read by a cell, if it holds a formula
+     *
+     * @param \ZExcel\Worksheet worksheet
+     * @param string             cellID
+     */
+    private function indexFormulaDependent(<\ZExcel\Worksheet> worksheet, string cellID)
+    {
+        var cell, title, formulaKey, reference, refTitle, boundaries, key, index, e;
+        int firstColumn, firstRow, lastColumn, lastRow;
+        array areas = [];
+        
+        let cell = worksheet->getCell(cellID);
+        
+        if (cell->getDataType() != \ZExcel\Cell\DataType::TYPE_FORMULA) {
+            return;
+        }
+        
+        let title = worksheet->getTitle();
+        let formulaKey = title . "!" . cellID;
+        
+        try {
+            if (this->hasDynamicReferences(cell)) {
+                let this->dynamicFormulae[formulaKey] = [title, cellID];
+            }
+            
+            for reference in this->getFormulaReferences(cell) {
+                let refTitle = reference[0] === null ? title : reference[0];
+                let boundaries = \ZExcel\Cell::rangeBoundaries(str_replace("$", "", reference[1]));
+                let firstColumn = min(boundaries[0][0], boundaries[1][0]);
+                let firstRow = min(boundaries[0][1], boundaries[1][1]);
+                let lastColumn = max(boundaries[0][0], boundaries[1][0]);
+                let lastRow = max(boundaries[0][1], boundaries[1][1]);
+                let key = formulaKey . "|" . firstColumn . "," . firstRow . "," . lastColumn . "," . lastRow;
+                
+                if (!isset(this->formulaDependents[refTitle])) {
+                    let this->formulaDependents[refTitle] = new \ZExcel\Calculation\DependencyIndex();
+                }
+                
+                let index = this->formulaDependents[refTitle];
+                
+                if (!index->has(key)) {
+                    index->add(key, firstColumn, firstRow, lastColumn, lastRow, [title, cellID]);
+                    let areas[] = [refTitle, key];
+                }
+            }
+        } catch \ZExcel\Exception, e {
+            //    Without its references, the stored value of the formula can't be trusted
+            let this->staleFormulae[formulaKey] = true;
+        }
+        
+        let this->indexedFormulae[formulaKey] = areas;
+    }
+
+    /**
+     * Remove the areas read by a formula cell from the index
+     *
+     * @param string title
+     * @param string cellID
+     */
+    private function forgetFormulaDependent(string title, string cellID)
+    {
+        var formulaKey, area, index;
+        
+        let formulaKey = title . "!" . cellID;
+        
+        if (!isset(this->indexedFormulae[formulaKey])) {
+            return;
+        }
+        
+        for area in this->indexedFormulae[formulaKey] {
+            let index = this->formulaDependents[area[0]];
+            index->remove(area[1]);
+        }
+        
+        unset(this->indexedFormulae[formulaKey]);
+        unset(this->dynamicFormulae[formulaKey]);
+    }
+
+    /**
+     * Discard cached values, oldest first, until fewer than limit values remain cached
+     *    The values of the worksheet being calculated are discarded last. The areas read by discarded formulae
+     *    are kept, so that a change still reaches the cached formulae reading them.
+     *
+     * @param integer limit
+     * @param string  keepTitle    Title of the worksheet being calculated
+     */
+    private function trimCalculationCache(int limit, var keepTitle = null)
+    {
+        var title, partition, cellID;
+        array titles;
+
+        let titles = array_keys(this->_calculationCache);
+
+        if (keepTitle !== null && isset(this->_calculationCache[keepTitle])) {
+            let titles = array_values(array_diff(titles, [keepTitle]));
+            let titles[] = keepTitle;
+        }
+
+        for title in titles {
+            if (this->calculationCacheCount < limit) {
+                break;
+            }
+
+            let partition = this->_calculationCache[title];
+
+            for cellID, _ in partition {
+                if (this->calculationCacheCount < limit) {
+                    break;
+                }
+
+                unset(partition[cellID]);
+                let this->calculationCacheCount = this->calculationCacheCount - 1;
+            }
+
+            if (empty(partition)) {
+                unset(this->_calculationCache[title]);
+            } else {
+                let this->_calculationCache[title] = partition;
+            }
+        }
+    }
+
+    /**
+     * Note that the formula being calculated reads an area of a worksheet
+     *
+     * @param string sourceTitle    Title of the worksheet that is read from
+     * @param string range          Cell address or range read (e.g. A1 or A1:B10)
+     */
+    private function addCalculationCacheRead(var sourceTitle, var range)
+    {
+        var reader, readerKey, boundaries, key, index;
+        int firstColumn, firstRow, lastColumn, lastRow;
+
+        if (!this->calculationCacheEnabled || empty(this->calculationCacheReaderStack)) {
+            return;
+        }
+
+        let reader = this->calculationCacheReaderStack[count(this->calculationCacheReaderStack) - 1];
+
+        if (reader[1] === null) {
+            return;
+        }
+
+        let readerKey = reader[0] . "!" . reader[1];
+        let boundaries = \ZExcel\Cell::rangeBoundaries(str_replace("$", "", range));
+        let firstColumn = min(boundaries[0][0], boundaries[1][0]);
+        let firstRow = min(boundaries[0][1], boundaries[1][1]);
+        let lastColumn = max(boundaries[0][0], boundaries[1][0]);
+        let lastRow = max(boundaries[0][1], boundaries[1][1]);
+        let key = readerKey . "|" . firstColumn . "," . firstRow . "," . lastColumn . "," . lastRow;
+
+        if (!isset(this->calculationCacheDependents[sourceTitle])) {
+            let this->calculationCacheDependents[sourceTitle] = new \ZExcel\Calculation\DependencyIndex();
+        }
+
+        let index = this->calculationCacheDependents[sourceTitle];
+
+        if (!index->has(key)) {
+            index->add(key, firstColumn, firstRow, lastColumn, lastRow, reader);
+            let this->calculationCacheReads[readerKey][] = [sourceTitle, key];
+        }
+    }
+
+    /**
+     * Discard the cached values of an area of a worksheet, and of the formulae reading from it, directly or
+     *    through other formulae
+     *
+     * @param string title
+     * @param string range    Cell address or range (e.g. A1 or A1:C10)
+     */
+    private function invalidateCalculationCache(var title, var range)
+    {
+        var queue, item, boundaries, cellID, reader, readerKey, read, index, columnLetters;
+        int firstColumn, firstRow, lastColumn, lastRow, column, row, packed;
+        array invalidated = [], cellIDs;
+
+        let queue = [[title, range]];
+
+        if (strpos(range, ":") === false) {
+            let invalidated[title . "!" . range] = true;
+        }
+
+        while (!empty(queue)) {
+            let item = array_pop(queue);
+            let boundaries = \ZExcel\Cell::rangeBoundaries(item[1]);
+            let firstColumn = min(boundaries[0][0], boundaries[1][0]);
+            let firstRow = min(boundaries[0][1], boundaries[1][1]);
+            let lastColumn = max(boundaries[0][0], boundaries[1][0]);
+            let lastRow = max(boundaries[0][1], boundaries[1][1]);
+
+            //    Cached values inside the area
+            if (isset(this->_calculationCache[item[0]])) {
+                if (strpos(item[1], ":") === false) {
+                    if (isset(this->_calculationCache[item[0]][item[1]])) {
+                        unset(this->_calculationCache[item[0]][item[1]]);
+                        let this->calculationCacheCount = this->calculationCacheCount - 1;
+                    }
+                } elseif ((lastColumn - firstColumn + 1) * (lastRow - firstRow + 1) <= count(this->_calculationCache[item[0]])) {
+                    //    Look the cells of the area up
+                    for column in range(firstColumn, lastColumn) {
+                        let columnLetters = \ZExcel\Cell::stringFromColumnIndex(column - 1);
+
+                        for row in range(firstRow, lastRow) {
+                            let cellID = columnLetters . row;
+
+                            if (isset(this->_calculationCache[item[0]][cellID])) {
+                                unset(this->_calculationCache[item[0]][cellID]);
+                                let this->calculationCacheCount = this->calculationCacheCount - 1;
                             }
                         }
                     }
+                } else {
+                    //    Pick the cached cells inside the area, then discard them
+                    let cellIDs = [];
+
+                    for cellID, _ in this->_calculationCache[item[0]] {
+                        let packed = \ZExcel\Cell\Coordinate::parse(cellID);
+                        let column = \ZExcel\Cell\Coordinate::column(packed);
+                        let row = \ZExcel\Cell\Coordinate::row(packed);
+
+                        if (column >= firstColumn && column <= lastColumn && row >= firstRow && row <= lastRow) {
+                            let cellIDs[] = cellID;
+                        }
+                    }
+
+                    if (count(cellIDs) == count(this->_calculationCache[item[0]])) {
+                        unset(this->_calculationCache[item[0]]);
+                    } else {
+                        for cellID in cellIDs {
+                            unset(this->_calculationCache[item[0]][cellID]);
+                        }
+                    }
+
+                    let this->calculationCacheCount = this->calculationCacheCount - count(cellIDs);
+                }
+            }
+
+            //    Formulae reading from the area
+            if (!isset(this->calculationCacheDependents[item[0]])) {
+                continue;
+            }
+
+            let index = this->calculationCacheDependents[item[0]];
+
+            for reader in index->find(firstColumn, firstRow, lastColumn, lastRow) {
+                let readerKey = reader[0] . "!" . reader[1];
+
+                if (!isset(invalidated[readerKey])) {
+                    let invalidated[readerKey] = true;
+                    let queue[] = [reader[0], reader[1]];
                 }
             }
+        }
+
+        //    Invalidated formulae note what they read again when they are next calculated
+        for readerKey, _ in invalidated {
+            if (!isset(this->calculationCacheReads[readerKey])) {
+                continue;
+            }
+
+            for read in this->calculationCacheReads[readerKey] {
+                let index = this->calculationCacheDependents[read[0]];
+                index->remove(read[1]);
+            }
+
+            unset(this->calculationCacheReads[readerKey]);
+        }
+    }
+
+    /**
+     * Get the directory holding the locale files
+     *
+     * @return string
+     */
+    public static function getLocaleFileDirectory() -> string
+    {
+        return self::localeFileDirectory;
+    }
+
+    /**
+     * Set the directory holding the locale files, with a subdirectory for each locale language
+     *    (e.g. fr/functions, fr/config)
+     *
+     * @param string directory  Null for the default directory (PHPExcel/locale)
+     */
+    public static function setLocaleFileDirectory(var directory = null)
+    {
+        if (directory === null) {
+            let directory = "PHPExcel/locale";
+        }
+        
+        let self::localeFileDirectory = rtrim(directory, "/" . DIRECTORY_SEPARATOR);
+        let self::_validLocaleLanguages = ["en"];
+        let self::localeTables = [];
+    }
+
+    /**
+     * Get the currently defined locale code
+     *
+     * @return string
+     */
+    public function getLocale()
+    {
+        return self::_localeLanguage;
+    }
 
-            let self::functionReplaceFromExcel = null;
-            let self::functionReplaceToExcel = null;
-            let self::functionReplaceFromLocale = null;
-            let self::functionReplaceToLocale = null;
+    /**
+     * Set the locale code
+     *
+     * @param string locale  The locale to use for formula translation
+     * @return boolean
+     */
+    public function setLocale(string locale = "en_us")
+    {
+        var language, tables;
+        
+        //    Identify our locale and language
+        let language = strtolower(locale);
+        let locale = language;
+        
+        if (strpos(locale,"_") !== false) {
+            let language = explode("_",locale);
+            let language = language[0];
+        }
+
+        if (count(self::_validLocaleLanguages) == 1) {
+            self::_loadLocales();
+        }
+
+        //    Test whether we have any language data for this language (any locale)
+        if (in_array(language,self::_validLocaleLanguages)) {
+            let tables = self::_loadLocaleTables(locale, language);
+            
+            if (tables === false) {
+                return false;
+            }
+            
+            let self::_localeFunctions = tables["functions"];
+            let self::_localeArgumentSeparator = tables["argumentSeparator"];
+            let self::localeBoolean = tables["boolean"];
+            let self::functionReplaceFromExcel = tables["replaceFromExcel"];
+            let self::functionReplaceToExcel = tables["replaceToExcel"];
+            let self::functionReplaceFromLocale = tables["replaceFromLocale"];
+            let self::functionReplaceToLocale = tables["replaceToLocale"];
+            let self::compiledFormulae = [];
             let self::_localeLanguage = locale;
             
             return true;
@@ -2385,6 +3198,185 @@ class Calculation
         return false;
     }
     
+    /**
+     * Get the parsed tables of a locale
+     *
+     * Tables are parsed once per locale and kept for the rest of the request; when APCu is
+     * available they are also shared across requests, keyed by the absolute paths of the locale
+     * files and their modification times
+     *
+     * @param string locale
+     * @param string language
+     * @return array|boolean Locale tables, or false if there is no function file for the locale
+     */
+    private static function _loadLocaleTables(string locale, string language)
+    {
+        var directory, functionNamesFile, configFile = null, cacheKey, tables = false;
+        
+        if (isset(self::localeTables[locale])) {
+            return self::localeTables[locale];
+        }
+        
+        //    Default is English, if user isn"t requesting english, then read the necessary data from the locale files
+        if (locale == "en_us") {
+            let tables = self::_parseLocaleTables(null, null);
+        } else {
+            let directory = self::localeFileDirectory . DIRECTORY_SEPARATOR;
+            
+            //    Search for a file with a list of function names for locale
+            let functionNamesFile = directory . str_replace("_", DIRECTORY_SEPARATOR, locale) . DIRECTORY_SEPARATOR . "functions";
+            
+            if (!file_exists(functionNamesFile)) {
+                //    If there isn"t a locale specific function file, look for a language specific function file
+                let functionNamesFile = directory . language . DIRECTORY_SEPARATOR . "functions";
+                
+                if (!file_exists(functionNamesFile)) {
+                    return false;
+                }
+            }
+            
+            let configFile = directory . str_replace("_", DIRECTORY_SEPARATOR, locale) . DIRECTORY_SEPARATOR . "config";
+            
+            if (!file_exists(configFile)) {
+                let configFile = directory . language . DIRECTORY_SEPARATOR . "config";
+                
+                if (!file_exists(configFile)) {
+                    let configFile = null;
+                }
+            }
+            
+            //    Absolute paths, so that processes running from other directories share the same entries
+            let functionNamesFile = realpath(functionNamesFile);
+            
+            if (configFile !== null) {
+                let configFile = realpath(configFile);
+            }
+            
+            let cacheKey = "ZExcel.locale." . md5(functionNamesFile . ":" . filemtime(functionNamesFile) . ":" . (configFile === null ? "" : configFile . ":" . filemtime(configFile)));
+            
+            if (function_exists("apcu_fetch")) {
+                let tables = apcu_fetch(cacheKey);
+            }
+            
+            if (!is_array(tables)) {
+                let tables = self::_parseLocaleTables(functionNamesFile, configFile);
+                
+                if (function_exists("apcu_store")) {
+                    apcu_store(cacheKey, tables);
+                }
+            }
+        }
+        
+        let self::localeTables[locale] = tables;
+        
+        return tables;
+    }
+    
+    /**
+     * Parse the function and config files of a locale
+     *
+     * @param string functionNamesFile File with the locale function names, or null for English
+     * @param string configFile        File with the locale settings, or null
+     * @return array
+     */
+    private static function _parseLocaleTables(var functionNamesFile, var configFile) -> array
+    {
+        var localeFunction, localeFunctions, fName, lfName, tmp, localeSettings, localeSetting, settingName, settingValue, tables;
+        
+        let tables = [
+            "functions": [],
+            "argumentSeparator": ",",
+            "boolean": ["TRUE": "TRUE", "FALSE": "FALSE", "NULL": "NULL"]
+        ];
+        
+        if (functionNamesFile !== null) {
+            //    Retrieve the list of locale or language specific function names
+            let localeFunctions = file(functionNamesFile, FILE_IGNORE_NEW_LINES | FILE_SKIP_EMPTY_LINES);
+            
+            for localeFunction in localeFunctions {
+                let localeFunction = explode("##", localeFunction);
+                let localeFunction = localeFunction[0];    //    Strip out comments
+                
+                if (strpos(localeFunction,"=") !== false) {
+                    let tmp = explode("=",localeFunction);
+                    let fName = trim(tmp[0]);
+                    let lfName = trim(tmp[1]);
+                    
+                    if ((isset(self::PHPExcelFunctions[fName])) && (lfName != "") && (fName != lfName)) {
+                        let tables["functions"][fName] = lfName;
+                    }
+                }
+            }
+            //    Default the TRUE and FALSE constants to the locale names of the TRUE() and FALSE() functions
+            if (isset(tables["functions"]["TRUE"])) {
+                let tables["boolean"]["TRUE"] = tables["functions"]["TRUE"];
+            }
+            
+            if (isset(tables["functions"]["FALSE"])) {
+                let tables["boolean"]["FALSE"] = tables["functions"]["FALSE"];
+            }
+        }
+        
+        if (configFile !== null) {
+            let localeSettings = file(configFile, FILE_IGNORE_NEW_LINES | FILE_SKIP_EMPTY_LINES);
+            
+            for localeSetting in localeSettings {
+                let localeSetting = explode("##",localeSetting);    //    Strip out comments
+                let localeSetting = localeSetting[0];
+                
+                if (strpos(localeSetting,"=") !== false) {
+                    let settingName = explode("=", localeSetting);
+                    
+                    let settingValue = settingName[1];
+                    let settingName = strtoupper(trim(settingName[0]));
+                    
+                    switch (settingName) {
+                        case "ARGUMENTSEPARATOR" :
+                            let tables["argumentSeparator"] = trim(settingValue);
+                            break;
+                    }
+                }
+            }
+        }
+        
+        return array_merge(tables, self::_buildLocaleReplacements(tables["functions"], tables["boolean"]));
+    }
+    
+    /**
+     * Build the regular expressions translating function names and booleans between English and a locale
+     *
+     * @param string[] localeFunctions Locale function names, indexed by English function name
+     * @param string[] booleans        Locale booleans, indexed by English constant
+     * @return array
+     */
+    private static function _buildLocaleReplacements(array localeFunctions, array booleans) -> array
+    {
+        var english, localised, replacements;
+        
+        let replacements = [
+            "replaceFromExcel": [],
+            "replaceToExcel": [],
+            "replaceFromLocale": [],
+            "replaceToLocale": []
+        ];
+        
+        for english, localised in localeFunctions {
+            let replacements["replaceFromExcel"][] = "/(@?[^\w\.])" . preg_quote(english) . "([\s]*\()/Ui";
+            let replacements["replaceToLocale"][] = "$1" . trim(localised) . "$2";
+            let replacements["replaceFromLocale"][] = "/(@?[^\w\.])" . preg_quote(localised) . "([\s]*\()/Ui";
+            let replacements["replaceToExcel"][] = "$1" . trim(english) . "$2";
+        }
+        
+        for english, localised in booleans {
+            let replacements["replaceFromExcel"][] = "/(@?[^\w\.])" . preg_quote(english) . "([^\w\.])/Ui";
+            let replacements["replaceToLocale"][] = "$1" . trim(localised) . "$2";
+            let replacements["replaceFromLocale"][] = "/(@?[^\w\.])" . preg_quote(localised) . "([^\w\.])/Ui";
+            let replacements["replaceToExcel"][] = "$1" . trim(english) . "$2";
+        }
+        
+        return replacements;
+    }
+    
     public static function translateSeparator(fromSeparator, toSeparator, formula, inBraces)
     {
         var strln, i, chrr;
@@ -2431,7 +3423,7 @@ class Calculation
                     let i = !i;
                     if (i) {
                         let temp[key] = preg_replace(from, to, value);
-                        let temp[key] = self::translateSeparator(fromSeparator, toSeparator, value, inBraces);
+                        let temp[key] = self::translateSeparator(fromSeparator, toSeparator, temp[key], inBraces);
                     }
                 }
 
@@ -2449,31 +3441,8 @@ class Calculation
     
     public function _translateFormulaToLocale(var formula)
     {
-        var localeVar;
-        
         if (self::functionReplaceFromExcel === null) {
-            let self::functionReplaceFromExcel = [];
-            
-            for localeVar in array_keys(self::_localeFunctions) {
-                let self::functionReplaceFromExcel[] = "/(@?[^\w\.])" . preg_quote(localeVar) . "([\s]*\()/Ui";
-            }
-            
-            for localeVar in array_keys(self::localeBoolean) {
-                let self::functionReplaceFromExcel[] = "/(@?[^\w\.])" . preg_quote(localeVar) . "([^\w\.])/Ui";
-            }
-
-        }
-
-        if (self::functionReplaceToLocale === null) {
-            let self::functionReplaceToLocale = [];
-            
-            for localeVar in array_values(self::_localeFunctions) {
-                let self::functionReplaceToLocale[] = "$1" . trim(localeVar) . "$2";
-            }
-            
-            for localeVar in array_values(self::localeBoolean) {
-                let self::functionReplaceToLocale[] = "$1" . trim(localeVar) . "$2";
-            }
+            self::_setLocaleReplacements();
         }
 
         return self::_translateFormula(self::functionReplaceFromExcel, self::functionReplaceToLocale, formula, ",", self::_localeArgumentSeparator);
@@ -2481,33 +3450,25 @@ class Calculation
     
     public function _translateFormulaToEnglish(var formula)
     {
-        var localeVar;
-        
         if (self::functionReplaceFromLocale === null) {
-            let self::functionReplaceFromLocale = [];
-            
-            for localeVar in array_values(self::_localeFunctions) {
-                let self::functionReplaceFromLocale[] = "/(@?[^\w\.])" . preg_quote(localeVar) . "([\s]*\()/Ui";
-            }
-            for localeVar in array_values(self::localeBoolean) {
-                let self::functionReplaceFromLocale[] = "/(@?[^\w\.])" . preg_quote(localeVar) . "([^\w\.])/Ui";
-            }
-        }
-
-        if (self::functionReplaceToExcel === null) {
-            let self::functionReplaceToExcel = [];
-            
-            for localeVar in array_keys(self::_localeFunctions) {
-                let self::functionReplaceToExcel[] = "$1" . trim(localeVar) . "$2";
-            }
-            for localeVar in array_keys(self::localeBoolean) {
-                let self::functionReplaceToExcel[] = "$1" . trim(localeVar) . "$2";
-            }
+            self::_setLocaleReplacements();
         }
 
         return self::_translateFormula(self::functionReplaceFromLocale, self::functionReplaceToExcel, formula, self::_localeArgumentSeparator,",");
     }
     
+    private static function _setLocaleReplacements()
+    {
+        var replacements;
+        
+        let replacements = self::_buildLocaleReplacements(self::_localeFunctions, self::localeBoolean);
+        
+        let self::functionReplaceFromExcel = replacements["replaceFromExcel"];
+        let self::functionReplaceToExcel = replacements["replaceToExcel"];
+        let self::functionReplaceFromLocale = replacements["replaceFromLocale"];
+        let self::functionReplaceToLocale = replacements["replaceToLocale"];
+    }
+    
     public static function _localeFunc(functionn)
     {
         var functionName, brace;
@@ -2593,7 +3554,7 @@ class Calculation
     
     public function calculateCellValue(<\ZExcel\Cell> pCell = null, var resetLog = false)
     {
-        var returnArrayAsType, result, cellAddress, e, testResult, r, c;
+        var returnArrayAsType, result, cellCollection, cellID, e, testResult, r, c;
         
         if (pCell === null) {
             return null;
@@ -2606,29 +3567,32 @@ class Calculation
             let this->formulaError = null;
             
             this->_cyclicReferenceStack->clear();
+            let this->calculationCacheReaderStack = [];
             let this->cyclicFormulaCount = 1;
 
             let self::returnArrayAsType = self::RETURN_ARRAY_AS_ARRAY;
         }
         
-        //    Execute the calculation for the cell formula
-        let this->cellStack[] = [
-            "sheet": pCell->getWorksheet()->getTitle(),
-            "cell": pCell->getCoordinate()
-        ];
+        //    Pin the cell for the duration of the evaluation: nested evaluations activate other cells
+        //        of the store, and the cell can then be made current again without being reloaded
+        let cellCollection = pCell->getParent();
+        let cellID = pCell->getCoordinate();
         
+        cellCollection->pinCell(cellID);
+        
+        //    Execute the calculation for the cell formula
         try {
-            let result = self::unwrapResult(this->_calculateFormulaValue(pCell->getValue(), pCell->getCoordinate(), pCell));
-            let cellAddress = array_pop(this->cellStack);
-            
-            this->workbook->getSheetByName(cellAddress["sheet"])->getCell(cellAddress["cell"]);
+            let result = self::unwrapResult(this->_calculateFormulaValue(pCell->getValue(), cellID, pCell));
         } catch \ZExcel\Exception, e {
-            let cellAddress = array_pop(this->cellStack);
-            this->workbook->getSheetByName(cellAddress["sheet"])->getCell(cellAddress["cell"]);
+            cellCollection->getCacheData(cellID);
+            cellCollection->unpinCell(cellID);
             
             throw new \ZExcel\Calculation\Exception(e->getMessage());
         }
         
+        cellCollection->getCacheData(cellID);
+        cellCollection->unpinCell(cellID);
+        
         if ((is_array(result)) && (self::returnArrayAsType != self::RETURN_ARRAY_AS_ARRAY)) {
             let self::returnArrayAsType = returnArrayAsType;
             let testResult = \ZExcel\Calculation\Functions::flattenArray(result);
@@ -2718,7 +3682,7 @@ class Calculation
         //    Disable calculation cacheing because it only applies to cell calculations, not straight formulae
         //    But don't actually flush any cache
         let resetCache = this->getCalculationCacheEnabled();
-        let this->_calculationCacheEnabled = false;
+        let this->calculationCacheEnabled = false;
         //    Execute the calculation
         try {
             let result = self::unwrapResult(this->_calculateFormulaValue(formula, cellID, pCell));
@@ -2727,33 +3691,66 @@ class Calculation
         }
 
         //    Reset calculation cacheing to its previous state
-        let this->_calculationCacheEnabled = resetCache;
+        let this->calculationCacheEnabled = resetCache;
 
         return result;
     }
     
-    public function getValueFromCache(var cellReference, var cellValue)
+    /**
+     * Return a value from the calculation cache
+     *
+     * @param    string    worksheetName    Worksheet title
+     * @param    string    cellID           Cell address (e.g. A1)
+     * @return    mixed    The cached value, or false if the cell has no cached value
+     */
+    public function getValueFromCache(var worksheetName, var cellID)
     {
         // Is calculation cacheing enabled?
         // Is the value present in calculation cache?
-        if ((this->calculationCacheEnabled) && (isset(this->_calculationCache[cellReference]))) {
+        if (!this->calculationCacheEnabled) {
+            return false;
+        }
+        
+        if (isset(this->_calculationCache[worksheetName][cellID])) {
             // Return the cached result
-            return this->_calculationCache[cellReference];
+            let this->calculationCacheHits = this->calculationCacheHits + 1;
+            
+            return this->_calculationCache[worksheetName][cellID];
         }
         
+        let this->calculationCacheMisses = this->calculationCacheMisses + 1;
+        
         return false;
     }
     
-    public function saveValueToCache(cellReference, cellValue)
+    /**
+     * Save a value to the calculation cache
+     *
+     * @param    string    worksheetName    Worksheet title
+     * @param    string    cellID           Cell address (e.g. A1)
+     * @param    mixed     cellValue
+     */
+    public function saveValueToCache(var worksheetName, var cellID, var cellValue)
     {
-        if (this->calculationCacheEnabled) {
-            let this->_calculationCache[cellReference] = cellValue;
+        if (!this->calculationCacheEnabled) {
+            return;
+        }
+        
+        if (!isset(this->_calculationCache[worksheetName][cellID])) {
+            if ((this->calculationCacheLimit > 0) && (this->calculationCacheCount >= this->calculationCacheLimit)) {
+                //    Make room for a quarter of the limit at once, rather than one value at a time
+                this->trimCalculationCache(this->calculationCacheLimit - (int) floor(this->calculationCacheLimit / 4), worksheetName);
+            }
+            
+            let this->calculationCacheCount = this->calculationCacheCount + 1;
         }
+        
+        let this->_calculationCache[worksheetName][cellID] = cellValue;
     }
     
     public function _calculateFormulaValue(string formula, var cellID = null, <\ZExcel\Cell> pCell = null)
     {
-        var cellValue = null, pCellParent, wsTitle, wsCellReference, tmp;
+        var cellValue = null, pCellParent, wsTitle, wsCellReference, tmp, program, traceStart = null, readerStack;
 
         //    Basic validation that this is indeed a formula
         //    We simply return the cell value if not
@@ -2781,10 +3778,20 @@ class Calculation
         
         let wsCellReference = wsTitle . "!" . cellID;
         
+        //    Tracing is opt-in, when it is disabled this flag test is all it costs
+        if ((cellID !== null) && (this->_debugLog->getWriteTrace())) {
+            let traceStart = microtime(true);
+        }
+        
         if ((cellID !== null)) {
-            let tmp = this->getValueFromCache(wsCellReference, cellValue);
+            let tmp = this->getValueFromCache(wsTitle, cellID);
             
             if (tmp !== false) {
+                if (traceStart !== null) {
+                    let program = isset(self::compiledFormulae[formula]) ? self::compiledFormulae[formula] : null;
+                    this->_debugLog->writeTraceEvent(wsCellReference, "=" . formula, microtime(true) - traceStart, true, self::countProgramReferences(program));
+                }
+                
                 return tmp;
             }
         }
@@ -2814,93 +3821,27 @@ class Calculation
 
         //    Parse the formula onto the token stack and calculate the value
         this->_cyclicReferenceStack->push(wsCellReference);
-        let cellValue = this->processTokenStack(this->_parseFormula(formula, pCell), cellID, pCell);
+        let this->calculationCacheReaderStack[] = [wsTitle, cellID];
+        let program = this->compileFormula(formula, pCell);
+        let cellValue = this->executeProgram(program, cellID, pCell);
+        let readerStack = this->calculationCacheReaderStack;
+        array_pop(readerStack);
+        let this->calculationCacheReaderStack = readerStack;
         this->_cyclicReferenceStack->pop();
+        
+        if (traceStart !== null) {
+            this->_debugLog->writeTraceEvent(wsCellReference, "=" . formula, microtime(true) - traceStart, false, self::countProgramReferences(program));
+        }
 
         // Save to calculation cache
         if (cellID !== null) {
-            this->saveValueToCache(wsCellReference, cellValue);
+            this->saveValueToCache(wsTitle, cellID, cellValue);
         }
         
         //    Return the calculated value
         return cellValue;
     }
     
-    /**
-     * Ensure that paired matrix operands are both matrices and of the same size
-     *
-     * @param    mixed        &operand1    First matrix operand
-     * @param    mixed        &operand2    Second matrix operand
-     * @param    integer        resize        Flag indicating whether the matrices should be resized to match
-     *                                        and (if so), whether the smaller dimension should grow or the
-     *                                        larger should shrink.
-     *                                            0 = no resize
-     *                                            1 = shrink to fit
-     *                                            2 = extend to fit
-     */
-    private static function checkMatrixOperands(var operand1, var operand2, var resize = 1)
-    {
-        var tmp, matrixRows, matrixColumns, matrix1Rows, matrix1Columns, matrix2Rows, matrix2Columns;
-        
-        //    Examine each of the two operands, and turn them into an array if they aren't one already
-        //    Note that this function should only be called if one or both of the operand is already an array
-        if (!is_array(operand1)) {
-            let tmp = self::getMatrixDimensions(operand2);
-        let operand2 = array_shift(tmp);
-            let matrixRows = tmp[0];
-            let matrixColumns = tmp[1];
-            let operand1 = array_fill(0, matrixRows, array_fill(0, matrixColumns, operand1));
-            let resize = 0;
-        } else {
-            if (!is_array(operand2)) {
-                let tmp = self::getMatrixDimensions(operand1);
-                let operand1 = array_shift(tmp);
-                let matrixRows = tmp[0];
-                let matrixColumns = tmp[1];
-                let operand2 = array_fill(0, matrixRows, array_fill(0, matrixColumns, operand2));
-                let resize = 0;
-            }
-        }
-        
-        let tmp = self::getMatrixDimensions(operand1);
-        let operand1 = array_shift(tmp);
-        let matrix1Rows = tmp[0];
-        let matrix1Columns = tmp[1];
-        
-        let tmp = self::getMatrixDimensions(operand2);
-        let operand2 = array_shift(tmp);
-        let matrix2Rows = tmp[0];
-        let matrix2Columns = tmp[1];
-        
-        if ((matrix1Rows == matrix2Columns) && (matrix2Rows == matrix1Columns)) {
-            let resize = 1;
-        }
-
-        if (resize == 2) {
-            //    Given two matrices of (potentially) unequal size, convert the smaller in each dimension to match the larger
-            let tmp = self::resizeMatricesExtend(operand1, operand2, matrix1Rows, matrix1Columns, matrix2Rows, matrix2Columns);
-            
-            let operand1 = tmp[0];
-            let operand2 = tmp[1];
-        } else {
-            if (resize == 1) {
-                //    Given two matrices of (potentially) unequal size, convert the larger in each dimension to match the smaller
-                let tmp = self::resizeMatricesShrink(operand1, operand2, matrix1Rows, matrix1Columns, matrix2Rows, matrix2Columns);
-                
-                let operand1 = tmp[0];
-                let operand2 = tmp[1];
-            }
-        }
-        
-        return [
-            operand1, // references
-            operand2, // references
-            matrix1Rows,
-            matrix1Columns,
-            matrix2Rows,
-            matrix2Columns
-        ];
-    }
     /**
      * Read the dimensions of a matrix, and re-index it with straight numeric keys starting from row 0, column 0
      *
@@ -2933,113 +3874,6 @@ class Calculation
         ];
     }
     
-    /**
-     * Ensure that paired matrix operands are both matrices of the same size
-     *
-     * @param    mixed        &matrix1        First matrix operand
-     * @param    mixed        &matrix2        Second matrix operand
-     * @param    integer        matrix1Rows    Row size of first matrix operand
-     * @param    integer        matrix1Columns    Column size of first matrix operand
-     * @param    integer        matrix2Rows    Row size of second matrix operand
-     * @param    integer        matrix2Columns    Column size of second matrix operand
-     */
-    private static function resizeMatricesShrink(var matrix1, var matrix2, var matrix1Rows, var matrix1Columns, var matrix2Rows, var matrix2Columns)
-    {
-        var i, j;
-        
-        if ((matrix2Columns < matrix1Columns) || (matrix2Rows < matrix1Rows)) {
-            if (matrix2Rows < matrix1Rows) {
-                for i in range(matrix2Rows, matrix1Rows - 1) {
-                    unset(matrix1[i]);
-                }
-            }
-            if (matrix2Columns < matrix1Columns) {
-                for i in range(0, matrix1Rows - 1) {
-                    for j in range(matrix2Columns, matrix1Columns - 1) {
-                        unset(matrix1[i][j]);
-                    }
-                }
-            }
-        }
-
-        if ((matrix1Columns < matrix2Columns) || (matrix1Rows < matrix2Rows)) {
-            if (matrix1Rows < matrix2Rows) {
-                for i in range(matrix1Rows, matrix2Rows - 1) {
-                    unset(matrix2[i]);
-                }
-            }
-            if (matrix1Columns < matrix2Columns) {
-                for i in range(0, matrix2Rows - 1) {
-                    for j in range(matrix1Columns, matrix2Columns - 1) {
-                        unset(matrix2[i][j]);
-                    }
-                }
-            }
-        }
-        
-        return [
-            matrix1,
-            matrix2
-        ];
-    }
-    
-    /**
-     * Ensure that paired matrix operands are both matrices of the same size
-     *
-     * @param    mixed        &matrix1    First matrix operand
-     * @param    mixed        &matrix2    Second matrix operand
-     * @param    integer        matrix1Rows    Row size of first matrix operand
-     * @param    integer        matrix1Columns    Column size of first matrix operand
-     * @param    integer        matrix2Rows    Row size of second matrix operand
-     * @param    integer        matrix2Columns    Column size of second matrix operand
-     */
-    private static function resizeMatricesExtend(var matrix1, var matrix2, var matrix1Rows, var matrix1Columns, var matrix2Rows, var matrix2Columns)
-    {
-        var i, j, x;
-        
-        if ((matrix2Columns < matrix1Columns) || (matrix2Rows < matrix1Rows)) {
-            if (matrix2Columns < matrix1Columns) {
-                for i in range(0, matrix2Rows - 1) {
-                    let x = matrix2[i][matrix2Columns - 1];
-                    
-                    for j in range(matrix2Columns, matrix1Columns - 1) {
-                        let matrix2[i][j] = x;
-                    }
-                }
-            }
-            if (matrix2Rows < matrix1Rows) {
-                let x = matrix2[matrix2Rows - 1];
-                
-                for i in range(0, matrix1Rows - 1) {
-                    let matrix2[i] = x;
-                }
-            }
-        }
-
-        if ((matrix1Columns < matrix2Columns) || (matrix1Rows < matrix2Rows)) {
-            
-            if (matrix1Columns < matrix2Columns) {
-                for i in range(0, matrix1Rows - 1) {
-                    let x = matrix1[i][matrix1Columns - 1];
-                    
-                    for j in range(matrix1Columns, matrix2Columns - 1) {
-                        let matrix1[i][j] = x;
-                    }
-                }
-            }
-            
-            if (matrix1Rows < matrix2Rows) {
-                let x = matrix1[matrix1Rows - 1];
-                
-                for i in range(0, matrix2Rows - 1) {
-                    let matrix1[i] = x;
-                }
-            }
-        }
-        
-        return [matrix1, matrix2];
-    }
-    
     /**
      * Format details of an operand for display in the log (based on operand type)
      *
@@ -3209,6 +4043,7 @@ class Calculation
         //    If we're using cell caching, then pCell may well be flushed back to the cache (which detaches the parent worksheet),
         //        so we store the parent worksheet so that we can re-attach it when necessary
         let pCellParent = (pCell !== null) ? pCell->getWorksheet() : null;
+        let this->parseUsesCellContext = false;
 
         let regexpMatchString = "/^(" . self::CALCULATION_REGEXP_FUNCTION .
                                 "|" . self::CALCULATION_REGEXP_CELLREF .
@@ -3498,12 +4333,14 @@ class Calculation
                             if ((is_integer(startRowColRef)) && (ctype_digit(val)) && (startRowColRef <= 1048576) && (val <= 1048576)) {
                                 //    Row range
                                 let endRowColRef = (pCellParent !== null) ? pCellParent->getHighestColumn() : "XFD";    //    Max 16,384 columns for Excel2007
+                                let this->parseUsesCellContext = true;
                                 let output[count(output) - 1]["value"] = rangeWS1."A".startRowColRef;
                                 let val = rangeWS2.endRowColRef.val;
                             } else {
                                 if ((ctype_alpha(startRowColRef)) && (ctype_alpha(val)) && (strlen(startRowColRef) <= 3) && (strlen(val) <= 3)) {
                                     //    Column range
                                     let endRowColRef = (pCellParent !== null) ? pCellParent->getHighestRow() : 1048576;        //    Max 1,048,576 rows for Excel2007
+                                    let this->parseUsesCellContext = true;
                                     let output[count(output) - 1]["value"] = rangeWS1.strtoupper(startRowColRef)."1";
                                     let val = rangeWS2 . val . endRowColRef;
                                 }
@@ -3611,51 +4448,308 @@ class Calculation
             }
         }
         
-        let op = stack->pop();
+        let op = stack->pop();
+        
+        while (op !== null) {    // pop everything off the stack and push onto output
+            if ((is_array(op) && op["value"] == "(") || (op === "(")) {
+                return this->raiseFormulaError("Formula Error: Expecting ')'");    // if there are any opening braces on the stack, then braces were unbalanced
+            }
+            
+            let output[] = op;
+            let op = stack->pop();
+        }
+        
+        return output;
+    }
+    
+    private static function dataTestReference(operandData)
+    {
+        var operand, rKeys, rowKey, cKeys, colKey;
+        
+        let operand = operandData["value"];
+        
+        if ((operandData["reference"] === null) && (is_array(operand))) {
+            let rKeys = array_keys(operand);
+            let rowKey = array_shift(rKeys);
+            let cKeys = array_keys(array_keys(operand[rowKey]));
+            let colKey = array_shift(cKeys);
+            
+            if (ctype_upper(colKey)) {
+                let operandData["reference"] = colKey . rowKey;
+            }
+        }
+        
+        return [operandData, operand];
+    }
+    
+    /**
+     * Compile a formula into bytecode, reusing the program if the formula has been compiled before
+     *
+     * @param    string            formula    Formula to compile (without the leading =)
+     * @param    \ZExcel\Cell    pCell      Cell the formula belongs to
+     * @return    array|boolean
+     */
+    private function compileFormula(string formula, <\ZExcel\Cell> pCell = null)
+    {
+        var tokens, program;
+        
+        if (isset(self::compiledFormulae[formula])) {
+            return self::compiledFormulae[formula];
+        }
+        
+        let tokens = this->_parseFormula(formula, pCell);
+        
+        if (tokens == false) {
+            return false;
+        }
+        
+        let program = this->compileTokens(tokens);
+        
+        //    Row and column ranges (e.g. A:C) are bounded by the extent of the worksheet, so the program can't be shared
+        if (!this->parseUsesCellContext) {
+            if (count(self::compiledFormulae) >= self::COMPILED_FORMULAE_LIMIT) {
+                let self::compiledFormulae = [];
+            }
+            
+            let self::compiledFormulae[formula] = program;
+        }
+        
+        return program;
+    }
+    
+    /**
+     * Translate the postfix token stack built by _parseFormula() into bytecode
+     *
+     * Each instruction is an array whose first entry is one of the OPCODE_* constants:
+     *     [OPCODE_VALUE, value]
+     *     [OPCODE_CONSTANT, value]
+     *     [OPCODE_BINARY, operator]
+     *     [OPCODE_UNARY, multiplier]
+     *     [OPCODE_CELL, cell address, worksheet title or null, external workbook flag]
+     *     [OPCODE_CALL, function name, argument count, function handler]
+     *     [OPCODE_NAMED_RANGE, name]
+     *     [OPCODE_ERROR, message]
+     *
+     * @param    array    tokens    Token stack
+     * @return    array
+     */
+    private function compileTokens(array tokens) -> array
+    {
+        var tokenData, token, argCount = 0, sheetName, functionName;
+        array program = [], matches = [];
+        
+        for tokenData in tokens {
+            let token = tokenData["value"];
+            
+            if (isset(self::binaryOperators[token])) {
+                let program[] = [self::OPCODE_BINARY, token];
+            } elseif (token === "~") {
+                let program[] = [self::OPCODE_UNARY, -1];
+            } elseif (token === "%") {
+                let program[] = [self::OPCODE_UNARY, 0.01];
+            } elseif (substr(tokenData["type"], 0, 13) == "Operand Count") {
+                //    The argument count is folded into the function call that follows it
+                let argCount = token;
+            } elseif (preg_match("/^" . self::CALCULATION_REGEXP_CELLREF . "$/i", token, matches)) {
+                let sheetName = null;
+                
+                if (strlen(matches[2]) > 0) {
+                    let sheetName = trim(matches[2], "\"\"");
+                }
+                
+                let program[] = [
+                    self::OPCODE_CELL,
+                    matches[6] . matches[7],
+                    sheetName,
+                    (sheetName !== null) && ((strpos(sheetName, "[") !== false) || (strpos(sheetName, "]") !== false))
+                ];
+            } elseif (preg_match("/^" . self::CALCULATION_REGEXP_FUNCTION . "$/i", token, matches)) {
+                let functionName = matches[1];
+                
+                if ((isset(self::PHPExcelFunctions[functionName])) || (isset(self::controlFunctions[functionName]))) {
+                    let program[] = [self::OPCODE_CALL, functionName, (int) argCount, self::resolveFunction(functionName)];
+                }
+                
+                let argCount = 0;
+            } elseif (isset(self::excelConstants[strtoupper(token)])) {
+                let program[] = [self::OPCODE_CONSTANT, self::excelConstants[strtoupper(token)]];
+            } elseif ((is_numeric(token)) || (token === null) || (is_bool(token)) || (token == "") || (substr(token, 0, 1) == "\"") || (substr(token, 0, 1) == "#")) {
+                let program[] = [self::OPCODE_VALUE, token];
+            } elseif (preg_match("/^" . self::CALCULATION_REGEXP_NAMEDRANGE . "$/i", token, matches)) {
+                let program[] = [self::OPCODE_NAMED_RANGE, matches[6]];
+            } else {
+                let program[] = [self::OPCODE_ERROR, "undefined variable \"token\""];
+            }
+        }
+        
+        return program;
+    }
+    
+    /**
+     * List the cell and range references of a formula cell
+     *
+     * Named ranges are not resolved, and references to external workbooks are skipped
+     *
+     * @param    \ZExcel\Cell    pCell    Formula cell
+     * @return    array    References, each as [worksheet title or null for the worksheet of the cell, cell or range]
+     */
+    public function getFormulaReferences(<\ZExcel\Cell> pCell) -> array
+    {
+        var formula, program, instruction, first, last;
+        int position;
+        array references = [];
         
-        while (op !== null) {    // pop everything off the stack and push onto output
-            if ((is_array(op) && op["value"] == "(") || (op === "(")) {
-                return this->raiseFormulaError("Formula Error: Expecting ')'");    // if there are any opening braces on the stack, then braces were unbalanced
+        let formula = trim(pCell->getValue());
+        
+        if (substr(formula, 0, 1) != "=") {
+            return [];
+        }
+        
+        let formula = ltrim(substr(formula, 1));
+        
+        if (strlen(formula) === 0) {
+            return [];
+        }
+        
+        let program = this->compileFormula(formula, pCell);
+        
+        if (!is_array(program)) {
+            return [];
+        }
+        
+        for position, instruction in program {
+            if ((instruction[0] == self::OPCODE_CELL) && !instruction[3]) {
+                let references[] = [instruction[2], instruction[1]];
+            } elseif ((instruction[0] == self::OPCODE_BINARY) && (instruction[1] === ":") && (position >= 2)
+                    && (program[position - 2][0] == self::OPCODE_CELL) && !program[position - 2][3]
+                    && (program[position - 1][0] == self::OPCODE_CELL) && !program[position - 1][3]) {
+                //    Both ends of the range were listed as cells: merge them into the range
+                let last = array_pop(references);
+                let first = array_pop(references);
+                let references[] = [first[0] !== null ? first[0] : last[0], first[1] . ":" . last[1]];
             }
-            
-            let output[] = op;
-            let op = stack->pop();
         }
         
-        return output;
+        return references;
     }
     
-    private static function dataTestReference(operandData)
+    /**
+     * Does a formula cell read cells that getFormulaReferences() can't list?
+     *
+     * True when the formula calls a volatile function, INDIRECT or OFFSET, or reads a named range
+     *
+     * @param    \ZExcel\Cell    pCell    Formula cell
+     * @return    boolean
+     */
+    private function hasDynamicReferences(<\ZExcel\Cell> pCell) -> boolean
     {
-        var operand, rKeys, rowKey, cKeys, colKey;
+        var formula, program, instruction;
         
-        let operand = operandData["value"];
+        let formula = ltrim(substr(trim(pCell->getValue()), 1));
         
-        if ((operandData["reference"] === null) && (is_array(operand))) {
-            let rKeys = array_keys(operand);
-            let rowKey = array_shift(rKeys);
-            let cKeys = array_keys(array_keys(operand[rowKey]));
-            let colKey = array_shift(cKeys);
+        if (strlen(formula) === 0) {
+            return false;
+        }
+        
+        let program = this->compileFormula(formula, pCell);
+        
+        if (!is_array(program)) {
+            return false;
+        }
+        
+        for instruction in program {
+            if (instruction[0] == self::OPCODE_NAMED_RANGE) {
+                return true;
+            }
             
-            if (ctype_upper(colKey)) {
-                let operandData["reference"] = colKey . rowKey;
+            if ((instruction[0] == self::OPCODE_CALL) && isset(self::dynamicFunctions[strtoupper(instruction[1])])) {
+                return true;
             }
         }
         
-        return [operandData, operand];
+        return false;
+    }
+    
+    /**
+     * Count the cell, range and named range references in a compiled formula
+     *
+     * @param    array    program    Bytecode, as returned by compileTokens()
+     * @return    integer|null
+     */
+    private static function countProgramReferences(var program)
+    {
+        var instruction;
+        int references = 0;
+        
+        if (!is_array(program)) {
+            return null;
+        }
+        
+        for instruction in program {
+            if ((instruction[0] == self::OPCODE_CELL) || (instruction[0] == self::OPCODE_NAMED_RANGE)) {
+                let references++;
+            } elseif ((instruction[0] == self::OPCODE_BINARY) && (instruction[1] === ":")) {
+                //    Both ends of a range were counted, the range itself is a single reference
+                let references--;
+            }
+        }
+        
+        return references;
+    }
+    
+    /**
+     * Resolve the handler for a function once, so that calls don't need to look it up again
+     *
+     * @param    string    functionName    Function name (e.g. SUM)
+     * @return    array
+     */
+    private static function resolveFunction(string functionName) -> array
+    {
+        var definition, functionCall, handler;
+        
+        if (isset(self::functionHandlers[functionName])) {
+            return self::functionHandlers[functionName];
+        }
+        
+        if (isset(self::PHPExcelFunctions[functionName])) {
+            let definition = self::PHPExcelFunctions[functionName];
+        } else {
+            let definition = self::controlFunctions[functionName];
+        }
+        
+        let functionCall = definition["functionCall"];
+        
+        let handler = [
+            "callable": functionCall,
+            "flatten": true,
+            "matrix": functionName == "MKMATRIX",
+            "passByReference": isset(definition["passByReference"]),
+            "byReference": isset(definition["passByReference"]) ? definition["passByReference"] : [],
+            "passCellReference": isset(definition["passCellReference"])
+        ];
+        
+        //    Class methods receive their arguments as given, PHP functions get them flattened to single values
+        if (strpos(functionCall, "::") !== false) {
+            let handler["callable"] = explode("::", functionCall);
+            let handler["flatten"] = false;
+        }
+        
+        let self::functionHandlers[functionName] = handler;
+        
+        return handler;
     }
     
-    private function processTokenStack(var tokens, var cellID = null, <\ZExcel\Cell> pCell = null)
+    private function executeProgram(var program, var cellID = null, <\ZExcel\Cell> pCell = null)
     {
-        var pCellWorksheet, pCellParent, stack, token, tokenData, multiplier,
-            operand1, operand2, operand1Data, operand2Data, data, namedRange,
-            sheet1, sheet2, tmp, oData, oDatum, oCR, row, col, excelConstant,
+        var pCellWorksheet, pCellParent, stack, instruction, opcode, token, multiplier,
+            operand1, operand2, operand1Data, operand2Data, data,
+            sheet1, sheet2, tmp, oData, oDatum, oCR, row, col,
             cellRef, cellValue, rowIntersect, cellIntersect, cellSheet, output,
-            functionName, functionCall, passByReference, passCellReference,
-            matrix, matrix1, matrixResult, result, args, argCount, argArrayVals, arg, ex, a, i;
-        array matches = [], oCol, oRow;
+            handler, byReference, argCount, argData, args, arg, a,
+            result;
+        array oCol, oRow;
         
-        if (tokens == false) {
+        if (program === false) {
             return false;
         }
 
@@ -3665,14 +4759,101 @@ class Calculation
         let pCellParent = (pCell !== null) ? pCell->getParent() : null;
         let stack = new \ZExcel\Calculation\Token\Stack();
 
-        //    Loop through each token in turn
-        for tokenData in tokens {
-            
-            let token = tokenData["value"];
+        //    Loop through each instruction in turn
+        for instruction in program {
+            let opcode = instruction[0];
             
-            // if the token is a binary operator, pop the top two values off the stack, do the operation, and push the result back on the stack
-            if (isset(self::binaryOperators[token])) {
+            if (opcode == self::OPCODE_VALUE) {
+                stack->push("Value", instruction[1]);
+            } elseif (opcode == self::OPCODE_CELL) {
+                let cellRef = instruction[1];
+                
+                if (pCell === null) {
+                    stack->push("Value", \ZExcel\Calculation\Functions::ReF(), null);
+                    continue;
+                }
+                
+                if (instruction[3]) {
+                    //    It"s a Reference to an external workbook (not currently supported)
+                    return this->raiseFormulaError("Unable to access External Workbook");
+                }
+                
+                if (instruction[2] !== null) {
+                    if (pCellParent === null) {
+                        return this->raiseFormulaError("Unable to access Cell Reference");
+                    }
+                    
+                    let cellSheet = this->workbook->getSheetByName(instruction[2]);
+                    this->addCalculationCacheRead(instruction[2], cellRef);
+                    
+                    if (cellSheet && cellSheet->cellExists(cellRef)) {
+                        let cellValue = this->extractCellRange(cellRef, cellSheet, false);
+                        
+                        let cellRef = array_shift(cellValue);
+                        let cellValue = array_shift(cellValue);
+                        
+                        pCell->attach(pCellParent);
+                    } else {
+                        let cellValue = null;
+                    }
+                } else {
+                    this->addCalculationCacheRead(pCellWorksheet->getTitle(), cellRef);
+                    
+                    if (pCellParent->isDataSet(cellRef)) {
+                        let cellValue = this->extractCellRange(cellRef, pCellWorksheet, false);
+                        
+                        let cellRef = array_shift(cellValue);
+                        let cellValue = array_shift(cellValue);
+                        
+                        pCell->attach(pCellParent);
+                    } else {
+                        let cellValue = null;
+                    }
+                }
+                
+                stack->push("Value", cellValue, cellRef);
+            } elseif (opcode == self::OPCODE_CALL) {
+                //    Pop the arguments off the stack, hand them to the function, and push the result back on
+                let argCount = instruction[2];
+                let handler = instruction[3];
+                let args = [];
+                
+                if (argCount > 0) {
+                    let argData = stack->popMany(argCount);
+                    let byReference = handler["byReference"];
+                    
+                    for a, arg in argData {
+                        if (isset(byReference[a]) && byReference[a]) {
+                            if (arg["reference"] === null) {
+                                let args[] = cellID;
+                            } else {
+                                let args[] = arg["reference"];
+                            }
+                        } elseif (handler["flatten"]) {
+                            let args[] = \ZExcel\Calculation\Functions::flattenSingleValue(self::unwrapResult(arg["value"]));
+                        } else {
+                            let args[] = self::unwrapResult(arg["value"]);
+                        }
+                    }
+                } elseif (handler["passByReference"]) {
+                    let args[] = cellID;
+                }
+                
+                if (handler["matrix"]) {
+                    let result = args;
+                } else {
+                    if (handler["passCellReference"]) {
+                        let args[] = pCell;
+                    }
+                    
+                    let result = call_user_func_array(handler["callable"], args);
+                }
+                
+                stack->push("Value", self::wrapResult(result));
+            } elseif (opcode == self::OPCODE_BINARY) {
+                let token = instruction[1];
                 
+                // pop the top two values off the stack, do the operation, and push the result back on the stack
                 //    We must have two operands, error if we don"t
                 let operand2Data = stack->pop();
                 
@@ -3778,19 +4959,19 @@ class Calculation
                         }
                         break;
                     case "+":            //    Addition
-                        this->executeNumericBinaryOperation(cellID, operand1, operand2, token, "plusEquals", stack);
+                        this->executeNumericBinaryOperation(cellID, operand1, operand2, token, stack);
                         break;
                     case "-":            //    Subtraction
-                        this->executeNumericBinaryOperation(cellID, operand1, operand2, token, "minusEquals", stack);
+                        this->executeNumericBinaryOperation(cellID, operand1, operand2, token, stack);
                         break;
                     case "*":            //    Multiplication
-                        this->executeNumericBinaryOperation(cellID, operand1, operand2, token, "arrayTimesEquals", stack);
+                        this->executeNumericBinaryOperation(cellID, operand1, operand2, token, stack);
                         break;
                     case "/":            //    Division
-                        this->executeNumericBinaryOperation(cellID, operand1, operand2, token, "arrayRightDivide", stack);
+                        this->executeNumericBinaryOperation(cellID, operand1, operand2, token, stack);
                         break;
                     case "^":            //    Exponential
-                        this->executeNumericBinaryOperation(cellID, operand1, operand2, token, "power", stack);
+                        this->executeNumericBinaryOperation(cellID, operand1, operand2, token, stack);
                         break;
                     case "&":            //    Concatenation
                         //    If either of the operands is a matrix, we need to treat them both as matrices
@@ -3805,23 +4986,9 @@ class Calculation
                         }
                         
                         if ((is_array(operand1)) || (is_array(operand2))) {
-                            //    Ensure that both operands are arrays/matrices
-                            let tmp = self::checkMatrixOperands(operand1, operand2, 2);
-                            
-                            let operand1 = array_shift(tmp);
-                            let operand2 = array_shift(tmp);
-                            
-                            try {
-                                //    Convert operand 1 from a PHP array to a matrix
-                                let matrix = new \ZExcel\Shared\JAMA\Matrix();
-                                call_user_func([matrix, "initialize"], operand1);
-                                
-                                //    Perform the required operation against the operand 1 matrix, passing in operand 2
-                                let matrixResult = call_user_func([matrix, "concat"], operand2);
-                                let result = matrixResult->getArray();
-                            } catch \ZExcel\Exception, ex {
-                                let result = "#VALUE!";
-                            }
+                            //    Ensure that both operands are arrays of the same size
+                            let tmp = \ZExcel\Calculation\DenseArray::broadcast(operand1, operand2, 2);
+                            let result = tmp[0]->concat(tmp[1])->toArray();
                         } else {
                             let result = "\"" . str_replace("\"\"", "\"", self::unwrapResult(operand1, "\"") . self::unwrapResult(operand2, "\"")) . "\"";
                         }
@@ -3848,246 +5015,40 @@ class Calculation
                         stack->push("Value", cellIntersect, cellRef);
                         break;
                 }
-
-            // if the token is a unary operator, pop one value off the stack, do the operation, and push it back on
-            } else {
-                if ((token === "~") || (token === "%")) {
-                    let arg = stack->pop();
-                    
-                    if (arg === null) {
-                        return this->raiseFormulaError("Internal error - Operand value missing from stack");
-                    }
-                    
-                    let arg = arg["value"];
-                    
-                    if (token === "~") {
-                        let multiplier = -1;
-                    } else {
-                        let multiplier = 0.01;
-                    }
-                    
-                    if (is_array(arg)) {
-                        let tmp = self::checkMatrixOperands(arg, multiplier, 2);
-                        
-                                let arg = array_shift(tmp);
-                                let multiplier = array_shift(tmp);
-                        
-                        try {
-                            let matrix1 = new \ZExcel\Shared\JAMA\Matrix();
-                            call_user_func([matrix1, "initialize"], arg);
-                            
-                            let matrixResult = call_user_func([matrix1, "arrayTimesEquals"], multiplier);
-                            let result = matrixResult->getArray();
-                        } catch \ZExcel\Exception, ex {
-                            this->_debugLog->writeDebugLog("JAMA Matrix Exception: ", ex->getMessage());
-                            let result = "#VALUE!";
-                        }
-                        
-                        stack->push("Value", result);
-                    } else {
-                        this->executeNumericBinaryOperation(cellID, multiplier, arg, "*", "arrayTimesEquals", stack);
-                    }
+            } elseif (opcode == self::OPCODE_UNARY) {
+                // pop one value off the stack, do the operation, and push it back on
+                let arg = stack->pop();
+                
+                if (arg === null) {
+                    return this->raiseFormulaError("Internal error - Operand value missing from stack");
+                }
+                
+                let arg = arg["value"];
+                let multiplier = instruction[1];
+                
+                if (is_array(arg)) {
+                    let tmp = \ZExcel\Calculation\DenseArray::broadcast(arg, multiplier, 2);
                     
+                    stack->push("Value", tmp[0]->arithmetic(tmp[1], "*")->toArray());
                 } else {
-                    let tmp = preg_match("/^" . self::CALCULATION_REGEXP_CELLREF . "$/i", token, matches);
-                    
-                    if (tmp === 1) {
-                        let cellRef = null;
-                        
-                        if (isset(matches[8])) {
-                            if (pCell === null) {
-                                let cellValue = \ZExcel\Calculation\Functions::ReF();
-                            } else {
-                                let cellRef = matches[6] . matches[7] . ":" . matches[9] . matches[10];
-                                
-                                if (strlen(matches[2]) > 0) {
-                                    let matches[2] = trim(matches[2], "\"\"");
-                                    
-                                    if ((strpos(matches[2], "[") !== false) || (strpos(matches[2], "]") !== false)) {
-                                        return this->raiseFormulaError("Unable to access External Workbook");
-                                    }
-                                    
-                                    let matches[2] = trim(matches[2], "\"\"");
-                                    
-                                    if (pCellParent !== null) {
-                                        let cellValue = this->extractCellRange(cellRef, this->workbook->getSheetByName(matches[2]), false);
-                                        
-		                                let cellRef = array_shift(cellValue);
-		                                let cellValue = array_shift(cellValue);
-                                    } else {
-                                        return this->raiseFormulaError("Unable to access Cell Reference");
-                                    }
-                                } else {
-                                    if (pCellParent !== null) {
-                                        let cellValue = this->extractCellRange(cellRef, pCellWorksheet, false);
-                                        
-                                        let cellRef = array_shift(cellValue);
-                                        let cellValue = array_shift(cellValue);
-                                    } else {
-                                        return this->raiseFormulaError("Unable to access Cell Reference");
-                                    }
-                                }
-                            }
-                        } else {
-                            if (pCell === null) {
-                                let cellValue = \ZExcel\Calculation\Functions::ReF();
-                            } else {
-                                let cellRef = matches[6] . matches[7];
-                                
-                                if (strlen(matches[2]) > 0) {
-                                    let matches[2] = trim(matches[2], "\"\"");
-                                    
-                                    if ((strpos(matches[2], "[") !== false) || (strpos(matches[2], "]") !== false)) {
-                                        //    It"s a Reference to an external workbook (not currently supported)
-                                        return this->raiseFormulaError("Unable to access External Workbook");
-                                    }
-                                    
-                                    if (pCellParent !== null) {
-                                        let cellSheet = this->workbook->getSheetByName(matches[2]);
-                                        
-                                        if (cellSheet && cellSheet->cellExists(cellRef)) {
-                                            let cellValue = this->extractCellRange(cellRef, this->workbook->getSheetByName(matches[2]), false);
-                                            
-	                                        let cellRef = array_shift(cellValue);
-	                                        let cellValue = array_shift(cellValue);
-	                                        
-                                            pCell->attach(pCellParent);
-                                        } else {
-                                            let cellValue = null;
-                                        }
-                                    } else {
-                                        return this->raiseFormulaError("Unable to access Cell Reference");
-                                    }
-                                } else {
-                                    if (pCellParent->isDataSet(cellRef)) {
-                                        let cellValue = this->extractCellRange(cellRef, pCellWorksheet, false);
-                                        
-                                        let cellRef = array_shift(cellValue);
-                                        let cellValue = array_shift(cellValue);
-                                        
-                                        pCell->attach(pCellParent);
-                                    } else {
-                                        let cellValue = null;
-                                    }
-                                }
-                            }
-                        }
-                        stack->push("Value", cellValue, cellRef);
-                        
-                    // if the token is a function, pop arguments off the stack, hand them to the function, and push the result back on
-                    } else {
-                        let tmp = preg_match("/^" . self::CALCULATION_REGEXP_FUNCTION . "$/i", token, matches);
-                        
-                        if (tmp === 1) {
-                            let functionName = matches[1];
-                            let argCount = stack->pop();
-                            let argCount = argCount["value"];
-                            
-                            if ((isset(self::PHPExcelFunctions[functionName])) || (isset(self::controlFunctions[functionName]))) {    // function
-                                
-                                if (isset(self::PHPExcelFunctions[functionName])) {
-                                    let functionCall = self::PHPExcelFunctions[functionName]["functionCall"];
-                                    let passByReference = isset(self::PHPExcelFunctions[functionName]["passByReference"]);
-                                    let passCellReference = isset(self::PHPExcelFunctions[functionName]["passCellReference"]);
-                                } else {
-                                    if (isset(self::controlFunctions[functionName])) {
-                                        let functionCall = self::controlFunctions[functionName]["functionCall"];
-                                        let passByReference = isset(self::controlFunctions[functionName]["passByReference"]);
-                                        let passCellReference = isset(self::controlFunctions[functionName]["passCellReference"]);
-                                    }
-                                }
-                                
-                                // get the arguments for this function
-                                let args = [];
-                                let argArrayVals = [];
-                                
-                                for i in range(0, argCount - 1) {
-                                    let arg = stack->pop();
-                                    let a = argCount - i - 1;
-                                    
-                                    if (passByReference && isset(self::PHPExcelFunctions[functionName]["passByReference"][a]) && self::PHPExcelFunctions[functionName]["passByReference"][a]) {
-                                        if (arg["reference"] === null) {
-                                            let args[] = cellID;
-                                            
-                                            if (functionName != "MKMATRIX") {
-                                                let argArrayVals[] = this->showValue(cellID);
-                                            }
-                                        } else {
-                                            let args[] = arg["reference"];
-                                            
-                                            if (functionName != "MKMATRIX") {
-                                                let argArrayVals[] = this->showValue(arg["reference"]);
-                                            }
-                                        }
-                                    } else {
-                                        let args[] = self::unwrapResult(arg["value"]);
-                                        
-                                        if (functionName != "MKMATRIX") {
-                                            let argArrayVals[] = this->showValue(arg["value"]);
-                                        }
-                                    }
-                                }
-                                
-                                // Reverse the order of the arguments
-                                krsort(args);
-                                
-                                if (passByReference && argCount == 0) {
-                                    let args[] = cellID;
-                                    let argArrayVals[] = this->showValue(cellID);
-                                }
-                                
-                                if (functionName != "MKMATRIX") {
-                                    if (this->_debugLog->getWriteDebugLog()) {
-                                        krsort(argArrayVals);
-                                    }
-                                }
-                                
-                                //    Process the argument with the appropriate function call
-                                if (passCellReference) {
-                                    let args[] = pCell;
-                                }
-                                
-                                if (strpos(functionCall, "::") !== false) {
-                                    let result = call_user_func_array(explode("::", functionCall), args);
-                                } else {
-                                    for arg, _ in args {
-                                        let args[arg] = \ZExcel\Calculation\Functions::flattenSingleValue(arg);
-                                    }
-                                    
-                                    let result = call_user_func_array(functionCall, args);
-                                }
-                                
-                                stack->push("Value", self::wrapResult(result));
-                            }
-                            
-                        } else {
-                            // if the token is a number, boolean, string or an Excel error, push it onto the stack
-                            if (isset(self::excelConstants[strtoupper(token)])) {
-                                let excelConstant = strtoupper(token);
-                                stack->push("Constant Value", self::excelConstants[excelConstant]);
-                            } else {
-                                if ((is_numeric(token)) || (token === null) || (is_bool(token)) || (token == "") || (substr(token, 0, 1) == "\"") || (substr(token, 0, 1) == "#")) {
-                                    stack->push("Value", token);
-                                // if the token is a named range, push the named range name onto the stack
-                                } else {
-                                    if (preg_match("/^" . self::CALCULATION_REGEXP_NAMEDRANGE . "$/i", token, matches)) {
-                                        let namedRange = matches[6];
-                                        let cellValue = this->extractNamedRange(namedRange, ((null !== pCell) ? pCellWorksheet : null), false);
-                                        
-                                        pCell->attach(pCellParent);
-                                        stack->push("Named Range", cellValue, namedRange);
-                                    } else {
-                                        return this->raiseFormulaError("undefined variable \"token\"");
-                                    }
-                                }
-                            }
-                        }
-                    }
+                    this->executeNumericBinaryOperation(cellID, multiplier, arg, "*", stack);
                 }
+            } elseif (opcode == self::OPCODE_CONSTANT) {
+                stack->push("Constant Value", instruction[1]);
+            } elseif (opcode == self::OPCODE_NAMED_RANGE) {
+                let cellValue = this->extractNamedRange(instruction[1], pCellWorksheet, false);
+                
+                if (pCell !== null) {
+                    pCell->attach(pCellParent);
+                }
+                
+                stack->push("Named Range", cellValue, instruction[1]);
+            } else {
+                return this->raiseFormulaError(instruction[1]);
             }
         }
         
-        // when we"re out of tokens, the stack should have a single element, the final result
+        // when we"re out of instructions, the stack should have a single element, the final result
         if (stack->count() != 1) {
             return this->raiseFormulaError("internal error");
         }
@@ -4137,19 +5098,27 @@ class Calculation
         return operand;
     }
     
-    private function executeBinaryComparisonOperation(cellID, operand1, operand2, operation, stack, recursingArrays = false)
-    {
-        throw new \Exception("Not implemented yet!");
-    }
-    
-    private function strcmpLowercaseFirst(str1, str2)
+    private function executeBinaryComparisonOperation(var cellID, var operand1, var operand2, string operation, var stack)
     {
-        throw new \Exception("Not implemented yet!");
+        var tmp;
+        
+        //    If we're dealing with matrix operations, we want a matrix result
+        if ((is_array(operand1)) || (is_array(operand2))) {
+            let tmp = \ZExcel\Calculation\DenseArray::broadcast(operand1, operand2, 2);
+            
+            stack->push("Array", tmp[0]->compare(tmp[1], operation, this->delta)->toArray());
+            
+            return true;
+        }
+        
+        stack->push("Value", \ZExcel\Calculation\DenseArray::compareValues(operand1, operand2, operation, this->delta));
+        
+        return true;
     }
     
-    private function executeNumericBinaryOperation(var cellID, var operand1, var operand2, var operation, var matrixFunction, var stack)
+    private function executeNumericBinaryOperation(var cellID, var operand1, var operand2, var operation, var stack)
     {
-        var matrix, matrixResult, result, tmp, ex;
+        var result, tmp;
         
         //    Validate the two operands
         let operand1 = this->validateBinaryOperand(cellID, operand1, stack);
@@ -4162,27 +5131,12 @@ class Calculation
             return false;
         }
             
-        //    If either of the operands is a matrix, we need to treat them both as matrices
-        //        (converting the other operand to a matrix if need be); then perform the required
-        //        matrix operation
+        //    If either of the operands is an array, we need to treat them both as arrays
+        //        (repeating the other operand if need be); then perform the operation element by element
         if ((is_array(operand1)) || (is_array(operand2))) {
-            //    Ensure that both operands are arrays/matrices of the same size
-            let tmp = self::checkMatrixOperands(operand1, operand2, 2);
-            
-            let operand1 = array_shift(tmp);
-            let operand2 = array_shift(tmp);
-            
-            try {
-                //    Convert operand 1 from a PHP array to a matrix
-                let matrix = new \ZExcel\Shared\JAMA\Matrix();
-                call_user_func([matrix, "initialize"], operand1);
-                
-                //    Perform the required operation against the operand 1 matrix, passing in operand 2
-                let matrixResult = matrix->{matrixFunction}(operand2);
-                let result = matrixResult->getArray();
-            } catch \ZExcel\Exception, ex {
-                let result = "#VALUE!";
-            }
+            //    Ensure that both operands are arrays of the same size
+            let tmp = \ZExcel\Calculation\DenseArray::broadcast(operand1, operand2, 2);
+            let result = tmp[0]->arithmetic(tmp[1], operation)->toArray();
         } else {
             if ((\ZExcel\Calculation\Functions::getCompatibilityMode() != \ZExcel\Calculation\Functions::COMPATIBILITY_OPENOFFICE)
                     && ((is_string(operand1) && !is_numeric(operand1) && strlen(operand1) > 0) || (is_string(operand2) && !is_numeric(operand2) && strlen(operand2) > 0))) {
@@ -4231,6 +5185,7 @@ class Calculation
         let this->formulaError = errorMessage;
         
         this->_cyclicReferenceStack->clear();
+        let this->calculationCacheReaderStack = [];
         
         if (!this->suppressFormulaErrors) {
             throw new \ZExcel\Calculation\Exception(errorMessage);
@@ -4246,7 +5201,8 @@ class Calculation
     
     public function extractCellRange(var pRange = "A1", <\ZExcel\Worksheet> pSheet = null, var resetLog = true) -> array
     {
-        var pSheetName, aReferences, reference, tmp, currentCol, currentRow;
+        var pSheetName, tmp, boundaries, emptyRow;
+        int row, lastRow, blockLastRow;
         array returnValue = [];
 
         if (pSheet !== null) {
@@ -4259,36 +5215,34 @@ class Calculation
                 let pSheet = this->workbook->getSheetByName(pSheetName);
             }
             
-            // Extract range
-            let aReferences = \ZExcel\Cell::extractAllCellReferencesInRange(pRange);
-            let pRange = pSheetName . "!" . pRange;
-            
-            let currentCol = "";
-            let currentRow = "";
-            
-            if (!isset(aReferences[1])) {
-                // Single cell in range
-                sscanf(aReferences[0], "%[A-Z]%d", currentCol, currentRow);
+            //    Read the whole block straight from the cell store, rather than cell by cell
+            if (pSheet !== null) {
+                this->addCalculationCacheRead(pSheetName, pRange);
                 
+                let boundaries = \ZExcel\Cell::rangeBoundaries(str_replace("$", "", pRange));
+                let returnValue = pSheet->extractCalculationBlock(
+                    (int) boundaries[0][0],
+                    (int) boundaries[1][0],
+                    (int) boundaries[0][1],
+                    (int) boundaries[1][1],
+                    (boolean) resetLog
+                );
                 
-                if (pSheet->cellExists(aReferences[0])) {
-                    let returnValue[currentRow][currentCol] = pSheet->getCell(aReferences[0])->getCalculatedValue(resetLog);
-                } else {
-                    let returnValue[currentRow][currentCol] = null;
-                }
-            } else {
-                // Extract cell data for all cells in the range
-                for reference in aReferences {
-                    // Extract range
-                    sscanf(reference, "%[A-Z]%d", currentCol, currentRow);
+                //    The block stops at the data of the worksheet: every row below is empty, and shares one empty row,
+                //    so that functions and operators see the shape of the range without a lookup per cell
+                let lastRow = (int) boundaries[1][1];
+                let blockLastRow = (int) boundaries[0][1] + count(returnValue) - 1;
+                
+                if (blockLastRow < lastRow) {
+                    let emptyRow = array_fill_keys(array_keys(returnValue[(int) boundaries[0][1]]), null);
                     
-                    if (pSheet->cellExists(reference)) {
-                        let returnValue[currentRow][currentCol] = pSheet->getCell(reference)->getCalculatedValue(resetLog);
-                    } else {
-                        let returnValue[currentRow][currentCol] = null;
+                    for row in range(blockLastRow + 1, lastRow) {
+                        let returnValue[row] = emptyRow;
                     }
                 }
             }
+            
+            let pRange = pSheetName . "!" . pRange;
         }
 
         return [
@@ -0,0 +1,490 @@
+namespace ZExcel\Calculation;
+
+class DenseArray
+{
+    /**
+     * Number of rows
+     *
+     * @var int
+     */
+    private rows = 0;
+
+    /**
+     * Number of columns
+     *
+     * @var int
+     */
+    private columns = 0;
+
+    /**
+     * Element values, row by row (element [r][c] is at r * columns + c)
+     *
+     * @var array
+     */
+    private values = [];
+
+    /**
+     * Create a new dense array
+     *
+     * @param int   rows    Number of rows
+     * @param int   columns Number of columns
+     * @param array values  Element values, row by row
+     */
+    public function __construct(int rows, int columns, array values)
+    {
+        let this->rows = rows;
+        let this->columns = columns;
+        let this->values = values;
+    }
+
+    /**
+     * Create a dense array from a matrix (an array of rows, or an array of values for a single row)
+     * Keys are ignored, short rows are padded with null
+     *
+     * @param array matrix
+     * @return \ZExcel\Calculation\DenseArray
+     */
+    public static function fromMatrix(array matrix) -> <\ZExcel\Calculation\DenseArray>
+    {
+        var row, value;
+        int rows = 0, columns = 0, width;
+        array values = [];
+
+        for row in matrix {
+            if (is_array(row)) {
+                let width = count(row);
+            } else {
+                let width = 1;
+            }
+
+            if (width > columns) {
+                let columns = width;
+            }
+        }
+
+        for row in matrix {
+            if (is_array(row)) {
+                let width = 0;
+
+                for value in row {
+                    let values[] = value;
+                    let width++;
+                }
+            } else {
+                let values[] = row;
+                let width = 1;
+            }
+
+            while (width < columns) {
+                let values[] = null;
+                let width++;
+            }
+
+            let rows++;
+        }
+
+        return new self(rows, columns, values);
+    }
+
+    /**
+     * Create a dense array with every element set to the same value
+     *
+     * @param mixed value
+     * @param int   rows
+     * @param int   columns
+     * @return \ZExcel\Calculation\DenseArray
+     */
+    public static function fromScalar(var value, int rows, int columns) -> <\ZExcel\Calculation\DenseArray>
+    {
+        if (rows * columns == 0) {
+            return new self(rows, columns, []);
+        }
+
+        return new self(rows, columns, array_fill(0, rows * columns, value));
+    }
+
+    /**
+     * Bring a pair of operands to a common shape, following the same rules as the calculation engine's
+     *    matrix operand checks: a scalar is repeated to the shape of the other operand; two arrays are
+     *    truncated to the smaller shape (resize 1, or whenever one is the transpose of the other's shape),
+     *    or grown to the larger shape by repeating their last column and last row (resize 2)
+     *
+     * @param mixed operand1
+     * @param mixed operand2
+     * @param int   resize    0 = no resize, 1 = shrink to fit, 2 = extend to fit
+     * @return \ZExcel\Calculation\DenseArray[]
+     */
+    public static function broadcast(var operand1, var operand2, int resize = 1) -> array
+    {
+        var matrix1, matrix2;
+        int rows, columns;
+
+        if (!is_array(operand1)) {
+            let matrix2 = self::fromMatrix(operand2);
+            let matrix1 = self::fromScalar(operand1, matrix2->getRows(), matrix2->getColumns());
+            let resize = 0;
+        } elseif (!is_array(operand2)) {
+            let matrix1 = self::fromMatrix(operand1);
+            let matrix2 = self::fromScalar(operand2, matrix1->getRows(), matrix1->getColumns());
+            let resize = 0;
+        } else {
+            let matrix1 = self::fromMatrix(operand1);
+            let matrix2 = self::fromMatrix(operand2);
+        }
+
+        if ((matrix1->getRows() == matrix2->getColumns()) && (matrix2->getRows() == matrix1->getColumns())) {
+            let resize = 1;
+        }
+
+        if (resize == 2) {
+            let rows = max(matrix1->getRows(), matrix2->getRows());
+            let columns = max(matrix1->getColumns(), matrix2->getColumns());
+        } elseif (resize == 1) {
+            let rows = min(matrix1->getRows(), matrix2->getRows());
+            let columns = min(matrix1->getColumns(), matrix2->getColumns());
+        } else {
+            return [matrix1, matrix2];
+        }
+
+        return [matrix1->resize(rows, columns), matrix2->resize(rows, columns)];
+    }
+
+    /**
+     * Number of rows
+     *
+     * @return int
+     */
+    public function getRows() -> int
+    {
+        return this->rows;
+    }
+
+    /**
+     * Number of columns
+     *
+     * @return int
+     */
+    public function getColumns() -> int
+    {
+        return this->columns;
+    }
+
+    /**
+     * Element values, row by row
+     *
+     * @return array
+     */
+    public function getValues() -> array
+    {
+        return this->values;
+    }
+
+    /**
+     * Return a copy of this array with a new shape: extra rows and columns repeat the last row and column,
+     *    surplus rows and columns are dropped
+     *
+     * @param int rows
+     * @param int columns
+     * @return \ZExcel\Calculation\DenseArray
+     */
+    public function resize(int rows, int columns) -> <\ZExcel\Calculation\DenseArray>
+    {
+        int r, c, sourceRow, sourceColumn;
+        array values = [];
+
+        if ((rows == this->rows) && (columns == this->columns)) {
+            return this;
+        }
+
+        if ((this->rows == 0) || (this->columns == 0)) {
+            return self::fromScalar(null, rows, columns);
+        }
+
+        for r in range(0, rows - 1) {
+            let sourceRow = (r < this->rows) ? r : this->rows - 1;
+
+            for c in range(0, columns - 1) {
+                let sourceColumn = (c < this->columns) ? c : this->columns - 1;
+                let values[] = this->values[sourceRow * this->columns + sourceColumn];
+            }
+        }
+
+        return new self(rows, columns, values);
+    }
+
+    /**
+     * Element-wise arithmetic
+     *
+     * @param \ZExcel\Calculation\DenseArray other     Operand of the same shape
+     * @param string                         operation One of + - * / ^
+     * @return \ZExcel\Calculation\DenseArray
+     * @throws \ZExcel\Calculation\Exception
+     */
+    public function arithmetic(<\ZExcel\Calculation\DenseArray> other, string operation) -> <\ZExcel\Calculation\DenseArray>
+    {
+        var otherValues, key, left, right, result;
+        array values = [];
+
+        this->checkShape(other);
+
+        let otherValues = other->getValues();
+
+        for key, left in this->values {
+            let left = self::toNumber(left);
+            let right = self::toNumber(otherValues[key]);
+
+            //    Errors propagate, the left-hand one first
+            if (is_string(left)) {
+                let values[] = left;
+                continue;
+            }
+
+            if (is_string(right)) {
+                let values[] = right;
+                continue;
+            }
+
+            switch (operation) {
+                case "+":
+                    let result = left + right;
+                    break;
+                case "-":
+                    let result = left - right;
+                    break;
+                case "*":
+                    let result = left * right;
+                    break;
+                case "/":
+                    if (right == 0) {
+                        let result = \ZExcel\Calculation\Functions::DiV0();
+                    } else {
+                        let result = left / right;
+                    }
+                    break;
+                case "^":
+                    if ((left == 0) && (right <= 0)) {
+                        let result = (right == 0) ? \ZExcel\Calculation\Functions::NaN() : \ZExcel\Calculation\Functions::DiV0();
+                    } else {
+                        let result = pow(left, right);
+
+                        if (is_float(result) && (is_nan(result) || is_infinite(result))) {
+                            let result = \ZExcel\Calculation\Functions::NaN();
+                        }
+                    }
+                    break;
+                default:
+                    throw new \ZExcel\Calculation\Exception("Unsupported array operation " . operation);
+            }
+
+            let values[] = result;
+        }
+
+        return new self(this->rows, this->columns, values);
+    }
+
+    /**
+     * Element-wise comparison
+     *
+     * @param \ZExcel\Calculation\DenseArray other     Operand of the same shape
+     * @param string                         operation One of > < >= <= = <>
+     * @param float                          delta     Tolerance used when testing numbers for equality
+     * @return \ZExcel\Calculation\DenseArray
+     */
+    public function compare(<\ZExcel\Calculation\DenseArray> other, string operation, double delta) -> <\ZExcel\Calculation\DenseArray>
+    {
+        var otherValues, key, left;
+        array values = [];
+
+        this->checkShape(other);
+
+        let otherValues = other->getValues();
+
+        for key, left in this->values {
+            let values[] = self::compareValues(left, otherValues[key], operation, delta);
+        }
+
+        return new self(this->rows, this->columns, values);
+    }
+
+    /**
+     * Element-wise string concatenation
+     *
+     * @param \ZExcel\Calculation\DenseArray other Operand of the same shape
+     * @return \ZExcel\Calculation\DenseArray
+     */
+    public function concat(<\ZExcel\Calculation\DenseArray> other) -> <\ZExcel\Calculation\DenseArray>
+    {
+        var otherValues, key, left;
+        array values = [];
+
+        this->checkShape(other);
+
+        let otherValues = other->getValues();
+
+        for key, left in this->values {
+            let values[] = trim(left, "\"") . trim(otherValues[key], "\"");
+        }
+
+        return new self(this->rows, this->columns, values);
+    }
+
+    /**
+     * Return the array as a matrix (an array of rows), indexed from 0
+     *
+     * @return array
+     */
+    public function toArray() -> array
+    {
+        if (this->columns == 0) {
+            return [];
+        }
+
+        return array_chunk(this->values, this->columns);
+    }
+
+    /**
+     * Compare two values in the way Excel (or OpenOffice, in OpenOffice compatibility mode) does
+     *
+     * @param mixed  left
+     * @param mixed  right
+     * @param string operation One of > < >= <= = <>
+     * @param float  delta     Tolerance used when testing numbers for equality
+     * @return boolean
+     */
+    public static function compareValues(var left, var right, string operation, double delta) -> boolean
+    {
+        boolean openOffice, lowercaseFirst, numeric;
+
+        let left = \ZExcel\Calculation::unwrapResult(left);
+        let right = \ZExcel\Calculation::unwrapResult(right);
+
+        let openOffice = (\ZExcel\Calculation\Functions::getCompatibilityMode() == \ZExcel\Calculation\Functions::COMPATIBILITY_OPENOFFICE);
+
+        //    Excel compares strings case-insensitively
+        if (!openOffice) {
+            if (is_string(left)) {
+                let left = strtoupper(left);
+            }
+
+            if (is_string(right)) {
+                let right = strtoupper(right);
+            }
+        }
+
+        let lowercaseFirst = openOffice && is_string(left) && is_string(right);
+        let numeric = is_numeric(left) && is_numeric(right);
+
+        switch (operation) {
+            case ">":
+                if (lowercaseFirst) {
+                    return self::strcmpLowercaseFirst(left, right) > 0;
+                }
+                return left > right;
+            case "<":
+                if (lowercaseFirst) {
+                    return self::strcmpLowercaseFirst(left, right) < 0;
+                }
+                return left < right;
+            case "=":
+                if (numeric) {
+                    return abs(left - right) < delta;
+                }
+                return strcmp(left, right) == 0;
+            case ">=":
+                if (numeric) {
+                    return (abs(left - right) < delta) || (left > right);
+                }
+                if (lowercaseFirst) {
+                    return self::strcmpLowercaseFirst(left, right) >= 0;
+                }
+                return strcmp(left, right) >= 0;
+            case "<=":
+                if (numeric) {
+                    return (abs(left - right) < delta) || (left < right);
+                }
+                if (lowercaseFirst) {
+                    return self::strcmpLowercaseFirst(left, right) <= 0;
+                }
+                return strcmp(left, right) <= 0;
+            case "<>":
+                if (numeric) {
+                    return abs(left - right) > delta;
+                }
+                return strcmp(left, right) != 0;
+        }
+
+        return false;
+    }
+
+    /**
+     * Compare two strings with lowercase letters sorting before uppercase ones (OpenOffice collation)
+     *
+     * @param string str1
+     * @param string str2
+     * @return int
+     */
+    private static function strcmpLowercaseFirst(string str1, string str2) -> int
+    {
+        return strcmp(\ZExcel\Shared\Stringg::StrCaseReverse(str1), \ZExcel\Shared\Stringg::StrCaseReverse(str2));
+    }
+
+    /**
+     * Convert an element to a number for arithmetic, or to an Excel error string
+     *
+     * @param mixed value
+     * @return mixed
+     */
+    private static function toNumber(var value)
+    {
+        var number;
+
+        if (value === null) {
+            return 0;
+        }
+
+        if (is_bool(value)) {
+            return value ? 1 : 0;
+        }
+
+        if (!is_string(value)) {
+            return value;
+        }
+
+        if (is_numeric(value)) {
+            return value + 0;
+        }
+
+        let value = trim(value, "\"");
+
+        if (value === "") {
+            return 0;
+        }
+
+        if (is_numeric(value)) {
+            return value + 0;
+        }
+
+        if (substr(value, 0, 1) == "#") {
+            return value;
+        }
+
+        let number = \ZExcel\Shared\Stringg::convertToNumberIfFraction(value);
+
+        if (number === false) {
+            return \ZExcel\Calculation\Functions::VaLUE();
+        }
+
+        return number;
+    }
+
+    /**
+     * @param \ZExcel\Calculation\DenseArray other
+     * @throws \ZExcel\Calculation\Exception
+     */
+    private function checkShape(<\ZExcel\Calculation\DenseArray> other)
+    {
+        if ((other->getRows() != this->rows) || (other->getColumns() != this->columns)) {
+            throw new \ZExcel\Calculation\Exception("Array operands must have the same dimensions.");
+        }
+    }
+}
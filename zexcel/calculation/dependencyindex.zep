@@ -0,0 +1,224 @@
+namespace ZExcel\Calculation;
+
+class DependencyIndex
+{
+    /* Rows covered by the index: 2 ^ ROW_LEVELS, the last row of a worksheet */
+    const ROW_LEVELS = 20;
+
+    /* Up to this number of rows, a lookup walks the rows of the area looked up rather than every node held */
+    const ROW_WALK_LIMIT = 64;
+
+    /**
+     * Keys of the areas held by the nodes of a segment tree over rows, as [key => true] indexed by node
+     * Node 1 covers every row, and the rows of node n are split between nodes 2n and 2n + 1; row r is node
+     * 2 ^ ROW_LEVELS + r - 1. An area is held by the few nodes whose rows it covers entirely, so the areas
+     * reaching a row are found on the path from the row to the root
+     *
+     * @var array
+     */
+    private nodes = [];
+
+    /**
+     * Indexed areas, as [first column index, first row, last column index, last row, payload] indexed by key
+     *
+     * @var array
+     */
+    private areas = [];
+
+    /**
+     * Add an area to the index, unless an area with the same key is already held
+     *
+     * @param string key       Identifies the area, e.g. to remove it
+     * @param int    firstColumn
+     * @param int    firstRow
+     * @param int    lastColumn
+     * @param int    lastRow
+     * @param mixed  payload   Returned with the area by find()
+     * @return \ZExcel\Calculation\DependencyIndex
+     */
+    public function add(string key, int firstColumn, int firstRow, int lastColumn, int lastRow, var payload = null) -> <\ZExcel\Calculation\DependencyIndex>
+    {
+        var node;
+
+        if (isset(this->areas[key])) {
+            return this;
+        }
+
+        let firstRow = max(1, firstRow);
+        let lastRow = min(1 << self::ROW_LEVELS, lastRow);
+        let this->areas[key] = [firstColumn, firstRow, lastColumn, lastRow, payload];
+
+        for node in self::nodesCovering(firstRow, lastRow) {
+            let this->nodes[node][key] = true;
+        }
+
+        return this;
+    }
+
+    /**
+     * Remove an area from the index
+     *
+     * @param string key
+     * @return \ZExcel\Calculation\DependencyIndex
+     */
+    public function remove(string key) -> <\ZExcel\Calculation\DependencyIndex>
+    {
+        var area, node;
+
+        if (!isset(this->areas[key])) {
+            return this;
+        }
+
+        let area = this->areas[key];
+        unset(this->areas[key]);
+
+        for node in self::nodesCovering(area[1], area[3]) {
+            unset(this->nodes[node][key]);
+
+            if (empty(this->nodes[node])) {
+                unset(this->nodes[node]);
+            }
+        }
+
+        return this;
+    }
+
+    /**
+     * Is an area held under a key?
+     *
+     * @param string key
+     * @return boolean
+     */
+    public function has(string key) -> boolean
+    {
+        return isset(this->areas[key]);
+    }
+
+    /**
+     * Get the indexed areas
+     *
+     * @return array Areas, as [first column index, first row, last column index, last row, payload] indexed by key
+     */
+    public function getAreas() -> array
+    {
+        return this->areas;
+    }
+
+    /**
+     * Does the index hold any area?
+     *
+     * @return boolean
+     */
+    public function isEmpty() -> boolean
+    {
+        return empty(this->areas);
+    }
+
+    /**
+     * Find the areas overlapping a block of cells
+     *
+     * @param int firstColumn
+     * @param int firstRow
+     * @param int lastColumn
+     * @param int lastRow
+     * @return array Payloads of the areas found, indexed by key
+     */
+    public function find(int firstColumn, int firstRow, int lastColumn, int lastRow) -> array
+    {
+        var node, keys, key, area;
+        int row, level, size, nodeFirstRow;
+        array visited = [], found = [];
+
+        let firstRow = max(1, firstRow);
+        let lastRow = min(1 << self::ROW_LEVELS, lastRow);
+
+        if (empty(this->areas) || firstRow > lastRow) {
+            return [];
+        }
+
+        if (lastRow - firstRow < self::ROW_WALK_LIMIT) {
+            //    Nodes on the paths from the rows to the root, each visited once
+            for row in range(firstRow, lastRow) {
+                let node = (1 << self::ROW_LEVELS) + row - 1;
+
+                while (node >= 1 && !isset(visited[node])) {
+                    let visited[node] = true;
+
+                    if (isset(this->nodes[node])) {
+                        for key, _ in this->nodes[node] {
+                            let area = this->areas[key];
+
+                            if (area[0] <= lastColumn && area[2] >= firstColumn) {
+                                let found[key] = area[4];
+                            }
+                        }
+                    }
+
+                    let node = node >> 1;
+                }
+            }
+
+            return found;
+        }
+
+        //    Every node held whose rows overlap the block
+        for node, keys in this->nodes {
+            let level = 0;
+
+            while ((node >> (level + 1)) > 0) {
+                let level++;
+            }
+
+            let size = 1 << (self::ROW_LEVELS - level);
+            let nodeFirstRow = (node - (1 << level)) * size + 1;
+
+            if (nodeFirstRow > lastRow || nodeFirstRow + size - 1 < firstRow) {
+                continue;
+            }
+
+            for key, _ in keys {
+                let area = this->areas[key];
+
+                if (area[0] <= lastColumn && area[2] >= firstColumn) {
+                    let found[key] = area[4];
+                }
+            }
+        }
+
+        return found;
+    }
+
+    /**
+     * Nodes of the segment tree whose rows make up a block of rows
+     *
+     * @param int firstRow
+     * @param int lastRow
+     * @return int[]
+     */
+    private static function nodesCovering(int firstRow, int lastRow) -> array
+    {
+        int low, high;
+        array nodes = [];
+
+        // Leaves from low (included) to high (excluded), then their parents, level by level
+        let low = (1 << self::ROW_LEVELS) + firstRow - 1;
+        let high = (1 << self::ROW_LEVELS) + lastRow;
+
+        while (low < high) {
+            if (low & 1) {
+                let nodes[] = low;
+                let low++;
+            }
+
+            if (high & 1) {
+                let high--;
+                let nodes[] = high;
+            }
+
+            let low = low >> 1;
+            let high = high >> 1;
+        }
+
+        return nodes;
+    }
+}
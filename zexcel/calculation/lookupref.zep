@@ -367,7 +367,10 @@ class LookupRef
             let pSheet = pCell->getWorksheet();
         }
 
-        return \ZExcel\Calculation::getInstance()->extractCellRange(cellAddress, pSheet, false);
+        //    Read through the engine of the workbook, so that the calculation cache knows what the formula read
+        let tmp = \ZExcel\Calculation::getInstance(pCell->getWorksheet()->getParent())->extractCellRange(cellAddress, pSheet, false);
+
+        return tmp[1];
     }
 
 
@@ -483,7 +486,10 @@ class LookupRef
             let pSheet = pCell->getWorksheet();
         }
 
-        return \ZExcel\Calculation::getInstance()->extractCellRange(cellAddress, pSheet, false);
+        //    Read through the engine of the workbook, so that the calculation cache knows what the formula read
+        let tmp = \ZExcel\Calculation::getInstance(pCell->getWorksheet()->getParent())->extractCellRange(cellAddress, pSheet, false);
+
+        return tmp[1];
     }
 
 
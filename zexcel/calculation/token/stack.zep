@@ -70,6 +70,23 @@ class Stack
         return null;
     }
 
+    /**
+     * Pop the last n entries from the stack, in the order they were pushed
+     *
+     * @param   integer  n  number of entries to pop
+     * @return  mixed[]
+     */
+    public function popMany(int n) -> array
+    {
+        if (n > this->count) {
+            let n = this->count;
+        }
+
+        let this->count = this->count - n;
+
+        return array_slice(this->stack, this->count, n);
+    }
+
     /**
      * Return an entry from the stack without removing it
      *
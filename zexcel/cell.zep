@@ -81,6 +81,7 @@ class Cell
     public function notifyCacheController()
     {
         this->parent->updateCacheData(this);
+        this->parent->getParent()->cellChanged(this->parent->getCurrentAddress());
 
         return this;
     }
@@ -209,39 +210,51 @@ class Cell
      */
     public function setValueExplicit(var pValue = null, var pDataType = \ZExcel\Cell\DataType::TYPE_STRING)
     {
+        if (pDataType == \ZExcel\Cell\DataType::TYPE_STRING2) {
+            let pDataType = \ZExcel\Cell\DataType::TYPE_STRING;
+        }
+        
         // set the value according to data type
+        let this->value = self::convertValueExplicit(pValue, pDataType);
+
+        // set the datatype
+        let this->dataType = pDataType;
+        
+        this->getWorksheet()->cellValueChanged(this->getCoordinate());
+
+        return this->notifyCacheController();
+    }
+
+    /**
+     *    Convert a value to the representation stored in a cell for an explicit data type
+     *
+     *    @param    mixed    pValue            Value
+     *    @param    string    pDataType        Explicit data type
+     *    @return    mixed
+     *    @throws    \ZExcel\Exception
+     */
+    public static function convertValueExplicit(var pValue, var pDataType)
+    {
         switch (pDataType) {
             case \ZExcel\Cell\DataType::TYPE_NULL:
-                let this->value = pValue;
-                break;
+                return pValue;
             case \ZExcel\Cell\DataType::TYPE_STRING2:
-                let pDataType = \ZExcel\Cell\DataType::TYPE_STRING;
-            case \ZExcel\Cell\DataType::TYPE_STRING:
                 // Synonym for string
+            case \ZExcel\Cell\DataType::TYPE_STRING:
             case \ZExcel\Cell\DataType::TYPE_INLINE:
                 // Rich text
-                let this->value = \ZExcel\Cell\DataType::checkString(pValue);
-                break;
+                return \ZExcel\Cell\DataType::checkString(pValue);
             case \ZExcel\Cell\DataType::TYPE_NUMERIC:
-                let this->value = (float) pValue;
-                break;
+                return (float) pValue;
             case \ZExcel\Cell\DataType::TYPE_FORMULA:
-                let this->value = (string) pValue;
-                break;
+                return (string) pValue;
             case \ZExcel\Cell\DataType::TYPE_BOOL:
-                let this->value = (boolean) pValue;
-                break;
+                return (boolean) pValue;
             case \ZExcel\Cell\DataType::TYPE_ERROR:
-                let this->value = \ZExcel\Cell\DataType::checkErrorCode(pValue);
-                break;
-            default:
-                throw new \ZExcel\Exception("Invalid datatype: " . pDataType);
+                return \ZExcel\Cell\DataType::checkErrorCode(pValue);
         }
-
-        // set the datatype
-        let this->dataType = pDataType;
-
-        return this->notifyCacheController();
+        
+        throw new \ZExcel\Exception("Invalid datatype: " . pDataType);
     }
 
     /**
@@ -255,13 +268,18 @@ class Cell
      */
     public function getCalculatedValue(resetLog = true)
     {
-        var result, ex;
+        var result, ex, calculation;
         
         if (this->dataType == \ZExcel\Cell\DataType::TYPE_FORMULA) {
+            let calculation = \ZExcel\Calculation::getInstance(this->getWorksheet()->getParent());
+            
+            //    When the engine trusts stored values, they stand until a cell the formula depends on changes
+            if (calculation->isCalculatedValueTrusted(this)) {
+                return this->calculatedValue;
+            }
+            
             try {
-                let result = \ZExcel\Calculation::getInstance(
-                    this->getWorksheet()->getParent()
-                )->calculateCellValue(this, resetLog);
+                let result = calculation->calculateCellValue(this, resetLog);
                 
                 //    We don't yet handle array returns
                 if (is_array(result)) {
@@ -286,6 +304,12 @@ class Cell
                 return this->calculatedValue; // Fallback if calculation engine does not support the formula.
             }
             
+            if (calculation->getTrustCachedValues()) {
+                let this->calculatedValue = result;
+                this->notifyCacheController();
+                calculation->calculatedValueRefreshed(this);
+            }
+            
             return result;
         } else {
             if (is_object(this->value) && this->value instanceof \ZExcel\RichText) {
@@ -349,6 +373,8 @@ class Cell
         }
         
         let this->dataType = pDataType;
+        
+        this->getWorksheet()->cellValueChanged(this->getCoordinate());
 
         return this->notifyCacheController();
     }
@@ -518,15 +544,23 @@ class Cell
      */
     public function getMergeRange()
     {
-        var mergeRange;
+        var mergeIndex, mergeRange;
+        int packed;
         
-        for mergeRange in this->getWorksheet()->getMergeCells() {
-            if (this->isInRange(mergeRange)) {
-                return mergeRange;
-            }
+        let mergeIndex = this->getWorksheet()->getMergeIndex();
+        
+        if (mergeIndex->isEmpty()) {
+            return false;
         }
         
-        return false;
+        let packed = \ZExcel\Cell\Coordinate::parse(this->getCoordinate());
+        let mergeRange = mergeIndex->find(\ZExcel\Cell\Coordinate::column(packed), \ZExcel\Cell\Coordinate::row(packed));
+        
+        if (mergeRange === null) {
+            return false;
+        }
+        
+        return mergeRange;
     }
 
     /**
@@ -583,10 +617,12 @@ class Cell
      */
     public static function coordinateFromString(string pCoordinateString = "A1")
     {
-        var matches = [];
+        int offset;
         
-        if (preg_match("/^([$]?[A-Z]{1,3})([$]?\d{1,7})$/", pCoordinateString, matches)) {
-            return [matches[1],matches[2]];
+        if (\ZExcel\Cell\Coordinate::parse(pCoordinateString) != \ZExcel\Cell\Coordinate::INVALID) {
+            let offset = \ZExcel\Cell\Coordinate::rowOffset(pCoordinateString);
+            
+            return [substr(pCoordinateString, 0, offset), substr(pCoordinateString, offset)];
         } else {
             if ((strpos(pCoordinateString,":") !== false) || (strpos(pCoordinateString,",") !== false)) {
                 throw new \ZExcel\Exception("Cell coordinate string can not be a range of cells");
@@ -898,9 +934,9 @@ class Cell
      */
     public static function extractAllCellReferencesInRange(var pRange = "A1")
     {
-        var cellBlocks, cellBlock, ranges, range, rangeStart, rangeEnd,
-            startCol = 0, startRow = 0, endCol = 0, endRow = 0,
-            currentCol, currentRow, sortKeys, coord, tmp;
+        var cellBlocks, cellBlock, ranges, cellRange, sortKeys, coord, columnLetter;
+        int rangeStart, rangeEnd, startCol, startRow, endCol, endRow,
+            currentCol, currentRow, packed, sortKey;
         
         // Returnvalue
         array returnValue = [];
@@ -918,41 +954,33 @@ class Cell
             // Range...
             let ranges = self::splitRange(cellBlock);
             
-            for range in ranges {
+            for cellRange in ranges {
                 // Single cell?
-                if (count(range) === 1) {
-                    let returnValue[] = range[0];
+                if (count(cellRange) === 1) {
+                    let returnValue[] = cellRange[0];
                     continue;
                 }
 
                 // Range...
-                let rangeStart = range[0];
-                let rangeEnd = range[1];
+                let rangeStart = \ZExcel\Cell\Coordinate::parse(cellRange[0]);
+                let rangeEnd = \ZExcel\Cell\Coordinate::parse(cellRange[1]);
                 
-                let tmp = sscanf(rangeStart, "%[A-Z]%d");
-                
-                let startCol = tmp[0];
-                let startRow = tmp[1];
-                
-                let tmp = sscanf(rangeEnd, "%[A-Z]%d");
-                
-                let endCol = tmp[0];
-                let endRow = tmp[1];
-                
-                let endCol = chr(ord(endCol) + 1);
+                if (rangeStart == \ZExcel\Cell\Coordinate::INVALID || rangeEnd == \ZExcel\Cell\Coordinate::INVALID) {
+                    throw new \ZExcel\Exception("Invalid cell range " . cellBlock);
+                }
                 
-                // Current data
-                let currentCol = startCol;
-                let currentRow = startRow;
+                let startCol = \ZExcel\Cell\Coordinate::column(rangeStart);
+                let startRow = \ZExcel\Cell\Coordinate::row(rangeStart);
+                let endCol = \ZExcel\Cell\Coordinate::column(rangeEnd);
+                let endRow = \ZExcel\Cell\Coordinate::row(rangeEnd);
 
                 // Loop cells
-                while (currentCol != endCol) {
-                    while (currentRow <= endRow) {
-                        let returnValue[] = currentCol . currentRow;
-                        let currentRow = currentRow + 1;
+                for currentCol in range(startCol, endCol) {
+                    let columnLetter = self::stringFromColumnIndex(currentCol - 1);
+                    
+                    for currentRow in range(startRow, endRow) {
+                        let returnValue[] = columnLetter . currentRow;
                     }
-                    let currentCol = chr(ord(currentCol) + 1);
-                    let currentRow = startRow;
                 }
             }
         }
@@ -961,8 +989,9 @@ class Cell
         let sortKeys = [];
         
         for coord in array_unique(returnValue) {
-            let tmp = sscanf(coord, "%[A-Z]%d");
-            let sortKeys[sprintf("%3s%09d", tmp[0], tmp[1])] = coord;
+            let packed = \ZExcel\Cell\Coordinate::parse(coord);
+            let sortKey = \ZExcel\Cell\Coordinate::column(packed) * 16777216 + \ZExcel\Cell\Coordinate::row(packed);
+            let sortKeys[sortKey] = coord;
         }
         
         ksort(sortKeys);
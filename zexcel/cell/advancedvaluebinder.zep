@@ -38,6 +38,15 @@ class AdvancedValueBinder extends DefaultValueBinder implements IValueBinder
                 }
             }
             
+            // None of the formats below can match a string without any of these characters
+            if (strpbrk(value, "0123456789%/\n") === false) {
+                parent::countBinding("plain");
+                
+                return this->bindValueAs(cell, value, dataType);
+            }
+            
+            parent::countBinding("advanced");
+            
             // Check for number in scientific format
             if (preg_match("/^" . \ZExcel\Calculation::CALCULATION_REGEXP_NUMBER . "$/", value)) {
                 cell->setValueExplicit((float) value, \ZExcel\Cell\DataType::TYPE_NUMERIC);
@@ -209,7 +218,7 @@ class AdvancedValueBinder extends DefaultValueBinder implements IValueBinder
             }
         }
 
-        // Not bound yet? Use parent...
-        return parent::bindValue(cell, value);
+        // Not bound yet? Bind with the data type found above
+        return this->bindValueAs(cell, value, dataType);
     }
 }
@@ -0,0 +1,202 @@
+namespace ZExcel\Cell;
+
+/**
+ * Codec for cell coordinates
+ *
+ * Coordinates are packed into a single integer, with the row number in the high bits
+ * and the (0-based) column index in the low COLUMN_BITS bits, so that packed
+ * coordinates sort by row and then by column.
+ * Parsing walks the string once and does not allocate.
+ */
+class Coordinate
+{
+    /**
+     * Number of bits holding the column index (columns A to ZZZ fit in 15 bits)
+     */
+    const COLUMN_BITS = 15;
+
+    const COLUMN_MASK = 32767;
+
+    /**
+     * Returned by the parse functions for an invalid coordinate
+     */
+    const INVALID = -1;
+
+    /**
+     * Pack a column index and a row number
+     *
+     * @param int column Column index (1-based, e.g. A = 1)
+     * @param int row    Row number
+     * @return int
+     */
+    public static function pack(int column, int row) -> int
+    {
+        return (row << self::COLUMN_BITS) | (column - 1);
+    }
+
+    /**
+     * Column index of a packed coordinate
+     *
+     * @param int packed
+     * @return int Column index (1-based, e.g. A = 1)
+     */
+    public static function column(int packed) -> int
+    {
+        return (packed & self::COLUMN_MASK) + 1;
+    }
+
+    /**
+     * Row number of a packed coordinate
+     *
+     * @param int packed
+     * @return int
+     */
+    public static function row(int packed) -> int
+    {
+        return packed >> self::COLUMN_BITS;
+    }
+
+    /**
+     * Parse an A1 coordinate (e.g. B7 or $B$7)
+     *
+     * Accepts 1 to 3 column letters and 1 to 7 row digits, each optionally preceded by "$"
+     *
+     * @param string  coordinate
+     * @param boolean caseInsensitive Also accept lowercase column letters
+     * @return int Packed coordinate, or INVALID
+     */
+    public static function parse(string coordinate, boolean caseInsensitive = false) -> int
+    {
+        char ch;
+        int column = 0, row = 0, letters = 0, digits = 0;
+        boolean columnDollar = false, rowDollar = false;
+
+        for ch in coordinate {
+            if (ch >= 'A' && ch <= 'Z') {
+                if (digits > 0 || rowDollar || letters == 3) {
+                    return self::INVALID;
+                }
+                let column = column * 26 + (ch - 'A') + 1;
+                let letters++;
+            } elseif (caseInsensitive && ch >= 'a' && ch <= 'z') {
+                if (digits > 0 || rowDollar || letters == 3) {
+                    return self::INVALID;
+                }
+                let column = column * 26 + (ch - 'a') + 1;
+                let letters++;
+            } elseif (ch >= '0' && ch <= '9') {
+                if (letters == 0 || digits == 7) {
+                    return self::INVALID;
+                }
+                let row = row * 10 + (ch - '0');
+                let digits++;
+            } elseif (ch == '$') {
+                if (letters == 0 && !columnDollar) {
+                    let columnDollar = true;
+                } elseif (letters > 0 && digits == 0 && !rowDollar) {
+                    let rowDollar = true;
+                } else {
+                    return self::INVALID;
+                }
+            } else {
+                return self::INVALID;
+            }
+        }
+
+        if (digits == 0) {
+            return self::INVALID;
+        }
+
+        return (row << self::COLUMN_BITS) | (column - 1);
+    }
+
+    /**
+     * Offset at which the row part (including any "$") of a valid A1 coordinate starts
+     *
+     * @param string coordinate A coordinate accepted by parse()
+     * @return int
+     */
+    public static function rowOffset(string coordinate) -> int
+    {
+        char ch;
+        int offset = 0;
+
+        for ch in coordinate {
+            if (offset > 0 && (ch == '$' || (ch >= '0' && ch <= '9'))) {
+                return offset;
+            }
+            let offset++;
+        }
+
+        return offset;
+    }
+
+    /**
+     * Parse an absolute R1C1 coordinate (e.g. R7C2)
+     *
+     * @param string coordinate
+     * @return int Packed coordinate, or INVALID
+     */
+    public static function parseR1C1(string coordinate) -> int
+    {
+        char ch;
+        int column = 0, row = 0, part = 0, digits = 0;
+
+        for ch in coordinate {
+            if (ch == 'R' || ch == 'r') {
+                if (part != 0) {
+                    return self::INVALID;
+                }
+                let part = 1;
+            } elseif (ch == 'C' || ch == 'c') {
+                if (part != 1 || digits == 0) {
+                    return self::INVALID;
+                }
+                let part = 2;
+                let digits = 0;
+            } elseif (ch >= '0' && ch <= '9') {
+                if (part == 1) {
+                    let row = row * 10 + (ch - '0');
+                } elseif (part == 2) {
+                    let column = column * 10 + (ch - '0');
+                } else {
+                    return self::INVALID;
+                }
+                let digits++;
+                if (digits > 7) {
+                    return self::INVALID;
+                }
+            } else {
+                return self::INVALID;
+            }
+        }
+
+        if (part != 2 || digits == 0 || column < 1 || column > self::COLUMN_MASK) {
+            return self::INVALID;
+        }
+
+        return (row << self::COLUMN_BITS) | (column - 1);
+    }
+
+    /**
+     * Format a packed coordinate as an A1 coordinate
+     *
+     * @param int packed
+     * @return string
+     */
+    public static function format(int packed) -> string
+    {
+        return \ZExcel\Cell::stringFromColumnIndex(packed & self::COLUMN_MASK) . (packed >> self::COLUMN_BITS);
+    }
+
+    /**
+     * Format a packed coordinate as an absolute R1C1 coordinate
+     *
+     * @param int packed
+     * @return string
+     */
+    public static function formatR1C1(int packed) -> string
+    {
+        return "R" . (packed >> self::COLUMN_BITS) . "C" . ((packed & self::COLUMN_MASK) + 1);
+    }
+}
@@ -2,6 +2,13 @@ namespace ZExcel\Cell;
 
 class DefaultValueBinder implements IValueBinder
 {
+    /**
+     * Number of values bound through each path, indexed by path (a data type)
+     *
+     * @var integer[]
+     */
+    protected static bindingCounters = [];
+
     /**
      * Bind value to a cell
      *
@@ -10,6 +17,18 @@ class DefaultValueBinder implements IValueBinder
      * @return boolean
      */
     public function bindValue(<\ZExcel\Cell> cell, var value = null)
+    {
+        return this->bindValueByType(cell, value);
+    }
+
+    /**
+     * Bind value to a cell with the data type inferred by dataTypeForValue()
+     *
+     * @param  \ZExcel\Cell  cell   Cell to bind value to
+     * @param  mixed          value  Value to bind in cell
+     * @return boolean
+     */
+    protected function bindValueByType(<\ZExcel\Cell> cell, var value = null)
     {
         // sanitize UTF-8 strings
         if (is_string(value)) {
@@ -27,13 +46,160 @@ class DefaultValueBinder implements IValueBinder
             }
         }
         
+        return this->bindValueAs(cell, value, self::dataTypeForValue(value));
+    }
+
+    /**
+     * Bind an already sanitized value to a cell with a data type that is already known
+     *
+     * @param  \ZExcel\Cell  cell      Cell to bind value to
+     * @param  mixed          value     Value to bind in cell
+     * @param  string         dataType  As returned by dataTypeForValue()
+     * @return boolean
+     */
+    protected function bindValueAs(<\ZExcel\Cell> cell, var value, string dataType)
+    {
+        self::countBinding(dataType);
+        
         // Set value explicit
-        cell->setValueExplicit(value, self::dataTypeForValue(value));
+        cell->setValueExplicit(value, dataType);
 
         // Done!
         return true;
     }
 
+    /**
+     * Count a value bound through a path
+     *
+     * @param  string  path
+     */
+    protected static function countBinding(string path)
+    {
+        if (isset(self::bindingCounters[path])) {
+            let self::bindingCounters[path] = self::bindingCounters[path] + 1;
+        } else {
+            let self::bindingCounters[path] = 1;
+        }
+    }
+
+    /**
+     * Get the number of values bound through each path, indexed by path
+     *    (a data type, or the paths of the advanced value binder)
+     *
+     * @return  integer[]
+     */
+    public static function getBindingCounters() -> array
+    {
+        return self::bindingCounters;
+    }
+
+    /**
+     * Reset the binding counters
+     */
+    public static function resetBindingCounters()
+    {
+        let self::bindingCounters = [];
+    }
+
+    /**
+     * Is a string a number, i.e. does it match /^[\+\-]?([0-9]+\.?[0-9]*|[0-9]*\.?[0-9]+)([Ee][\-\+]?[0-2]?\d{1,3})?$/ ?
+     *
+     * @param   string  pValue
+     * @return  boolean
+     */
+    public static function isNumericString(string pValue) -> boolean
+    {
+        char ch;
+        int length, position = 0, state = 0, mantissaDigits = 0, exponentDigits = 0;
+        boolean hasDot = false, hasExponentSign = false, highExponent = false;
+        
+        let length = strlen(pValue);
+        
+        // "$" also matches before a trailing newline
+        if (length > 0 && pValue[length - 1] == '\n') {
+            let length--;
+        }
+        
+        // state: 0 = start, 1 = mantissa, 2 = after the exponent marker, 3 = exponent digits
+        for ch in pValue {
+            if (position == length) {
+                break;
+            }
+            
+            let position++;
+            
+            if (ch >= '0' && ch <= '9') {
+                if (state < 2) {
+                    let mantissaDigits++;
+                    let state = 1;
+                } else {
+                    let exponentDigits++;
+                    
+                    if (exponentDigits == 1 && ch > '2') {
+                        let highExponent = true;
+                    }
+                    
+                    if (exponentDigits > 4 || (exponentDigits == 4 && highExponent)) {
+                        return false;
+                    }
+                    
+                    let state = 3;
+                }
+            } elseif (ch == '.') {
+                if (state > 1 || hasDot) {
+                    return false;
+                }
+                
+                let hasDot = true;
+                let state = 1;
+            } elseif (ch == '+' || ch == '-') {
+                if (state == 2 && !hasExponentSign) {
+                    let hasExponentSign = true;
+                } elseif (position != 1) {
+                    return false;
+                }
+            } elseif (ch == 'e' || ch == 'E') {
+                if (state != 1 || mantissaDigits == 0) {
+                    return false;
+                }
+                
+                let state = 2;
+            } else {
+                return false;
+            }
+        }
+        
+        return mantissaDigits > 0 && state != 2;
+    }
+
+    /**
+     * DataType for a string that may be a number
+     *
+     * @param   string  pValue
+     * @return  string|null  TYPE_NUMERIC, TYPE_STRING for numbers that must be kept as text
+     *                       (leading zeros, integers that overflow), or null if pValue is not a number
+     */
+    public static function dataTypeForNumericString(string pValue)
+    {
+        var tValue;
+        
+        if (!self::isNumericString(pValue)) {
+            return null;
+        }
+        
+        let tValue = ltrim(pValue, "+-");
+        
+        if (substr(tValue, 0, 1) === "0" && strlen(tValue) > 1 && substr(tValue, 1, 1) !== ".") {
+            return \ZExcel\Cell\DataType::TYPE_STRING;
+        }
+        
+        if ((strpos(pValue, ".") === false) && (pValue > PHP_INT_MAX)) {
+            return \ZExcel\Cell\DataType::TYPE_STRING;
+        }
+        
+        return \ZExcel\Cell\DataType::TYPE_NUMERIC;
+    }
+
     /**
      * DataType for value
      *
@@ -42,7 +208,7 @@ class DefaultValueBinder implements IValueBinder
      */
     public static function dataTypeForValue(var pValue = null)
     {
-        var tValue = [];
+        var numericType;
         
         // Match the value against a few data types
         if (pValue === null) {
@@ -63,20 +229,14 @@ class DefaultValueBinder implements IValueBinder
                             if (is_float(pValue) || is_int(pValue)) {
                                 return \ZExcel\Cell\DataType::TYPE_NUMERIC;
                             } else {
-                                if (preg_match("/^[\+\-]?([0-9]+\\.?[0-9]*|[0-9]*\\.?[0-9]+)([Ee][\-\+]?[0-2]?\d{1,3})?$/", pValue)) {
-                                    let tValue = ltrim(pValue, "+-");
+                                if (is_string(pValue)) {
+                                    let numericType = self::dataTypeForNumericString(pValue);
                                     
-                                    if (is_string(pValue) && substr(tValue, 0, 1) === strval(0) && strlen(tValue) > 1 && substr(tValue, 1, 1) !== ".") {
-                                        return \ZExcel\Cell\DataType::TYPE_STRING;
-                                    } else {
-                                        if ((strpos(pValue, ".") === false) && (pValue > PHP_INT_MAX)) {
-                                            return \ZExcel\Cell\DataType::TYPE_STRING;
-                                        }
+                                    if (numericType !== null) {
+                                        return numericType;
                                     }
                                     
-                                    return \ZExcel\Cell\DataType::TYPE_NUMERIC;
-                                } else {
-                                    if (is_string(pValue) && array_key_exists(pValue, \ZExcel\Cell\DataType::getErrorCodes())) {
+                                    if (array_key_exists(pValue, \ZExcel\Cell\DataType::getErrorCodes())) {
                                         return \ZExcel\Cell\DataType::TYPE_ERROR;
                                     }
                                 }
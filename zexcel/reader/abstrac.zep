@@ -20,6 +20,15 @@ abstract class Abstrac implements IReader
      */
     protected readEmptyCells = true;
     
+    /**
+     * Trust the calculated values read for formula cells?
+     * Identifies whether formula cells of the loaded workbook should return the value read from the file
+     *         until a cell they depend on changes, instead of being evaluated
+     *
+     * @var    boolean
+     */
+    protected trustCachedValues = false;
+    
     /**
      * Read charts that are defined in the workbook?
      * Identifies whether the Reader should read the definitions for any charts that exist in the workbook;
@@ -101,6 +110,33 @@ abstract class Abstrac implements IReader
         return this;
     }
 
+    /**
+     * Trust the calculated values read for formula cells?
+     *
+     * @return    boolean
+     */
+    public function getTrustCachedValues() -> boolean
+    {
+        return this->trustCachedValues;
+    }
+
+    /**
+     * Set trust cached values
+     *        Set to true to have formula cells return the calculated value read from the file until a cell they
+     *        depend on changes (see \ZExcel\Calculation::setTrustCachedValues).
+     *        Set to false (the default) to evaluate formulae whenever their calculated value is requested.
+     *
+     * @param    boolean    pValue
+     *
+     * @return    \ZExcel\Reader\IReader
+     */
+    public function setTrustCachedValues(boolean pValue = false) -> <\ZExcel\Reader\Abstrac>
+    {
+        let this->trustCachedValues = pValue;
+        
+        return this;
+    }
+
     /**
      * Read charts in workbook?
      *        If this is true, then the Reader will include any charts that exist in the workbook.
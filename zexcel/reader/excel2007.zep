@@ -310,6 +310,7 @@ class Excel2007 extends Abstrac implements IReader
             fileWorksheet, xmlSheet, sharedFormulas,
             xSplit, ySplit, sqref, col, i, c, r, att,
             sheetViewAttr, paneAttr, selectionAttr,
+            rowDimensions, columnDimensions, rowIndex, column,
             activeTab;
         
         if (!file_exists(pFilename)) {
@@ -713,31 +714,36 @@ class Excel2007 extends Abstrac implements IReader
                             }
 
                             if (isset(xmlSheet->cols) && !this->readDataOnly) {
+                                let columnDimensions = docSheet->getColumnDimensionStore();
+
                                 for col in iterator(xmlSheet->cols->col) {
                                     let col = reset(col);
                                     
                                     for i in range(intval(col["min"]) - 1, intval(col["max"]) - 1) {
+                                        // Write straight into the dimension store: no ColumnDimension object per column
+                                        let column = \ZExcel\Cell::stringFromColumnIndex(i);
+
                                         if (col["style"] && !this->readDataOnly) {
-                                            docSheet->getColumnDimension(\ZExcel\Cell::stringFromColumnIndex(i))->setXfIndex(intval(col["style"]));
+                                            columnDimensions->setXfIndex(column, intval(col["style"]));
                                         }
                                         
                                         // if (self::booleann(col["bestFit"])) {
-                                        //     docSheet->getColumnDimension(\ZExcel\Cell::stringFromColumnIndex(i))->setAutoSize(true);
+                                        //     columnDimensions->setFlag(column, \ZExcel\Worksheet\DimensionStore::FLAG_EXTRA);
                                         // }
                                         
                                         if (self::booleann(col["hidden"])) {
-                                            docSheet->getColumnDimension(\ZExcel\Cell::stringFromColumnIndex(i))->setVisible(false);
+                                            columnDimensions->setFlag(column, \ZExcel\Worksheet\DimensionStore::FLAG_HIDDEN);
                                         }
                                         
                                         if (self::booleann(col["collapsed"])) {
-                                            docSheet->getColumnDimension(\ZExcel\Cell::stringFromColumnIndex(i))->setCollapsed(true);
+                                            columnDimensions->setFlag(column, \ZExcel\Worksheet\DimensionStore::FLAG_COLLAPSED);
                                         }
                                         
                                         if (isset(col["outlineLevel"]) && col["outlineLevel"] > 0) {
-                                            docSheet->getColumnDimension(\ZExcel\Cell::stringFromColumnIndex(i))->setOutlineLevel(intval(col["outlineLevel"]));
+                                            columnDimensions->setOutlineLevel(column, intval(col["outlineLevel"]));
                                         }
                                         
-                                        docSheet->getColumnDimension(\ZExcel\Cell::stringFromColumnIndex(i))->setWidth(floatval(col["width"]));
+                                        columnDimensions->setSize(column, floatval(col["width"]));
 
                                         if (intval(col["max"]) == 16384) {
                                             break;
@@ -764,27 +770,31 @@ class Excel2007 extends Abstrac implements IReader
                             }
                             
                             if (xmlSheet && xmlSheet->sheetData && xmlSheet->sheetData->row) {
+                                // Write row attributes straight into the dimension store: no RowDimension object per row
+                                let rowDimensions = docSheet->getRowDimensionStore();
+
                                 for roww in iterator(xmlSheet->sheetData->row) {
                                     let row = reset(roww);
+                                    let rowIndex = intval(row["r"]);
                                     
                                     if (isset(row["ht"]) && !this->readDataOnly) {
-                                        docSheet->getRowDimension(intval(row["r"]))->setRowHeight(floatval(row["ht"]));
+                                        rowDimensions->setSize(rowIndex, floatval(row["ht"]));
                                     }
                                     
                                     if (self::booleann(row["hidden"]) && !this->readDataOnly) {
-                                        docSheet->getRowDimension(intval(row["r"]))->setVisible(false);
+                                        rowDimensions->setFlag(rowIndex, \ZExcel\Worksheet\DimensionStore::FLAG_HIDDEN);
                                     }
                                     
                                     if (self::booleann(row["collapsed"])) {
-                                        docSheet->getRowDimension(intval(row["r"]))->setCollapsed(true);
+                                        rowDimensions->setFlag(rowIndex, \ZExcel\Worksheet\DimensionStore::FLAG_COLLAPSED);
                                     }
                                     
                                     if (isset(row["outlineLevel"]) && row["outlineLevel"] > 0) {
-                                        docSheet->getRowDimension(intval(row["r"]))->setOutlineLevel(intval(row["outlineLevel"]));
+                                        rowDimensions->setOutlineLevel(rowIndex, intval(row["outlineLevel"]));
                                     }
                                     
                                     if (isset(row["s"]) && !this->readDataOnly) {
-                                        docSheet->getRowDimension(intval(row["r"]))->setXfIndex(intval(row["s"]));
+                                        rowDimensions->setXfIndex(rowIndex, intval(row["s"]));
                                     }
                                     
                                     for c in iterator(roww->c) {
@@ -940,6 +950,10 @@ class Excel2007 extends Abstrac implements IReader
         
         zip->close();
         
+        if (this->trustCachedValues) {
+            excel->getCalculationEngine()->setTrustCachedValues(true);
+        }
+        
         return excel;
     }
 
@@ -27,40 +27,26 @@ class ReferenceHelper
 
     public static function cellSort(var a, var b)
     {
-        var ac, ar, bc, br;
+        int packedA, packedB;
         
-        let ac = "";
-        let ar = "";
-        let bc = "";
-        let br = "";
-        
-        sscanf(a, "%[A-Z]%d", ac, ar);
-        sscanf(b, "%[A-Z]%d", bc, br);
+        let packedA = \ZExcel\Cell\Coordinate::parse(a);
+        let packedB = \ZExcel\Cell\Coordinate::parse(b);
 
-        if (ar == br) {
-            return strcasecmp(strlen(ac) . ac, strlen(bc) . bc);
+        if (packedA == packedB) {
+            return 0;
         }
         
-        return (ar < br) ? -1 : 1;
+        return (packedA < packedB) ? -1 : 1;
     }
 
     public static function cellReverseSort(var a, var b)
     {
-        var ac, ar, bc, br;
-        
-        let ac = "";
-        let ar = "";
-        let bc = "";
-        let br = "";
+        int packedA, packedB;
         
-        sscanf(a,"%[A-Z]%d", ac, ar);
-        sscanf(b,"%[A-Z]%d", bc, br);
+        let packedA = \ZExcel\Cell\Coordinate::parse(a);
+        let packedB = \ZExcel\Cell\Coordinate::parse(b);
 
-        if (ar == br) {
-            return 1 - strcasecmp(strlen(ac) . ac, strlen(bc) . bc);
-        }
-        
-        return (ar < br) ? 1 : -1;
+        return (packedA > packedB) ? -1 : 1;
     }
 
     private static function cellAddressInDeleteRange(var cellAddress, var beforeRow, var pNumRows, var beforeColumnIndex, var pNumCols)
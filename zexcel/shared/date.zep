@@ -6,6 +6,9 @@ class Date
     const CALENDAR_WINDOWS_1900 = 1900;        //    Base date of 1st Jan 1900 = 1.0
     const CALENDAR_MAC_1904 = 1904;            //    Base date of 2nd Jan 1904 = 1.0
 
+    /* Maximum number of format codes kept by isDateTimeFormatCode() */
+    const DATE_TIME_FORMAT_CODES_LIMIT = 4096;
+
     /*
      * Base calendar year to use for calculations
      *
@@ -15,6 +18,22 @@ class Date
     protected static excelBaseDate = self::CALENDAR_WINDOWS_1900;
     
     private static possibleDateFormatCharacters = "eymdHs";
+
+    /*
+     * Results of isDateTimeFormatCode(), indexed by format code
+     *
+     * @private
+     * @var    boolean[]
+     */
+    private static dateTimeFormatCodes = [];
+
+    /*
+     * DateTime at midnight 1st Jan 1970 in the default timezone, cloned by ExcelToPHPObject()
+     *
+     * @private
+     * @var    \DateTime
+     */
+    private static dateTimePrototype = null;
     
     /*
      * Names of the months of the year, indexed by shortname
@@ -137,19 +156,28 @@ class Date
      */
     public static function ExcelToPHPObject(double dateValue = 0) -> <\DateTime>
     {
-        var dateTime, days, time, hours, minutes, seconds, dateObj;
+        var civil, dateObj;
         
-        let dateTime = self::ExcelToPHP(dateValue);
+        let civil = self::excelToCivil(dateValue);
         
-        let days = floor(dateTime * (1 / 86400));
-        let time = round(((dateTime * (1 / 86400)) - days) * 86400);
-        let hours = round(time * (1 / 3600));
-        let minutes = round(time * (1 / 60)) - (hours * 60);
-        let seconds = round(time) - (hours * 3600) - (minutes * 60);
-
-        let dateObj = date_create("1-Jan-1970+" . days . " days");
+        //    A time without a date is taken on the current day
+        if (dateValue < 1) {
+            let civil[0] = (int) gmdate("Y");
+            let civil[1] = (int) gmdate("n");
+            let civil[2] = (int) gmdate("j");
+        }
         
-        dateObj->setTime(hours, minutes, seconds);
+        //    Fill in a clone rather than have DateTime parse a relative date string;
+        //        the prototype is rebuilt if the default timezone has changed
+        if (self::dateTimePrototype === null || self::dateTimePrototype->getTimezone()->getName() !== date_default_timezone_get()) {
+            let self::dateTimePrototype = new \DateTime("1970-01-01 00:00:00");
+        }
+        
+        let dateObj = clone self::dateTimePrototype;
+        
+        //    setDate() rolls Excel's fictitious 29-Feb-1900 over to 1st March, as ExcelToPHP() does
+        dateObj->setDate(civil[0], civil[1], civil[2]);
+        dateObj->setTime(civil[3], civil[4], civil[5]);
 
         return dateObj;
     }
@@ -167,39 +195,32 @@ class Date
      */
     public static function PHPToExcel(var dateValue = 0, var adjustToTimezone = false, var timezone = null)
     {
-        var saveTimeZone, retValue;
-        
-        let saveTimeZone = date_default_timezone_get();
-        
-        date_default_timezone_set("UTC");
-        
-        let retValue = false;
-        
         if ((is_object(dateValue)) && (dateValue instanceof \DateTime)) {
-            let retValue = self::FormattedPHPToExcel(
-                dateValue->format("Y"),
-                dateValue->format("m"),
-                dateValue->format("d"),
-                dateValue->format("H"),
-                dateValue->format("i"),
-                dateValue->format("s")
-            );
-        } else {
-            if (is_numeric(dateValue)) {
-                let retValue = self::FormattedPHPToExcel(
-                    date("Y",dateValue),
-                    date("m",dateValue),
-                    date("d",dateValue),
-                    date("H",dateValue),
-                    date("i",dateValue),
-                    date("s",dateValue)
-                );
-            }
+            //    Use the wall-clock time of the object, in its own timezone
+            return self::timestampToExcel(dateValue->getTimestamp() + dateValue->getOffset());
         }
         
-        date_default_timezone_set(saveTimeZone);
+        if (is_numeric(dateValue)) {
+            return self::timestampToExcel(floor(dateValue));
+        }
+
+        return false;
+    }
+
 
-        return retValue;
+    /**
+     * Convert a UST timestamp to an Excel serial date/time value
+     *
+     * @param    long    timestamp    PHP serialized date/time (UST)
+     * @return   double               Excel date/time value
+     */
+    public static function timestampToExcel(double timestamp) -> double
+    {
+        double days;
+        
+        let days = floor(timestamp / 86400);
+        
+        return self::unixDaysToExcel((int) days) + ((timestamp - days * 86400) / 86400);
     }
 
 
@@ -216,40 +237,136 @@ class Date
      */
     public static function FormattedPHPToExcel(var year, var month, var day, var hours = 0, var minutes = 0, var seconds = 0) -> double
     {
-        var excel1900isLeapYear, myexcelBaseDate, century, decade;
-        double excelDate, excelTime;
-    
+        double excelTime;
+        
+        let excelTime = (float) (((hours * 3600) + (minutes * 60) + seconds) / 86400);
+
+        return self::unixDaysToExcel(self::daysFromCivil((int) year, (int) month, (int) day)) + excelTime;
+    }
+
+
+    /**
+     * Split an Excel serial date/time value into its calendar fields
+     *
+     * The conversion is pure arithmetic, and honours the fictitious 29th February 1900 of the 1900 calendar.
+     *
+     * @param  double dateValue Excel date/time value
+     * @return array            [year, month, day, hours, minutes, seconds]
+     */
+    public static function excelToCivil(double dateValue) -> array
+    {
+        int serialDays, unixDays, seconds;
+        array civil;
+        
+        let serialDays = (int) floor(dateValue);
+        let seconds = (int) round((dateValue - serialDays) * 86400);
+        
+        if (seconds >= 86400) {
+            let serialDays = serialDays + 1;
+            let seconds = seconds - 86400;
+        }
+        
         if (self::excelBaseDate == self::CALENDAR_WINDOWS_1900) {
-            //
-            //    Fudge factor for the erroneous fact that the year 1900 is treated as a Leap Year in MS Excel
-            //    This affects every date following 28th February 1900
-            //
-            let excel1900isLeapYear = true;
-            if ((year == 1900) && (month <= 2)) {
-                let excel1900isLeapYear = false;
+            if (serialDays == 60) {
+                let civil = [1900, 2, 29];
+            } else {
+                //    Serials before the spurious 29-Feb-1900 (Day 60) are one day further from the base date
+                let unixDays = serialDays - 25569;
+                if (serialDays < 60) {
+                    let unixDays = unixDays + 1;
+                }
+                let civil = self::civilFromDays(unixDays);
             }
-            let myexcelBaseDate = 2415020;
         } else {
-            let myexcelBaseDate = 2416481;
-            let excel1900isLeapYear = false;
+            let civil = self::civilFromDays(serialDays - 24107);
         }
+        
+        let civil[] = (int) floor(seconds / 3600);
+        let civil[] = (int) floor((seconds % 3600) / 60);
+        let civil[] = seconds % 60;
+        
+        return civil;
+    }
 
-        //    Julian base date Adjustment
-        if (month > 2) {
-            let month = month - 3;
-        } else {
-            let month = month + 9;
-            let year = year - 1;
+
+    /**
+     * Convert a count of days since 1st Jan 1970 to an Excel serial day number
+     *
+     * @param  int    days
+     * @return int
+     */
+    private static function unixDaysToExcel(int days) -> int
+    {
+        if (self::excelBaseDate == self::CALENDAR_WINDOWS_1900) {
+            //    MS Excel treats 1900 as a leap year, so every date from 1st March 1900 (day -25508) is one day later
+            if (days < -25508) {
+                return days + 25568;
+            }
+            return days + 25569;
         }
+        
+        return days + 24107;
+    }
 
-        //    Calculate the Julian Date, then subtract the Excel base date (JD 2415020 = 31-Dec-1899 Giving Excel Date of 0)
-        let century = substr(year, 0, 2);
-        let decade = substr(year, 2, 2);
-        let excelDate = (float) (floor((146097 * century) / 4) + floor((1461 * decade) / 4) + floor((153 * month + 2) / 5) + day + 1721119 - myexcelBaseDate + excel1900isLeapYear);
 
-        let excelTime = (float) (((hours * 3600) + (minutes * 60) + seconds) / 86400);
+    /**
+     * Number of days from 1st Jan 1970 to a date of the proleptic Gregorian calendar
+     *
+     * @param  int    year
+     * @param  int    month
+     * @param  int    day
+     * @return int
+     */
+    private static function daysFromCivil(int year, int month, int day) -> int
+    {
+        int era, yearOfEra, dayOfYear, dayOfEra;
+        
+        if (month <= 2) {
+            let year = year - 1;
+            let month = month + 9;
+        } else {
+            let month = month - 3;
+        }
+        
+        let era = (int) floor(year / 400);
+        let yearOfEra = year - era * 400;
+        let dayOfYear = (int) floor((153 * month + 2) / 5) + day - 1;
+        let dayOfEra = yearOfEra * 365 + (int) floor(yearOfEra / 4) - (int) floor(yearOfEra / 100) + dayOfYear;
+        
+        return era * 146097 + dayOfEra - 719468;
+    }
+
 
-        return excelDate + excelTime;
+    /**
+     * Date of the proleptic Gregorian calendar for a number of days from 1st Jan 1970
+     *
+     * @param  int    days
+     * @return array  [year, month, day]
+     */
+    private static function civilFromDays(int days) -> array
+    {
+        int era, dayOfEra, yearOfEra, dayOfYear, mp, year, month, day;
+        
+        let days = days + 719468;
+        let era = (int) floor(days / 146097);
+        let dayOfEra = days - era * 146097;
+        let yearOfEra = (int) floor((dayOfEra - (int) floor(dayOfEra / 1460) + (int) floor(dayOfEra / 36524) - (int) floor(dayOfEra / 146096)) / 365);
+        let dayOfYear = dayOfEra - (365 * yearOfEra + (int) floor(yearOfEra / 4) - (int) floor(yearOfEra / 100));
+        let mp = (int) floor((5 * dayOfYear + 2) / 153);
+        let day = dayOfYear - (int) floor((153 * mp + 2) / 5) + 1;
+        
+        if (mp < 10) {
+            let month = mp + 3;
+        } else {
+            let month = mp - 9;
+        }
+        
+        let year = yearOfEra + era * 400;
+        if (month <= 2) {
+            let year = year + 1;
+        }
+        
+        return [year, month, day];
     }
 
 
@@ -262,8 +379,8 @@ class Date
     public static function isDateTime(<\ZExcel\Cell> pCell)
     {
         return self::isDateTimeFormat(
-            pCell->getWorksheet()->getStyle(
-                pCell->getCoordinate()
+            pCell->getWorksheet()->getParent()->getCellXfByIndex(
+                pCell->getXfIndex()
             )->getNumberFormat()
         );
     }
@@ -289,6 +406,31 @@ class Date
      * @return     boolean
      */
     public static function isDateTimeFormatCode(string pFormatCode = "") -> boolean
+    {
+        boolean isDateTime;
+        
+        if (isset(self::dateTimeFormatCodes[pFormatCode])) {
+            return self::dateTimeFormatCodes[pFormatCode];
+        }
+        
+        if (count(self::dateTimeFormatCodes) >= self::DATE_TIME_FORMAT_CODES_LIMIT) {
+            let self::dateTimeFormatCodes = [];
+        }
+        
+        let isDateTime = self::detectDateTimeFormatCode(pFormatCode);
+        let self::dateTimeFormatCodes[pFormatCode] = isDateTime;
+        
+        return isDateTime;
+    }
+
+
+    /**
+     * Scan a number format code for date/time characters
+     *
+     * @param     string    $pFormatCode
+     * @return     boolean
+     */
+    private static function detectDateTimeFormatCode(string pFormatCode) -> boolean
     {
         var segMatcher, subVal;
         
@@ -13,18 +13,17 @@ class Excel5
     */
     public static function sizeCol(<\ZExcel\Worksheet> sheet, var col = "A")
     {
-        var font, columnDimensions, columnDimension, defaultColumnDimension, width, pixelWidth, effectivePixelWidth;
+        var font, columnDimensions, defaultColumnDimension, width, pixelWidth, effectivePixelWidth;
         
         // default font of the workbook
         let font = sheet->getParent()->getDefaultStyle()->getFont();
 
-        let columnDimensions = sheet->getColumnDimensions();
+        let columnDimensions = sheet->getColumnDimensionStore();
 
         // first find the true column width in pixels (uncollapsed && unhidden)
-        if (isset(columnDimensions[col]) && columnDimensions[col]->getWidth() != -1) {
+        if (columnDimensions->getSize(col) != -1) {
             // then we have column dimension with explicit width
-            let columnDimension = columnDimensions[col];
-            let width = columnDimension->getWidth();
+            let width = columnDimensions->getSize(col);
             let pixelWidth = \ZExcel\Shared\Drawing::cellDimensionToPixels(width, font);
         } else {
             if (sheet->getDefaultColumnDimension()->getWidth() != -1) {
@@ -39,7 +38,7 @@ class Excel5
         }
         
         // now find the effective column width in pixels
-        if (isset(columnDimensions[col]) && !columnDimensions[col]->getVisible()) {
+        if (columnDimensions->hasFlag(col, \ZExcel\Worksheet\DimensionStore::FLAG_HIDDEN)) {
             let effectivePixelWidth = 0;
         } else {
             let effectivePixelWidth = pixelWidth;
@@ -59,18 +58,17 @@ class Excel5
      */
     public static function sizeRow(<\ZExcel\Worksheet> sheet, var row = 1)
     {
-        var font, rowDimensions, rowDimension, rowHeight, pixelRowHeight, defaultRowDimension, effectivePixelRowHeight, pointRowHeight;
+        var font, rowDimensions, rowHeight, pixelRowHeight, defaultRowDimension, effectivePixelRowHeight, pointRowHeight;
         
         // default font of the workbook
         let font = sheet->getParent()->getDefaultStyle()->getFont();
 
-        let rowDimensions = sheet->getRowDimensions();
+        let rowDimensions = sheet->getRowDimensionStore();
 
         // first find the true row height in pixels (uncollapsed && unhidden)
-        if (isset(rowDimensions[row]) && rowDimensions[row]->getRowHeight() != -1) {
+        if (rowDimensions->getSize(row) != -1) {
             // then we have a row dimension
-            let rowDimension = rowDimensions[row];
-            let rowHeight = rowDimension->getRowHeight();
+            let rowHeight = rowDimensions->getSize(row);
             let pixelRowHeight = (int) ceil(4 * rowHeight / 3); // here we assume Arial 10
         } else {
             if (sheet->getDefaultRowDimension()->getRowHeight() != -1) {
@@ -86,7 +84,7 @@ class Excel5
         }
         
         // now find the effective row height in pixels
-        if (isset(rowDimensions[row]) && !rowDimensions[row]->getVisible()) {
+        if (rowDimensions->hasFlag(row, \ZExcel\Worksheet\DimensionStore::FLAG_HIDDEN)) {
             let effectivePixelRowHeight = 0;
         } else {
             let effectivePixelRowHeight = pixelRowHeight;
@@ -107,6 +107,13 @@ class Font
         self::AUTOSIZE_METHOD_APPROX,
         self::AUTOSIZE_METHOD_EXACT
     ];
+
+    /**
+     * Measured column widths, indexed by font key, rotation and text
+     *
+     * @var array
+     */
+    private static columnWidthCache = [];
     
     /**
      * How wide is a default column for a given default font and size?
@@ -167,6 +174,7 @@ class Font
             return false;
         }
         let self::autoSizeMethod = pValue;
+        let self::columnWidthCache = [];
 
         return true;
     }
@@ -195,6 +203,7 @@ class Font
     public static function setTrueTypeFontPath(string pValue = "")
     {
         let self::trueTypeFontPath = pValue;
+        let self::columnWidthCache = [];
     }
 
     /**
@@ -265,6 +274,36 @@ class Font
         return round(columnWidth, 6);
     }
 
+    /**
+     * Calculate a column width like calculateColumnWidth(), remembering the result
+     *
+     * @param     string                   fontKey         Key identifying both font and defaultFont (e.g. their hash codes)
+     * @param     \ZExcel\Style\Font        font            Font object
+     * @param     string                   cellText        Text to calculate width
+     * @param     integer                  rotation        Rotation angle
+     * @param     \ZExcel\Style\Font|NULL   defaultFont     Font object
+     * @return     float        Column width
+     */
+    public static function measureColumnWidth(string fontKey, <\ZExcel\Style\Font> font, string cellText = "", int rotation = 0, <\ZExcel\Style\Font> defaultFont = null)
+    {
+        var key, width;
+        
+        let key = fontKey . ":" . rotation . ":" . cellText;
+        
+        if (isset(self::columnWidthCache[key])) {
+            return self::columnWidthCache[key];
+        }
+        
+        if (count(self::columnWidthCache) >= 65536) {
+            let self::columnWidthCache = [];
+        }
+        
+        let width = self::calculateColumnWidth(font, cellText, rotation, defaultFont);
+        let self::columnWidthCache[key] = width;
+        
+        return width;
+    }
+
     /**
      * Get GD text width in pixels for a string of text in a certain font at a certain rotation angle
      *
@@ -5,13 +5,6 @@ class Stringg
     const STRING_REGEXP_FRACTION = "(-?)(\d+)\s+(\d+\/\d+)";
 
 
-    /**
-     * Control characters array
-     *
-     * @var string[]
-     */
-    private static controlCharacters = [];
-
     /**
      * SYLK Characters array
      *
@@ -54,22 +47,6 @@ class Stringg
      */
     private static _isIconvEnabled;
 
-    /**
-     * Build control characters array
-     */
-    private static function _buildControlCharacters()
-    {
-        var i, find, replace;
-        
-        for i in range(0, 31) {
-            if (i != 9 && i != 10 && i != 13) {
-                let find = "_x" . sprintf("%04s" , strtoupper(dechex(i))) . "_";
-                let replace = chr(i);
-                let self::controlCharacters[find] = replace;
-            }
-        }
-    }
-
     /**
      * Build SYLK characters array
      */
@@ -296,10 +273,6 @@ class Stringg
 
     public static function buildCharacterSets()
     {
-        if(empty(self::controlCharacters)) {
-            self::_buildControlCharacters();
-        }
-        
         if(empty(self::_SYLKCharacters)) {
             self::_buildSYLKCharacters();
         }
@@ -321,11 +294,74 @@ class Stringg
      */
     public static function controlCharacterOOXML2PHP(var value = "") -> string
     {
-        return str_replace(
-            array_keys(self::controlCharacters),
-            array_values(self::controlCharacters),
-            value
-        );
+        var pos, decoded = "";
+        string text;
+        int length, position, offset = 0, code;
+
+        let text = (string) value;
+
+        // Most strings hold no escape sequence at all: return them untouched
+        let pos = strpos(text, "_x");
+
+        if (pos === false) {
+            return text;
+        }
+
+        let length = strlen(text);
+
+        while (pos !== false) {
+            let position = pos;
+
+            if (position + 7 <= length && text[position + 6] == '_') {
+                let code = self::controlCharacterFromHex(substr(text, position + 2, 4));
+
+                if (code >= 0) {
+                    let decoded .= substr(text, offset, position - offset) . chr(code);
+                    let offset = position + 7;
+                    let pos = strpos(text, "_x", offset);
+                    continue;
+                }
+            }
+
+            let pos = strpos(text, "_x", position + 1);
+        }
+
+        if (offset == 0) {
+            return text;
+        }
+
+        return decoded . substr(text, offset);
+    }
+
+    /**
+     * Decode the four hexadecimal digits of an _xHHHH_ escape sequence
+     *
+     * Only the uppercase escapes of the control characters (except tab, line feed
+     * and carriage return) are decoded, as written by controlCharacterPHP2OOXML
+     *
+     * @param string digits
+     * @return int Control character code, or -1 if the digits do not encode one
+     */
+    private static function controlCharacterFromHex(string digits) -> int
+    {
+        char ch;
+        int code = 0;
+
+        for ch in digits {
+            if (ch >= '0' && ch <= '9') {
+                let code = (code << 4) | (ch - '0');
+            } elseif (ch >= 'A' && ch <= 'F') {
+                let code = (code << 4) | (ch - 'A' + 10);
+            } else {
+                return -1;
+            }
+        }
+
+        if (code > 31 || code == 9 || code == 10 || code == 13) {
+            return -1;
+        }
+
+        return code;
     }
 
     /**
@@ -344,11 +380,31 @@ class Stringg
      */
     public static function controlCharacterPHP2OOXML(var value = "") -> string
     {
-        return str_replace(
-            array_values(self::controlCharacters),
-            array_keys(self::controlCharacters),
-            value
-        );
+        uchar ch;
+        var encoded = "";
+        int code, position = 0, offset = 0;
+        boolean escaped = false;
+        string text;
+
+        let text = (string) value;
+
+        for ch in text {
+            if (ch < 32 && ch != 9 && ch != 10 && ch != 13) {
+                let code = ch;
+                let encoded .= substr(text, offset, position - offset) . sprintf("_x%04X_", code);
+                let offset = position + 1;
+                let escaped = true;
+            }
+
+            let position++;
+        }
+
+        // Strings without control characters are returned untouched
+        if (!escaped) {
+            return text;
+        }
+
+        return encoded . substr(text, offset);
     }
 
     /**
@@ -676,7 +732,7 @@ class Stringg
                 if(self::mb_is_upper(character)) {
                     let characters[k] = mb_strtolower(character, "UTF-8");
                 } else {
-                    let character = mb_strtoupper(character, "UTF-8");
+                    let characters[k] = mb_strtoupper(character, "UTF-8");
                 }
             }
             return implode("", characters);
@@ -44,6 +44,9 @@ class NumberFormat extends Supervisor implements ZIComparable
     const FORMAT_CURRENCY_USD            = "#,##0_-";
     const FORMAT_CURRENCY_EUR_SIMPLE     = "[EUR ]#,##0.00_-";
 
+    /* Maximum number of compiled format codes kept in memory */
+    const COMPILED_FORMATS_LIMIT         = 4096;
+
     /**
      * Excel built-in number formats
      *
@@ -122,6 +125,13 @@ class NumberFormat extends Supervisor implements ZIComparable
         "h":  "g"
     ];
 
+    /**
+     * Compiled format codes, indexed by format code
+     *
+     * @var array
+     */
+    private static compiledFormats = [];
+
     /**
      * Format Code
      *
@@ -443,9 +453,15 @@ class NumberFormat extends Supervisor implements ZIComparable
         return "\\" . implode("\\", str_split(matches[1]));
     }
 
-    private static function formatAsDate(value, format)
+    /**
+     * Convert the date/time part of an Excel format code to a PHP date() mask
+     *
+     * @param string format Format code section
+     * @return string
+     */
+    private static function dateFormatMask(var format) -> string
     {
-        var key, blocks, dateObj;
+        var key, blocks;
         
         let format = preg_replace("/^(\[\$[A-Z]*-[0-9A-F]*\])/i", "", format);
 
@@ -473,37 +489,34 @@ class NumberFormat extends Supervisor implements ZIComparable
         let format = implode("\"", blocks);
 
         // escape any quoted characters so that DateTime format() will render them correctly
-        let format = preg_replace_callback("/\"(.*)\"/U", ["\\ZExcel\\Style\\NumberFormat", "escapeQuotesCallback"], format);
-
-        let dateObj = \ZExcel\Shared\Date::ExcelToPHPObject(value);
-        let value = dateObj->format(format);
-        
-        return [value, format];
+        return preg_replace_callback("/\"(.*)\"/U", ["\\ZExcel\\Style\\NumberFormat", "escapeQuotesCallback"], format);
     }
 
-    private static function formatAsPercentage(var value, var format)
+    /**
+     * Convert a percentage format code section to a sprintf() pattern
+     *
+     * @param string format Format code section
+     * @return string|null    Null for the plain "0%" format, which is rounded rather than printed
+     */
+    private static function percentageFormatPattern(var format)
     {
         var s;
         array m = [];
         
         if (format === self::FORMAT_PERCENTAGE) {
-            let value = round((100 * value), 0) . "%";
-        } else {
-            if (preg_match("/\.[#0]+/i", format, m)) {
-                let s = substr(m[0], 0, 1) . (strlen(m[0]) - 1);
-                let format = str_replace(m[0], s, format);
-            }
-            
-            if (preg_match("/^[#0]+/", format, m)) {
-                let format = str_replace(m[0], strlen(m[0]), format);
-            }
-            
-            let format = "%" . str_replace("%", "f%%", format);
-
-            let value = sprintf(format, 100 * value);
+            return null;
         }
         
-        return [value, format];
+        if (preg_match("/\.[#0]+/i", format, m)) {
+            let s = substr(m[0], 0, 1) . (strlen(m[0]) - 1);
+            let format = str_replace(m[0], s, format);
+        }
+        
+        if (preg_match("/^[#0]+/", format, m)) {
+            let format = str_replace(m[0], strlen(m[0]), format);
+        }
+        
+        return "%" . str_replace("%", "f%%", format);
     }
 
     private static function formatAsFraction(var value, var format)
@@ -598,6 +611,153 @@ class NumberFormat extends Supervisor implements ZIComparable
         return result;
     }
 
+    /**
+     * Compile a format code into its sections
+     *
+     * All the regular expression work on the format code happens here, once per distinct code;
+     * toFormattedString() then only performs the value-dependent steps of the selected section.
+     *
+     * @param string format Format code
+     * @return array
+     */
+    public static function compileFormatCode(string format) -> array
+    {
+        var sections, section;
+        array program = [];
+        
+        // Convert any other escaped characters to quoted strings, e.g. (\T to "T")
+        let format = preg_replace("/(\\\(.))(?=(?:[^\"]|\"[^\"]*\")*$)/u", "\"${2}\"", format);
+
+        // Get the sections, there can be up to four sections, separated with a semi-colon (but only if not a quoted literal)
+        let sections = preg_split("/(;)(?=(?:[^\"]|\"[^\"]*\")*$)/u", format);
+        
+        for section in sections {
+            let program[] = self::compileFormatSection(section);
+        }
+        
+        return program;
+    }
+
+    /**
+     * Compile a single section of a format code
+     *
+     * @param string format Format code section
+     * @return array
+     */
+    private static function compileFormatSection(var format) -> array
+    {
+        var useThousands, number_regex, currencyCode, scale, left, dec, right, minWidth;
+        array compiled, matches, m;
+        
+        // In Excel formats, "_" is used to add spacing,
+        //    The following character indicates the size of the spacing, which we can"t do in HTML, so we just use a standard space
+        let format = preg_replace("/_./", " ", format);
+
+        // Save format with color information for the callback
+        let compiled = ["type": "number", "color": format, "currency": null];
+
+        // Strip color information
+        let format = preg_replace("/^\\[[a-zA-Z]+\\]/", "", format);
+
+        //  Check for date/time characters (not inside quotes)
+        let matches = [];
+        if (preg_match("/(\\[\\$[A-Z]*-[0-9A-F]*\\])*[hmsdy](?=(?:[^\"]|\"[^\"]*\")*$)/miu", format, matches)) {
+            let compiled["type"] = "date";
+            let compiled["mask"] = self::dateFormatMask(format);
+            
+            return compiled;
+        }
+        
+        if (preg_match("/%$/", format)) {
+            let compiled["type"] = "percentage";
+            let compiled["pattern"] = self::percentageFormatPattern(format);
+            
+            return compiled;
+        }
+        
+        if (format === self::FORMAT_CURRENCY_EUR_SIMPLE) {
+            let compiled["type"] = "eur";
+            
+            return compiled;
+        }
+        
+        // Some non-number strings are quoted, so we"ll get rid of the quotes, likewise any positional * symbols
+        let format = str_replace(["\"", "*"], "", format);
+
+        // Find out if we need thousands separator
+        // This is indicated by a comma enclosed by a digit placeholder:
+        //        #,#   or   0,0
+        let useThousands = preg_match("/(#,#|0,0)/", format);
+        
+        if (useThousands) {
+            let format = preg_replace("/0,0/", "00", format);
+            let format = preg_replace("/#,#/", "##", format);
+        }
+
+        // Scale thousands, millions,...
+        // This is indicated by a number of commas after a digit placeholder:
+        //        #,   or    0.0,,
+        let scale = 1; // same as no scale
+        let matches = [];
+        
+        if (preg_match("/(#|0)(,+)/", format, matches)) {
+            let scale = pow(1000, strlen(matches[2]));
+
+            // strip the commas
+            let format = preg_replace("/0,+/", strval(0), format);
+            let format = preg_replace("/#,+/", "#", format);
+        }
+        
+        let m = [];
+        
+        if (preg_match("/#?.*\\?\/\\?/", format, m)) {
+            let compiled["type"] = "fraction";
+            let compiled["format"] = format;
+        } else {
+            let compiled["scale"] = scale;
+            let compiled["mode"] = "none";
+
+            // Strip #
+            let format = preg_replace("/\\#/", strval(0), format);
+
+            let number_regex = "/(0+)(\\.?)(0*)/";
+            let matches = [];
+            
+            if (preg_match(number_regex, preg_replace("/\\[[^\\]]+\\]/", "", format), matches)) {
+                let left = matches[1];
+                let dec = matches[2];
+                let right = matches[3];
+
+                // minimun width of formatted number (including dot)
+                let minWidth = strlen(left) + strlen(dec) + strlen(right);
+                
+                // the literal text around the digit placeholders, so the number can be put back with implode()
+                let compiled["literals"] = preg_split(number_regex, format);
+                let compiled["decimals"] = strlen(right);
+                
+                if (useThousands) {
+                    let compiled["mode"] = "thousands";
+                } elseif (preg_match("/[0#]E[+-]0/i", format)) {
+                    let compiled["mode"] = "scientific";
+                } elseif (preg_match("/0([^\\d\\.]+)0/", format)) {
+                    let compiled["mode"] = "mask";
+                    let compiled["format"] = format;
+                } else {
+                    let compiled["mode"] = "fixed";
+                    let compiled["pattern"] = "%0" . minWidth . "." . strlen(right) . "f";
+                }
+            }
+        }
+        
+        if (preg_match("/\\[\\$(.*)\\]/u", format, m)) {
+            //  Currency or Accounting; an empty code falls back to the locale currency at format time
+            let currencyCode = m[1];
+            let compiled["currency"] = current(explode("-", currencyCode));
+        }
+        
+        return compiled;
+    }
+
     /**
      * Convert a value in a pre-defined format to a PHP string
      *
@@ -608,9 +768,7 @@ class NumberFormat extends Supervisor implements ZIComparable
      */
     public static function toFormattedString(var value = "0", var format = \ZExcel\Style\NumberFormat::FORMAT_GENERAL, var callback = null)
     {
-        var sections, formatColor, color_regex, useThousands, n, m, number_regex, currencyFormat, currencyCode,
-            scale, left, dec, right, minWidth, sprintf_pattern, writerInstance, functionn;
-        array matches;
+        var program, section, currencyCode, writerInstance, functionn, tmp;
         
         // For now we do not treat strings although section 4 of a format code affects strings
         if (!is_numeric(value)) {
@@ -622,12 +780,17 @@ class NumberFormat extends Supervisor implements ZIComparable
         if ((format === \ZExcel\Style\NumberFormat::FORMAT_GENERAL) || (format === \ZExcel\Style\NumberFormat::FORMAT_TEXT)) {
             return value;
         }
-
-        // Convert any other escaped characters to quoted strings, e.g. (\T to "T")
-        let format = preg_replace("/(\\\(.))(?=(?:[^\"]|\"[^\"]*\")*$)/u", "\"${2}\"", format);
-
-        // Get the sections, there can be up to four sections, separated with a semi-colon (but only if not a quoted literal)
-        let sections = preg_split("/(;)(?=(?:[^\"]|\"[^\"]*\")*$)/u", format);
+        
+        if (isset(self::compiledFormats[format])) {
+            let program = self::compiledFormats[format];
+        } else {
+            if (count(self::compiledFormats) >= self::COMPILED_FORMATS_LIMIT) {
+                let self::compiledFormats = [];
+            }
+            
+            let program = self::compileFormatCode(format);
+            let self::compiledFormats[format] = program;
+        }
 
         // Extract the relevant section depending on whether number is positive, negative, or zero?
         // Text not supported yet.
@@ -636,181 +799,92 @@ class NumberFormat extends Supervisor implements ZIComparable
         //   2 sections:  [POSITIVE/ZERO/TEXT] [NEGATIVE]
         //   3 sections:  [POSITIVE/TEXT] [NEGATIVE] [ZERO]
         //   4 sections:  [POSITIVE] [NEGATIVE] [ZERO] [TEXT]
-        switch (count(sections)) {
-            case 1:
-                let format = sections[0];
-                break;
+        switch (count(program)) {
             case 2:
-                let format = (value >= 0) ? sections[0] : sections[1];
+                let section = (value >= 0) ? program[0] : program[1];
                 let value = abs(value); // Use the absolute value
                 break;
             case 3:
-                if (value > 0) {
-                    let format = sections[0];
-                } else {
-                    if (value < 0) {
-                        let format = sections[1];
-                    } else {
-                        let format = sections[2];
-                    }
-                }
-                
-                let value = abs(value); // Use the absolute value
-                break;
             case 4:
                 if (value > 0) {
-                    let format = sections[0];
+                    let section = program[0];
+                } elseif (value < 0) {
+                    let section = program[1];
                 } else {
-                    if (value < 0) {
-                        let format = sections[1];
-                    } else {
-                        let format = sections[2];
-                    }
+                    let section = program[2];
                 }
                 
                 let value = abs(value); // Use the absolute value
                 break;
             default:
-                // something is wrong, just use first section
-                let format = sections[0];
+                // a single section, or something is wrong: just use first section
+                let section = program[0];
                 break;
         }
         
-        // In Excel formats, "_" is used to add spacing,
-        //    The following character indicates the size of the spacing, which we can"t do in HTML, so we just use a standard space
-        let format = preg_replace("/_./", " ", format);
-
-        // Save format with color information for later use below
-        let formatColor = format;
-
-        // Strip color information
-        let color_regex = "/^\\[[a-zA-Z]+\\]/";
-        let format = preg_replace(color_regex, "", format);
-
-        // Let"s begin inspecting the format and converting the value to a formatted string
-
-        //  Check for date/time characters (not inside quotes)
-        let matches = [];
-        if (preg_match("/(\\[\\$[A-Z]*-[0-9A-F]*\\])*[hmsdy](?=(?:[^\"]|\"[^\"]*\")*$)/miu", format, matches)) {
-            // datetime format
-            let sections = self::formatAsDate(value, format);
-            let value = sections[0];
-            let format = sections[1];
-        } else {
-            if (preg_match("/%$/", format)) {
-                // % number format
-                var sections = self::formatAsPercentage(value, format);
-                let value = sections[0];
-                let format = sections[1];
-            } else {
-                if (format === self::FORMAT_CURRENCY_EUR_SIMPLE) {
-                    let value = "EUR " . sprintf("%1.2f", value);
+        switch (section["type"]) {
+            case "date":
+                let value = gmdate(section["mask"], \ZExcel\Shared\Date::ExcelToPHP(value));
+                break;
+            case "percentage":
+                if (section["pattern"] === null) {
+                    let value = round((100 * value), 0) . "%";
                 } else {
-                    // Some non-number strings are quoted, so we"ll get rid of the quotes, likewise any positional * symbols
-                    let format = str_replace(["\"", "*"], "", format);
-    
-                    // Find out if we need thousands separator
-                    // This is indicated by a comma enclosed by a digit placeholder:
-                    //        #,#   or   0,0
-                    let useThousands = preg_match("/(#,#|0,0)/", format);
-                    
-                    if (useThousands) {
-                        let format = preg_replace("/0,0/", "00", format);
-                        let format = preg_replace("/#,#/", "##", format);
-                    }
-    
-                    // Scale thousands, millions,...
-                    // This is indicated by a number of commas after a digit placeholder:
-                    //        #,   or    0.0,,
-                    let scale = 1; // same as no scale
-                    let matches = [];
-                    
-                    if (preg_match("/(#|0)(,+)/", format, matches)) {
-                        let scale = pow(1000, strlen(matches[2]));
-    
-                        // strip the commas
-                        let format = preg_replace("/0,+/", strval(0), format);
-                        let format = preg_replace("/#,+/", "#", format);
-                    }
-                    
-                    let m = [];
-                    
-                    if (preg_match("/#?.*\\?\/\\?/", format, m)) {
-                        if (value != (int) value) {
-                            let sections = self::formatAsFraction(value, format);
-                            let value  = sections[0];
-                            let format = sections[1];
-                        }
-                    } else {
-                        // Handle the number itself
-    
-                        // scale number
-                        let value = value / scale;
-    
-                        // Strip #
-                        let format = preg_replace("/\\#/", strval(0), format);
-    
-                        let n = "/\\[[^\\]]+\\]/";
-                        let m = preg_replace(n, "", format);
-                        let number_regex = "/(0+)(\\.?)(0*)/";
-                        let matches = [];
-                        
-                        if (preg_match(number_regex, m, matches)) {
-                            let left = matches[1];
-                            let dec = matches[2];
-                            let right = matches[3];
-    
-                            // minimun width of formatted number (including dot)
-                            let minWidth = strlen(left) + strlen(dec) + strlen(right);
-                            if (useThousands) {
-                                let value = number_format(
-                                    value,
-                                    strlen(right),
-                                    \ZExcel\Shared\Stringg::getDecimalSeparator(),
-                                    \ZExcel\Shared\Stringg::getThousandsSeparator()
-                                );
-                                let value = preg_replace(number_regex, value, format);
-                            } else {
-                                if (preg_match("/[0#]E[+-]0/i", format)) {
-                                    //    Scientific format
-                                    let value = sprintf("%5.2E", value);
-                                } else {
-                                    if (preg_match("/0([^\\d\\.]+)0/", format)) {
-                                        let value = self::complexNumberFormatMask(value, format);
-                                    } else {
-                                        let sprintf_pattern = "%0" . minWidth . "." . strlen(right) . "f";
-                                        let value = sprintf(sprintf_pattern, value);
-                                        let value = preg_replace(number_regex, value, format);
-                                    }
-                                }
-                            }
-                        }
-                    }
+                    let value = sprintf(section["pattern"], 100 * value);
+                }
+                break;
+            case "eur":
+                let value = "EUR " . sprintf("%1.2f", value);
+                break;
+            case "fraction":
+                if (value != (int) value) {
+                    let tmp = self::formatAsFraction(value, section["format"]);
+                    let value = tmp[0];
+                }
+                break;
+            default:
+                // scale number
+                let value = value / section["scale"];
                 
-                    if (preg_match("/\\[\\$(.*)\\]/u", format, m)) {
-                        //  Currency or Accounting
-                        let currencyFormat = m[0];
-                        let currencyCode = m[1];
-                        let currencyCode = current(explode("-", currencyCode));
-                        
-                        if (currencyCode == "") {
-                            let currencyCode = \ZExcel\Shared\Stringg::getCurrencyCode();
-                        }
-                        
-                        let value = preg_replace("/\\[\\$([^\\]]*)\\]/u", currencyCode, value);
-                    }
+                switch (section["mode"]) {
+                    case "thousands":
+                        let value = number_format(
+                            value,
+                            section["decimals"],
+                            \ZExcel\Shared\Stringg::getDecimalSeparator(),
+                            \ZExcel\Shared\Stringg::getThousandsSeparator()
+                        );
+                        let value = implode(value, section["literals"]);
+                        break;
+                    case "scientific":
+                        //    Scientific format
+                        let value = sprintf("%5.2E", value);
+                        break;
+                    case "mask":
+                        let value = self::complexNumberFormatMask(value, section["format"]);
+                        break;
+                    case "fixed":
+                        let value = implode(sprintf(section["pattern"], value), section["literals"]);
+                        break;
                 }
-            }
+                break;
         }
         
-        // Escape any escaped slashes to a single slash
-        let format = preg_replace("/\\\\/u", "\\", format);
+        if (section["currency"] !== null) {
+            let currencyCode = section["currency"];
+            
+            if (currencyCode == "") {
+                let currencyCode = \ZExcel\Shared\Stringg::getCurrencyCode();
+            }
+            
+            let value = preg_replace("/\\[\\$([^\\]]*)\\]/u", currencyCode, value);
+        }
 
         // Additional formatting provided by callback function
         if (callback !== null) {
             let writerInstance = callback[0];
             let functionn = callback[1];
-            let value = writerInstance->{functionn}(value, formatColor);
+            let value = writerInstance->{functionn}(value, section["color"]);
         }
         
         return value;
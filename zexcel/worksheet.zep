@@ -34,11 +34,11 @@ class Worksheet implements IComparable
     private cellCollection = null;
 
     /**
-     * Collection of row dimensions
+     * Row dimensions, held as plain values and viewed through RowDimension objects on demand
      *
-     * @var \ZExcel\Worksheet\RowDimension[]
+     * @var \ZExcel\Worksheet\DimensionStore
      */
-    private rowDimensions = [];
+    private rowDimensionStore;
 
     /**
      * Default row dimension
@@ -48,11 +48,11 @@ class Worksheet implements IComparable
     private _defaultRowDimension = null;
 
     /**
-     * Collection of column dimensions
+     * Column dimensions, held as plain values and viewed through ColumnDimension objects on demand
      *
-     * @var \ZExcel\Worksheet\ColumnDimension[]
+     * @var \ZExcel\Worksheet\DimensionStore
      */
-    private columnDimensions = [];
+    private columnDimensionStore;
 
     /**
      * Default column dimension
@@ -132,18 +132,18 @@ class Worksheet implements IComparable
     private _styles = [];
 
     /**
-     * Conditional styles. Indexed by cell coordinate, e.g. "A1"
+     * Conditional styles. Indexed by cell coordinate or range list, e.g. "A1" or "A1:A100 C1:C100"
      *
      * @var array
      */
     private conditionalStylesCollection = [];
 
     /**
-     * Is the current cell collection sorted already?
+     * Spatial index over the conditional styles collection keys, built on first lookup
      *
-     * @var boolean
+     * @var \ZExcel\Worksheet\RangeIndex
      */
-    private cellCollectionIsSorted = false;
+    private conditionalStylesIndex = null;
 
     /**
      * Collection of breaks
@@ -159,6 +159,13 @@ class Worksheet implements IComparable
      */
     private mergeCells = [];
 
+    /**
+     * Spatial index over the merged cell ranges, built on demand
+     *
+     * @var \ZExcel\Worksheet\MergeIndex
+     */
+    private mergeIndex = null;
+
     /**
      * Collection of protected cell ranges
      *
@@ -250,6 +257,41 @@ class Worksheet implements IComparable
      */
     private cachedHighestRow = 1;
 
+    /**
+     * Measured widths of the cells in auto-size columns, indexed by column then coordinate
+     *
+     * @var array
+     */
+    private autoSizeCellWidths = [];
+
+    /**
+     * Cells of auto-size columns written since they were last measured, indexed by column then coordinate
+     *
+     * @var array
+     */
+    private autoSizeDirtyCells = [];
+
+    /**
+     * Formula cells of auto-size columns, which are measured again on every calculation
+     *
+     * @var array
+     */
+    private autoSizeFormulaCells = [];
+
+    /**
+     * Font, format code and rotation per xf index, for the current column width calculation
+     *
+     * @var array
+     */
+    private autoSizeStyles = [];
+
+    /**
+     * Style signature (fonts, format code and rotation) of each xf index used by the measured cell widths
+     *
+     * @var string[]
+     */
+    private autoSizeStyleSignatures = [];
+
     /**
      * Right-to-left?
      *
@@ -265,12 +307,19 @@ class Worksheet implements IComparable
     private _hyperlinkCollection = [];
 
     /**
-     * Data validation objects. Indexed by cell coordinate, e.g. "A1"
+     * Data validation objects. Indexed by cell coordinate or range list, e.g. "A1" or "A1:A100 C1:C100"
      *
      * @var array
      */
     private _dataValidationCollection = [];
 
+    /**
+     * Spatial index over the data validation collection keys, built on first lookup
+     *
+     * @var \ZExcel\Worksheet\RangeIndex
+     */
+    private dataValidationIndex = null;
+
     /**
      * Tab color
      *
@@ -339,6 +388,10 @@ class Worksheet implements IComparable
         // Protection
         let this->protection = new \ZExcel\Worksheet\Protection();
 
+        // Row and column dimensions: rows are unformatted by default, columns use the default style
+        let this->rowDimensionStore = new \ZExcel\Worksheet\DimensionStore(\ZExcel\Worksheet\DimensionStore::ROWS, null);
+        let this->columnDimensionStore = new \ZExcel\Worksheet\DimensionStore(\ZExcel\Worksheet\DimensionStore::COLUMNS, 0);
+
         // Default row dimension
         let this->_defaultRowDimension = new \ZExcel\Worksheet\RowDimension(null);
 
@@ -370,7 +423,15 @@ class Worksheet implements IComparable
      */
     public function __destruct()
     {
-        \ZExcel\Calculation::getInstance(this->parent)->clearCalculationCacheForWorksheet(this->title);
+        var calculation;
+        
+        if (this->parent !== null) {
+            let calculation = \ZExcel\Calculation::getExistingInstance(this->parent);
+            
+            if (calculation !== null) {
+                calculation->clearCalculationCacheForWorksheet(this->title);
+            }
+        }
 
         this->disconnectCells();
     }
@@ -496,7 +557,19 @@ class Worksheet implements IComparable
      */
     public function getRowDimensions()
     {
-        return this->rowDimensions;
+        return this->rowDimensionStore->getViews();
+    }
+
+    /**
+     * Get the store holding the row dimensions
+     *
+     * Reading and writing row dimensions through the store does not create any RowDimension object
+     *
+     * @return \ZExcel\Worksheet\DimensionStore
+     */
+    public function getRowDimensionStore() -> <\ZExcel\Worksheet\DimensionStore>
+    {
+        return this->rowDimensionStore;
     }
 
     /**
@@ -516,7 +589,19 @@ class Worksheet implements IComparable
      */
     public function getColumnDimensions()
     {
-        return this->columnDimensions;
+        return this->columnDimensionStore->getViews();
+    }
+
+    /**
+     * Get the store holding the column dimensions
+     *
+     * Reading and writing column dimensions through the store does not create any ColumnDimension object
+     *
+     * @return \ZExcel\Worksheet\DimensionStore
+     */
+    public function getColumnDimensionStore() -> <\ZExcel\Worksheet\DimensionStore>
+    {
+        return this->columnDimensionStore;
     }
 
     /**
@@ -657,16 +742,7 @@ class Worksheet implements IComparable
      */
     public function refreshColumnDimensions()
     {
-        var currentColumnDimensions, objColumnDimension;
-        array newColumnDimensions = [];
-        
-        let currentColumnDimensions = this->getColumnDimensions();
-
-        for objColumnDimension in currentColumnDimensions {
-            let newColumnDimensions[objColumnDimension->getColumnIndex()] = objColumnDimension;
-        }
-
-        let this->columnDimensions = newColumnDimensions;
+        this->columnDimensionStore->reindexViews();
 
         return this;
     }
@@ -678,16 +754,7 @@ class Worksheet implements IComparable
      */
     public function refreshRowDimensions()
     {
-        var currentRowDimensions, objRowDimension;
-        array newRowDimensions = [];
-        
-        let currentRowDimensions = this->getRowDimensions();
-
-        for objRowDimension in currentRowDimensions {
-            let newRowDimensions[objRowDimension->getRowIndex()] = objRowDimension;
-        }
-
-        let this->rowDimensions = newRowDimensions;
+        this->rowDimensionStore->reindexViews();
 
         return this;
     }
@@ -717,62 +784,88 @@ class Worksheet implements IComparable
     /**
      * Calculate widths for auto-size columns
      *
+     * Widths are tracked per cell and only re-measured for cells written since the previous calculation,
+     * so the first calculation scans each auto-size column and later ones cost O(changed cells).
+     *
      * @param  boolean  calculateMergeCells  Calculate merge cell width
      * @return \ZExcel\Worksheet;
      */
     public function calculateColumnWidths(boolean calculateMergeCells = false)
     {
-        // initialize autoSizes array
-        var colDimension, cells, cell, cellID, cellValue, cellReference, columnIndex, width;
-        array autoSizes = [], isMergeCell = [];
+        var cellID, column, columnIndex, width, mergeIndex, defaultFont;
+        array autoSizes = [], fullScan = [];
         
-        for colDimension in this->getColumnDimensions() {
-            if (colDimension->getAutoSize()) {
-                let autoSizes[colDimension->getColumnIndex()] = -1;
+        for column in this->columnDimensionStore->getKeys() {
+            if (this->columnDimensionStore->hasFlag(column, \ZExcel\Worksheet\DimensionStore::FLAG_EXTRA)) {
+                let autoSizes[column] = -1;
+            }
+        }
+
+        // Forget about columns that are no longer auto-sized
+        for column, _ in this->autoSizeCellWidths {
+            if (!isset(autoSizes[column])) {
+                unset(this->autoSizeCellWidths[column]);
+                unset(this->autoSizeDirtyCells[column]);
+                unset(this->autoSizeFormulaCells[column]);
             }
         }
 
         // There is only something to do if there are some auto-size columns
         if (!empty(autoSizes)) {
-            // build list of cells references that participate in a merge
-            for cells in this->getMergeCells() {
-                for cellReference in \ZExcel\Cell::extractAllCellReferencesInRange(cells) {
-                    let isMergeCell[cellReference] = true;
+            let mergeIndex = this->getMergeIndex();
+            let defaultFont = this->getDefaultStyle()->getFont();
+            let this->autoSizeStyles = [];
+            
+            // A style edited in place (e.g. the default font) changes the width of cells that were not written
+            if (this->autoSizeStylesChanged(defaultFont)) {
+                this->resetAutoSizeTracking();
+            }
+            
+            for column, _ in autoSizes {
+                if (!isset(this->autoSizeCellWidths[column])) {
+                    let fullScan[column] = true;
+                    let this->autoSizeCellWidths[column] = [];
+                    let this->autoSizeFormulaCells[column] = [];
                 }
             }
-
-            // loop through all cells in the worksheet
-            for cellID in this->getCellCollection(false) {
-                
-                let cell = this->getCell(cellID, false);
+            
+            // Columns measured for the first time need every one of their cells
+            if (!empty(fullScan)) {
+                for cellID in this->getCellCollection(false) {
+                    let column = rtrim(cellID, "0123456789");
+                    
+                    if (isset(fullScan[column])) {
+                        this->measureAutoSizeCell(cellID, column, mergeIndex, defaultFont);
+                    }
+                }
+            }
+            
+            for column, _ in autoSizes {
+                if (isset(fullScan[column])) {
+                    continue;
+                }
                 
-                if (cell !== null && isset(autoSizes[this->cellCollection->getCurrentColumn()])) {
-                    // Determine width if cell does not participate in a merge
-                    if (!isset(isMergeCell[this->cellCollection->getCurrentAddress()])) {
-                        // Calculated value
-                        // To formatted string
-                        let cellValue = \ZExcel\Style\NumberFormat::toFormattedString(
-                            cell->getCalculatedValue(),
-                            this->getParent()->getCellXfByIndex(cell->getXfIndex())->getNumberFormat()->getFormatCode()
-                        );
-
-                        let autoSizes[this->cellCollection->getCurrentColumn()] = max(
-                            (float) autoSizes[this->cellCollection->getCurrentColumn()],
-                            (float) \ZExcel\Shared\Font::calculateColumnWidth(
-                                this->getParent()->getCellXfByIndex(cell->getXfIndex())->getFont(),
-                                cellValue,
-                                this->getParent()->getCellXfByIndex(cell->getXfIndex())->getAlignment()->getTextRotation(),
-                                this->getDefaultStyle()->getFont()
-                            )
-                        );
+                if (isset(this->autoSizeDirtyCells[column])) {
+                    for cellID, _ in this->autoSizeDirtyCells[column] {
+                        this->measureAutoSizeCell(cellID, column, mergeIndex, defaultFont);
                     }
                 }
+                
+                // A formula result may change without the cell itself being written
+                for cellID, _ in this->autoSizeFormulaCells[column] {
+                    this->measureAutoSizeCell(cellID, column, mergeIndex, defaultFont);
+                }
             }
+            
+            let this->autoSizeDirtyCells = [];
+            let this->autoSizeStyles = [];
 
             // adjust column widths
-            for columnIndex, width in autoSizes {
-                if (width == -1) {
+            for columnIndex, _ in autoSizes {
+                if (empty(this->autoSizeCellWidths[columnIndex])) {
                     let width = this->getDefaultColumnDimension()->getWidth();
+                } else {
+                    let width = max(this->autoSizeCellWidths[columnIndex]);
                 }
                 
                 this->getColumnDimension(columnIndex)->setWidth(width);
@@ -782,6 +875,192 @@ class Worksheet implements IComparable
         return this;
     }
 
+    /**
+     * Measure the width of a single cell of an auto-size column
+     *
+     * @param string                          pCoordinate    Coordinate of the cell
+     * @param string                          column         Column of the cell
+     * @param \ZExcel\Worksheet\MergeIndex     mergeIndex     Merged cell ranges of the worksheet
+     * @param \ZExcel\Style\Font               defaultFont    Default font of the workbook
+     */
+    private function measureAutoSizeCell(string pCoordinate, string column, <\ZExcel\Worksheet\MergeIndex> mergeIndex, <\ZExcel\Style\Font> defaultFont)
+    {
+        var cell, coordinates, xfIndex, style, cellStyle, cellValue, cells;
+        
+        let cell = this->cellCollection->getCacheData(pCoordinate);
+        
+        if (cell === null) {
+            this->forgetAutoSizeCell(pCoordinate, column);
+            return;
+        }
+        
+        // Cells participating in a merge do not contribute to the column width
+        if (!mergeIndex->isEmpty()) {
+            let coordinates = \ZExcel\Cell::coordinateFromString(pCoordinate);
+            
+            if (mergeIndex->contains(\ZExcel\Cell::columnIndexFromString(coordinates[0]), coordinates[1])) {
+                this->forgetAutoSizeCell(pCoordinate, column);
+                return;
+            }
+        }
+        
+        let xfIndex = cell->getXfIndex();
+        
+        if (!isset(this->autoSizeStyles[xfIndex])) {
+            let style = this->parent->getCellXfByIndex(xfIndex);
+            let this->autoSizeStyles[xfIndex] = [
+                style->getFont(),
+                style->getNumberFormat()->getFormatCode(),
+                style->getAlignment()->getTextRotation(),
+                style->getFont()->getHashCode() . defaultFont->getHashCode()
+            ];
+            let this->autoSizeStyleSignatures[xfIndex] = this->autoSizeStyleSignature(style, defaultFont);
+        }
+        
+        let cellStyle = this->autoSizeStyles[xfIndex];
+        
+        let cellValue = \ZExcel\Style\NumberFormat::toFormattedString(cell->getCalculatedValue(), cellStyle[1]);
+        
+        if (is_object(cellValue) && cellValue instanceof \ZExcel\RichText) {
+            let cellValue = cellValue->getPlainText();
+        }
+        
+        let this->autoSizeCellWidths[column][pCoordinate] = (float) \ZExcel\Shared\Font::measureColumnWidth(
+            cellStyle[3],
+            cellStyle[0],
+            (string) cellValue,
+            cellStyle[2],
+            defaultFont
+        );
+        
+        if (cell->isFormula()) {
+            let this->autoSizeFormulaCells[column][pCoordinate] = true;
+        } elseif (isset(this->autoSizeFormulaCells[column][pCoordinate])) {
+            let cells = this->autoSizeFormulaCells[column];
+            unset(cells[pCoordinate]);
+            let this->autoSizeFormulaCells[column] = cells;
+        }
+    }
+
+    /**
+     * Signature of the parts of a style that affect the measured width of a cell
+     *
+     * @param \ZExcel\Style       style       Style of the cell
+     * @param \ZExcel\Style\Font  defaultFont Default font of the workbook
+     * @return string
+     */
+    private function autoSizeStyleSignature(<\ZExcel\Style> style, <\ZExcel\Style\Font> defaultFont) -> string
+    {
+        return style->getFont()->getHashCode() . ":" . defaultFont->getHashCode() . ":"
+            . style->getNumberFormat()->getFormatCode() . ":" . style->getAlignment()->getTextRotation();
+    }
+
+    /**
+     * Has a style used by the measured cell widths changed since the cells were measured?
+     *
+     * @param \ZExcel\Style\Font defaultFont Default font of the workbook
+     * @return boolean
+     */
+    private function autoSizeStylesChanged(<\ZExcel\Style\Font> defaultFont) -> boolean
+    {
+        var xfIndex, signature, cellXfs;
+        
+        let cellXfs = this->parent->getCellXfCollection();
+        
+        for xfIndex, signature in this->autoSizeStyleSignatures {
+            if (!isset(cellXfs[xfIndex]) || this->autoSizeStyleSignature(cellXfs[xfIndex], defaultFont) !== signature) {
+                return true;
+            }
+        }
+        
+        return false;
+    }
+
+    /**
+     * Drop the measured width of a cell that no longer contributes to its column width
+     *
+     * @param string pCoordinate Coordinate of the cell
+     * @param string column      Column of the cell
+     */
+    private function forgetAutoSizeCell(string pCoordinate, string column)
+    {
+        var cells;
+        
+        if (isset(this->autoSizeCellWidths[column][pCoordinate])) {
+            let cells = this->autoSizeCellWidths[column];
+            unset(cells[pCoordinate]);
+            let this->autoSizeCellWidths[column] = cells;
+        }
+        
+        if (isset(this->autoSizeFormulaCells[column][pCoordinate])) {
+            let cells = this->autoSizeFormulaCells[column];
+            unset(cells[pCoordinate]);
+            let this->autoSizeFormulaCells[column] = cells;
+        }
+    }
+
+    /**
+     * Record that a cell has been written or deleted
+     *
+     * Called by the cell whenever its value, data type or style changes, and by the cell collection when a cell is deleted.
+     *
+     * @param string pCoordinate Coordinate of the cell
+     */
+    public function cellChanged(string pCoordinate)
+    {
+        var column;
+        
+        let column = rtrim(pCoordinate, "0123456789");
+        
+        if (isset(this->autoSizeCellWidths[column])) {
+            let this->autoSizeDirtyCells[column][pCoordinate] = true;
+        }
+    }
+
+    /**
+     * Record that a cell has been deleted from the cell collection
+     *
+     * @param string pCoordinate Coordinate of the cell
+     */
+    public function cellDeleted(string pCoordinate)
+    {
+        // The cell is measured again, and forgotten since it is gone
+        this->cellChanged(pCoordinate);
+        // Formulae reading the cell now read an empty cell
+        this->cellValueChanged(pCoordinate);
+    }
+
+    /**
+     * Invalidate the calculated values that may depend on a cell whose value has changed
+     *
+     * @param string pCoordinate Coordinate of the cell, or range of a block of cells (e.g. A1:C10)
+     */
+    public function cellValueChanged(string pCoordinate)
+    {
+        var calculation;
+        
+        if (this->parent === null) {
+            return;
+        }
+        
+        let calculation = \ZExcel\Calculation::getExistingInstance(this->parent);
+        
+        if (calculation !== null) {
+            calculation->cellValueChanged(this->title, pCoordinate);
+        }
+    }
+
+    /**
+     * Forget all measured cell widths, e.g. after cells have been moved
+     */
+    private function resetAutoSizeTracking()
+    {
+        let this->autoSizeCellWidths = [];
+        let this->autoSizeDirtyCells = [];
+        let this->autoSizeFormulaCells = [];
+        let this->autoSizeStyleSignatures = [];
+    }
+
     /**
      * Get parent
      *
@@ -840,7 +1119,7 @@ class Worksheet implements IComparable
      */
     public function setTitle(var pValue = "Worksheet", var updateFormulaCellReferences = true)
     {
-        var oldTitle, newTitle, altTitle, i;
+        var oldTitle, newTitle, altTitle, i, calculation;
         
         // Is this a "rename" or not?
         if (this->getTitle() == pValue) {
@@ -890,7 +1169,13 @@ class Worksheet implements IComparable
         if (is_object(this->parent) && this->parent instanceof \ZExcel\ZExcel) {
             let newTitle = this->getTitle();
             
-            \ZExcel\Calculation::getInstance(this->parent)->renameCalculationCacheForWorksheet(oldTitle, newTitle);
+            this->parent->sheetTitleChanged(this, oldTitle);
+            
+            let calculation = \ZExcel\Calculation::getExistingInstance(this->parent);
+            
+            if (calculation !== null) {
+                calculation->renameCalculationCacheForWorksheet(oldTitle, newTitle);
+            }
             
             if (updateFormulaCellReferences == true) {
                 \ZExcel\ReferenceHelper::getInstance()->updateNamedFormulas(this->parent, oldTitle, newTitle);
@@ -1041,7 +1326,15 @@ class Worksheet implements IComparable
      */
     public function getHighestColumn(row = null)
     {
+        int highestDimension;
+
         if (row == null) {
+            let highestDimension = this->columnDimensionStore->getHighest();
+
+            if (highestDimension > \ZExcel\Cell::columnIndexFromString(this->cachedHighestColumn)) {
+                return \ZExcel\Cell::stringFromColumnIndex(highestDimension - 1);
+            }
+
             return this->cachedHighestColumn;
         }
         return this->getHighestDataColumn(row);
@@ -1069,7 +1362,7 @@ class Worksheet implements IComparable
     public function getHighestRow(column = null)
     {
         if (column == null) {
-            return this->cachedHighestRow;
+            return max(this->cachedHighestRow, this->rowDimensionStore->getHighest());
         }
         return this->getHighestDataRow(column);
     }
@@ -1210,7 +1503,8 @@ class Worksheet implements IComparable
         }
 
         // Named range?
-        if ((!preg_match("/^" . \ZExcel\Calculation::CALCULATION_REGEXP_CELLREF . "$/i", pCoordinate)) && (preg_match("/^" . \ZExcel\Calculation::CALCULATION_REGEXP_NAMEDRANGE . "$/i", pCoordinate))) {
+        if (\ZExcel\Cell\Coordinate::parse(pCoordinate, true) == \ZExcel\Cell\Coordinate::INVALID
+                && preg_match("/^" . \ZExcel\Calculation::CALCULATION_REGEXP_NAMEDRANGE . "$/i", pCoordinate)) {
             let namedRange = \ZExcel\NamedRange::resolveRange(pCoordinate, this);
             
             if (namedRange !== null) {
@@ -1269,12 +1563,10 @@ class Worksheet implements IComparable
      */
     private function createNewCell(pCoordinate)
     {
-        var cell, aCoordinates, rowDimension, columnDimension;
+        var cell, aCoordinates, xfIndex;
         
         let cell = new \ZExcel\Cell(null, \ZExcel\Cell\DataType::TYPE_NULL, this);
         
-        let this->cellCollectionIsSorted = false;
-
         // Coordinates
         let aCoordinates = \ZExcel\Cell::coordinateFromString(pCoordinate);
         
@@ -1284,22 +1576,24 @@ class Worksheet implements IComparable
         
         let this->cachedHighestRow = max(this->cachedHighestRow, aCoordinates[1]);
 
+        // Add the cell first: setXfIndex() notifies the cell collection of the current cell
+        this->cellCollection->addCacheData(pCoordinate, cell);
+
         // Cell needs appropriate xfIndex from dimensions records
         // but don"t create dimension records if they don"t already exist
-        let rowDimension    = this->getRowDimension(aCoordinates[1], false);
-        let columnDimension = this->getColumnDimension(aCoordinates[0], false);
+        let xfIndex = this->rowDimensionStore->getXfIndex(aCoordinates[1]);
 
-        if (rowDimension !== null && rowDimension->getXfIndex() > 0) {
+        if (xfIndex > 0) {
             // then there is a row dimension with explicit style, assign it to the cell
-            cell->setXfIndex(rowDimension->getXfIndex());
+            cell->setXfIndex(xfIndex);
         } else {
-            if (columnDimension !== null && columnDimension->getXfIndex() > 0) {
+            let xfIndex = this->columnDimensionStore->getXfIndex(aCoordinates[0]);
+
+            if (xfIndex > 0) {
                 // then there is a column dimension, assign it to the cell
-                cell->setXfIndex(columnDimension->getXfIndex());
+                cell->setXfIndex(xfIndex);
             }
         }
-        
-        this->cellCollection->addCacheData(pCoordinate, cell);
 
         return cell;
     }
@@ -1322,8 +1616,8 @@ class Worksheet implements IComparable
         }
         
         // Named range?
-        if ((!preg_match("/^" . \ZExcel\Calculation::CALCULATION_REGEXP_CELLREF . "$/i", pCoordinate))
-                && (preg_match("/^" . \ZExcel\Calculation::CALCULATION_REGEXP_NAMEDRANGE . "$/i", pCoordinate))) {
+        if (\ZExcel\Cell\Coordinate::parse(pCoordinate, true) == \ZExcel\Cell\Coordinate::INVALID
+                && preg_match("/^" . \ZExcel\Calculation::CALCULATION_REGEXP_NAMEDRANGE . "$/i", pCoordinate)) {
             
             let namedRange = \ZExcel\NamedRange::resolveRange(pCoordinate, this);
             
@@ -1380,17 +1674,11 @@ class Worksheet implements IComparable
     public function getRowDimension(int pRow = 1, boolean create = true)
     {
         // Get row dimension
-        if (!isset(this->rowDimensions[pRow])) {
-            if (!create) {
-                return null;
-            }
-            
-            let this->rowDimensions[pRow] = new \ZExcel\Worksheet\RowDimension(pRow);
-
-            let this->cachedHighestRow = max(this->cachedHighestRow, pRow);
+        if (!create && !this->rowDimensionStore->has(pRow)) {
+            return null;
         }
         
-        return this->rowDimensions[pRow];
+        return this->rowDimensionStore->getView(pRow);
     }
 
     /**
@@ -1405,19 +1693,11 @@ class Worksheet implements IComparable
         let pColumn = strtoupper(pColumn);
 
         // Fetch dimensions
-        if (!isset(this->columnDimensions[pColumn])) {
-            if (!create) {
-                return null;
-            }
-            
-            let this->columnDimensions[pColumn] = new \ZExcel\Worksheet\ColumnDimension(pColumn);
-
-            if (\ZExcel\Cell::columnIndexFromString(this->cachedHighestColumn) < \ZExcel\Cell::columnIndexFromString(pColumn)) {
-                let this->cachedHighestColumn = pColumn;
-            }
+        if (!create && !this->columnDimensionStore->has(pColumn)) {
+            return null;
         }
         
-        return this->columnDimensions[pColumn];
+        return this->columnDimensionStore->getView(pColumn);
     }
 
     /**
@@ -1494,43 +1774,52 @@ class Worksheet implements IComparable
     /**
      * Get conditional styles for a cell
      *
-     * @param string pCoordinate
+     * A cell covered by a range list gets the conditional styles of that range list
+     *
+     * @param string pCoordinate Cell coordinate, or range list as used in setConditionalStyles
      * @return \ZExcel\Style\Conditional[]
      */
     public function getConditionalStyles(var pCoordinate = "A1")
     {
+        var rangeList;
+
         let pCoordinate = strtoupper(pCoordinate);
-        
-        if (!isset(this->conditionalStylesCollection[pCoordinate])) {
-            let this->conditionalStylesCollection[pCoordinate] = [];
+        let rangeList = this->findCoveringRangeList(this->getConditionalStylesIndex(), this->conditionalStylesCollection, pCoordinate);
+
+        if (rangeList !== null) {
+            return this->conditionalStylesCollection[rangeList];
         }
-        
-        return this->conditionalStylesCollection[pCoordinate];
+
+        return [];
     }
 
     /**
      * Do conditional styles exist for this cell?
      *
-     * @param string pCoordinate
+     * @param string pCoordinate Cell coordinate, or range list as used in setConditionalStyles
      * @return boolean
      */
     public function conditionalStylesExists(pCoordinate = "A1")
     {
-        if (isset(this->conditionalStylesCollection[strtoupper(pCoordinate)])) {
-            return true;
-        }
-        return false;
+        return this->findCoveringRangeList(this->getConditionalStylesIndex(), this->conditionalStylesCollection, strtoupper(pCoordinate)) !== null;
     }
 
     /**
-     * Removes conditional styles for a cell
+     * Removes conditional styles for a cell or range list
      *
-     * @param string pCoordinate
+     * @param string pCoordinate Cell coordinate, or range list as used in setConditionalStyles
      * @return \ZExcel\Worksheet
      */
     public function removeConditionalStyles(pCoordinate = "A1")
     {
-        unset(this->conditionalStylesCollection[strtoupper(pCoordinate)]);
+        let pCoordinate = strtoupper(pCoordinate);
+
+        unset(this->conditionalStylesCollection[pCoordinate]);
+
+        if (this->conditionalStylesIndex !== null) {
+            this->conditionalStylesIndex->remove(pCoordinate);
+        }
+
         return this;
     }
 
@@ -1547,17 +1836,73 @@ class Worksheet implements IComparable
     /**
      * Set conditional styles
      *
-     * @param pCoordinate string E.g. "A1"
+     * The styles are stored once for the whole range list, and take precedence over
+     * the conditional styles set earlier on overlapping cells
+     *
+     * @param pCoordinate string E.g. "A1", "A1:A100" or "A1:A100 C1:C100"
      * @param pValue \ZExcel\Style\Conditional[]
      * @return \ZExcel\Worksheet
      */
     public function setConditionalStyles(var pCoordinate = "A1", var pValue) -> <\ZExcel\Worksheet>
     {
-        let this->conditionalStylesCollection[strtoupper(pCoordinate)] = pValue;
-        
+        let pCoordinate = strtoupper(pCoordinate);
+
+        // Move the entry to the end of the collection, so that a rebuilt index keeps the same precedence
+        unset(this->conditionalStylesCollection[pCoordinate]);
+        let this->conditionalStylesCollection[pCoordinate] = pValue;
+
+        if (this->conditionalStylesIndex !== null) {
+            this->conditionalStylesIndex->add(pCoordinate);
+        }
+
         return this;
     }
 
+    /**
+     * Get the spatial index over the conditional styles collection
+     *
+     * @return \ZExcel\Worksheet\RangeIndex
+     */
+    private function getConditionalStylesIndex() -> <\ZExcel\Worksheet\RangeIndex>
+    {
+        if (this->conditionalStylesIndex === null) {
+            let this->conditionalStylesIndex = new \ZExcel\Worksheet\RangeIndex(this->conditionalStylesCollection);
+        }
+
+        return this->conditionalStylesIndex;
+    }
+
+    /**
+     * Find the collection key holding the rule of a cell
+     *
+     * A range list is only matched by its own key; a cell coordinate is matched by the
+     * last range list covering it
+     *
+     * @param \ZExcel\Worksheet\RangeIndex index      Index over the collection keys
+     * @param array                          collection Conditional styles or data validation collection
+     * @param string pCoordinate Uppercase cell coordinate or range list
+     * @return string|null
+     */
+    private function findCoveringRangeList(<\ZExcel\Worksheet\RangeIndex> index, array collection, string pCoordinate)
+    {
+        int packed;
+
+        let packed = \ZExcel\Cell\Coordinate::parse(pCoordinate);
+
+        if (packed == \ZExcel\Cell\Coordinate::INVALID) {
+            if (isset(collection[pCoordinate])) {
+                return pCoordinate;
+            }
+
+            return null;
+        }
+
+        return index->find(
+            \ZExcel\Cell\Coordinate::column(packed),
+            \ZExcel\Cell\Coordinate::row(packed)
+        );
+    }
+
     /**
      * Get style for cell by using numeric cell coordinates
      *
@@ -1661,7 +2006,7 @@ class Worksheet implements IComparable
      */
     public function duplicateConditionalStyle(array pCellStyle = null, string pRange = "") -> <\ZExcel\Worksheet>
     {
-        var cellStyle, rangeStart, rangeEnd, tmp, col, row;
+        var cellStyle, rangeStart, rangeEnd, tmp, cellRange;
         
         for cellStyle in pCellStyle {
             if (!(cellStyle instanceof \ZExcel\Style\Conditional)) {
@@ -1669,25 +2014,20 @@ class Worksheet implements IComparable
             }
         }
 
-        // Calculate range outer borders
-        let tmp = \ZExcel\Cell::rangeBoundaries(pRange . ":" . pRange);
-        let rangeStart = tmp[0];
-        let rangeEnd = tmp[1];
+        // Calculate range outer borders, from the upper left to the lower right cell
+        let tmp = \ZExcel\Cell::rangeBoundaries(pRange);
+        let rangeStart = [min(tmp[0][0], tmp[1][0]), min(tmp[0][1], tmp[1][1])];
+        let rangeEnd = [max(tmp[0][0], tmp[1][0]), max(tmp[0][1], tmp[1][1])];
 
-        // Make sure we can loop upwards on rows and columns
-        if (rangeStart[0] > rangeEnd[0] && rangeStart[1] > rangeEnd[1]) {
-            let tmp = rangeStart;
-            let rangeStart = rangeEnd;
-            let rangeEnd = tmp;
-        }
+        // Store the styles once for the whole range
+        let cellRange = \ZExcel\Cell::stringFromColumnIndex(rangeStart[0] - 1) . rangeStart[1];
 
-        // Loop through cells and apply styles
-        for col in range(rangeStart[0], rangeEnd[0]) {
-            for row in range(rangeStart[1], rangeEnd[1]) {
-                this->setConditionalStyles(\ZExcel\Cell::stringFromColumnIndex(col - 1) . row, pCellStyle);
-            }
+        if (rangeStart[0] != rangeEnd[0] || rangeStart[1] != rangeEnd[1]) {
+            let cellRange .= ":" . \ZExcel\Cell::stringFromColumnIndex(rangeEnd[0] - 1) . rangeEnd[1];
         }
 
+        this->setConditionalStyles(cellRange, pCellStyle);
+
         return this;
     }
 
@@ -1772,36 +2112,68 @@ class Worksheet implements IComparable
      */
     public function mergeCells(string pRange = "A1:A1") -> <\ZExcel\Worksheet>
     {
-        var aReferences, upperLeft, count, i;
+        var boundaries, upperLeft, columnLetters, coordinate;
+        int minColumn, minRow, maxColumn, maxRow, column, row, packed;
         
         // Uppercase coordinate
         let pRange = strtoupper(pRange);
 
-        if (strpos(pRange, ":") !== false) {
+        if (strpos(pRange, ":") === false) {
+            throw new \ZExcel\Exception("Merge must be set on a range of cells.");
+        }
+        
+        if (!isset(this->mergeCells[pRange])) {
             let this->mergeCells[pRange] = pRange;
+            
+            if (this->mergeIndex !== null) {
+                this->mergeIndex->add(pRange);
+            }
+        }
+        
+        this->resetAutoSizeTracking();
 
-            // make sure cells are created
+        // make sure cells are created
+        let boundaries = \ZExcel\Cell::rangeBoundaries(str_replace("$", "", pRange));
+        let minColumn = boundaries[0][0];
+        let minRow = boundaries[0][1];
+        let maxColumn = boundaries[1][0];
+        let maxRow = boundaries[1][1];
 
-            // get the cells in the range
-            let aReferences = \ZExcel\Cell::extractAllCellReferencesInRange(pRange);
+        // create upper left cell if it does not already exist
+        let upperLeft = \ZExcel\Cell::stringFromColumnIndex(minColumn - 1) . minRow;
+        
+        if (!this->cellExists(upperLeft)) {
+            this->getCell(upperLeft)->setValueExplicit(null, \ZExcel\Cell\DataType::TYPE_NULL);
+        }
 
-            // create upper left cell if it does not already exist
-            let upperLeft = aReferences[0];
+        // Blank out the rest of the cells in the range (if they exist),
+        //    looking at whichever is smaller: the cells of the range or the existing cells
+        if ((maxColumn - minColumn + 1) * (maxRow - minRow + 1) <= count(this->cellCollection->getCellList())) {
+            let columnLetters = [];
             
-            if (!this->cellExists(upperLeft)) {
-                this->getCell(upperLeft)->setValueExplicit(null, \ZExcel\Cell\DataType::TYPE_NULL);
+            for column in range(minColumn, maxColumn) {
+                let columnLetters[] = \ZExcel\Cell::stringFromColumnIndex(column - 1);
             }
-
-            // Blank out the rest of the cells in the range (if they exist)
-            let count = count(aReferences);
             
-            for i in range(1, count - 1) {
-                if (this->cellExists(aReferences[i])) {
-                    this->getCell(aReferences[i])->setValueExplicit(null, \ZExcel\Cell\DataType::TYPE_NULL);
+            for row in range(minRow, maxRow) {
+                for column in range(0, maxColumn - minColumn) {
+                    let coordinate = columnLetters[column] . row;
+                    
+                    if (coordinate !== upperLeft && this->cellCollection->isDataSet(coordinate)) {
+                        this->getCell(coordinate)->setValueExplicit(null, \ZExcel\Cell\DataType::TYPE_NULL);
+                    }
                 }
             }
         } else {
-            throw new \ZExcel\Exception("Merge must be set on a range of cells.");
+            for coordinate in this->cellCollection->getCellList() {
+                let packed = \ZExcel\Cell\Coordinate::parse(coordinate);
+                let column = \ZExcel\Cell\Coordinate::column(packed);
+                let row = \ZExcel\Cell\Coordinate::row(packed);
+                
+                if (column >= minColumn && column <= maxColumn && row >= minRow && row <= maxRow && coordinate !== upperLeft) {
+                    this->getCell(coordinate)->setValueExplicit(null, \ZExcel\Cell\DataType::TYPE_NULL);
+                }
+            }
         }
 
         return this;
@@ -1841,6 +2213,12 @@ class Worksheet implements IComparable
         if (strpos(pRange, ":") !== false) {
             if (isset(this->mergeCells[pRange])) {
                 unset(this->mergeCells[pRange]);
+                
+                if (this->mergeIndex !== null) {
+                    this->mergeIndex->remove(pRange);
+                }
+                
+                this->resetAutoSizeTracking();
             } else {
                 throw new \ZExcel\Exception("Cell range " . pRange . " not known as merged.");
             }
@@ -1880,6 +2258,20 @@ class Worksheet implements IComparable
         return this->mergeCells;
     }
 
+    /**
+     * Get the spatial index over the merged cell ranges
+     *
+     * @return \ZExcel\Worksheet\MergeIndex
+     */
+    public function getMergeIndex() -> <\ZExcel\Worksheet\MergeIndex>
+    {
+        if (this->mergeIndex === null) {
+            let this->mergeIndex = new \ZExcel\Worksheet\MergeIndex(this->mergeCells);
+        }
+
+        return this->mergeIndex;
+    }
+
     /**
      * Set merge cells array for the entire sheet. Use instead mergeCells() to merge
      * a single cell range.
@@ -1889,6 +2281,8 @@ class Worksheet implements IComparable
     public function setMergeCells(array pValue = []) -> <\ZExcel\Worksheet>
     {
         let this->mergeCells = pValue;
+        let this->mergeIndex = null;
+        this->resetAutoSizeTracking();
 
         return this;
     }
@@ -2127,6 +2521,7 @@ class Worksheet implements IComparable
         if (pBefore >= 1) {
             let objReferenceHelper = \ZExcel\ReferenceHelper::getInstance();
             objReferenceHelper->insertNewBefore("A" . pBefore, 0, pNumRows, this);
+            this->resetAutoSizeTracking();
         } else {
             throw new \ZExcel\Exception("Rows can only be inserted before at least row 1.");
         }
@@ -2149,6 +2544,7 @@ class Worksheet implements IComparable
         if (!is_numeric(pBefore)) {
             let objReferenceHelper = \ZExcel\ReferenceHelper::getInstance();
             objReferenceHelper->insertNewBefore(pBefore . "1", pNumCols, 0, this);
+            this->resetAutoSizeTracking();
         } else {
             throw new \ZExcel\Exception("Column references should not be numeric.");
         }
@@ -2195,6 +2591,8 @@ class Worksheet implements IComparable
                 this->getCellCacheController()->removeRow(highestRow);
                 let highestRow = highestRow - 1;
             }
+            
+            this->resetAutoSizeTracking();
         } else {
             throw new \ZExcel\Exception("Rows to be deleted should at least start from row 1.");
         }
@@ -2225,6 +2623,8 @@ class Worksheet implements IComparable
                 this->getCellCacheController()->removeColumn(highestColumn);
                 let highestColumn = \ZExcel\Cell::stringFromColumnIndex(\ZExcel\Cell::columnIndexFromString(highestColumn) - 2);
             }
+            
+            this->resetAutoSizeTracking();
         } else {
             throw new \ZExcel\Exception("Column references should not be numeric.");
         }
@@ -2560,43 +2960,154 @@ class Worksheet implements IComparable
      */
     public function fromArray(var source = null, var nullValue = null, string startCell = "A1", boolean strictNullComparison = false) -> <\ZExcel\Worksheet>
     {
-        var startColumn, startRow, rowData, currentColumn, cellValue, tmp;
+        if (!is_array(source)) {
+            throw new \ZExcel\Exception("Parameter $source should be an array.");
+        }
         
-        if (is_array(source)) {
-            //    Convert a 1-D array to 2-D (for ease of looping)
-            if (!is_array(end(source))) {
-                let source = [source];
-            }
-
-            // start coordinate
-            let tmp = \ZEXcel\Cell::coordinateFromString(startCell);
-            let startColumn = tmp[0];
-            let startRow = tmp[1];
+        return this->setCellValues(source, startCell, [], nullValue, strictNullComparison);
+    }
 
-            // Loop through source
-            for rowData in source {
-                let currentColumn = startColumn;
+    /**
+     * Fill worksheet from rows of values
+     *
+     * Cells are written straight into the cell collection. Values in a column with a declared data type
+     *    are stored with that type, without going through the value binder; other values are bound as
+     *    with \ZExcel\Cell::setValue()
+     *
+     * @param array|\Traversable source Rows of values (a 2-D array, or e.g. a generator yielding one array per row)
+     * @param string startCell Top left coordinate of the values
+     * @param array columnTypes Data type (\ZExcel\Cell\DataType::TYPE_*) of the values in a column,
+     *                          indexed by column letter or by 0-based position within the source rows
+     * @param mixed nullValue Value in source rows that stands for blank cell
+     * @param boolean strictNullComparison Apply strict comparison when testing for null values
+     * @throws \ZExcel\Exception
+     * @return \ZExcel\Worksheet
+     */
+    public function setCellValues(var source, string startCell = "A1", array columnTypes = [], var nullValue = null, boolean strictNullComparison = false) -> <\ZExcel\Worksheet>
+    {
+        var packed, key, dataType, rowData, cellValue, cell, coordinate;
+        array types = [], columnLetters = [], columnXfIndexes = [];
+        int startColumn, startRow, row, offset, rowXfIndex, highestColumn = 0, highestRow = 0;
+        boolean isNull;
+        
+        if (!is_array(source) && !(is_object(source) && source instanceof \Traversable)) {
+            throw new \ZExcel\Exception("Parameter $source should be an array or a Traversable.");
+        }
+        
+        //    Convert a 1-D array to 2-D (for ease of looping)
+        if (is_array(source) && !is_array(end(source))) {
+            let source = [source];
+        }
+        
+        let packed = \ZExcel\Cell\Coordinate::parse(startCell, true);
+        
+        if (packed == \ZExcel\Cell\Coordinate::INVALID) {
+            throw new \ZExcel\Exception("Invalid cell coordinate " . startCell);
+        }
+        
+        let startColumn = \ZExcel\Cell\Coordinate::column(packed);
+        let startRow = \ZExcel\Cell\Coordinate::row(packed);
+        
+        // Index the declared data types by position within the source rows
+        for key, dataType in columnTypes {
+            if (!in_array(dataType, [
+                \ZExcel\Cell\DataType::TYPE_STRING2, \ZExcel\Cell\DataType::TYPE_STRING, \ZExcel\Cell\DataType::TYPE_FORMULA,
+                \ZExcel\Cell\DataType::TYPE_NUMERIC, \ZExcel\Cell\DataType::TYPE_BOOL, \ZExcel\Cell\DataType::TYPE_NULL,
+                \ZExcel\Cell\DataType::TYPE_INLINE, \ZExcel\Cell\DataType::TYPE_ERROR
+            ], true)) {
+                throw new \ZExcel\Exception("Invalid datatype: " . dataType);
+            }
+            
+            if (is_string(key) && !is_numeric(key)) {
+                let offset = \ZExcel\Cell::columnIndexFromString(strtoupper(key)) - startColumn;
+            } else {
+                let offset = (int) key;
+            }
+            
+            let types[offset] = dataType;
+        }
+        
+        let row = startRow;
+        
+        for rowData in source {
+            // Cells take their style from an explicitly styled row, or failing that from their column
+            let rowXfIndex = (int) this->rowDimensionStore->getXfIndex(row);
+            
+            let offset = 0;
+            
+            for cellValue in rowData {
+                if (strictNullComparison) {
+                    let isNull = (cellValue === nullValue);
+                } else {
+                    let isNull = (cellValue == nullValue);
+                }
                 
-                for cellValue in rowData {
-                    if (strictNullComparison) {
-                        if (cellValue !== nullValue) {
-                            // Set cell value
-                            this->getCell(currentColumn . startRow)->setValue(cellValue);
-                        }
+                if (isNull) {
+                    let offset++;
+                    continue;
+                }
+                
+                if (!isset(columnLetters[offset])) {
+                    let columnLetters[offset] = \ZExcel\Cell::stringFromColumnIndex(startColumn + offset - 1);
+                    let columnXfIndexes[offset] = this->columnDimensionStore->getXfIndex(columnLetters[offset]);
+                }
+                
+                let coordinate = columnLetters[offset] . row;
+                
+                if (this->cellCollection->isDataSet(coordinate)) {
+                    let cell = this->cellCollection->getCacheData(coordinate);
+                    
+                    if (isset(types[offset])) {
+                        cell->setValueExplicit(cellValue, types[offset]);
                     } else {
-                        if (cellValue != nullValue) {
-                            // Set cell value
-                            this->getCell(currentColumn . startRow)->setValue(cellValue);
-                        }
+                        cell->setValue(cellValue);
+                    }
+                } else {
+                    if (isset(types[offset])) {
+                        let dataType = types[offset];
+                        let cell = new \ZExcel\Cell(\ZExcel\Cell::convertValueExplicit(cellValue, dataType), dataType, this);
+                    } else {
+                        let cell = new \ZExcel\Cell(null, \ZExcel\Cell\DataType::TYPE_NULL, this);
+                    }
+                    
+                    this->cellCollection->addCacheData(coordinate, cell);
+                    
+                    if (rowXfIndex > 0) {
+                        cell->setXfIndex(rowXfIndex);
+                    } elseif (columnXfIndexes[offset] > 0) {
+                        cell->setXfIndex(columnXfIndexes[offset]);
                     }
                     
-                    let currentColumn = currentColumn + 1;
+                    if (isset(types[offset])) {
+                        this->cellChanged(coordinate);
+                    } else {
+                        cell->setValue(cellValue);
+                    }
+                }
+                
+                if (startColumn + offset > highestColumn) {
+                    let highestColumn = startColumn + offset;
                 }
                 
-                let startRow = startRow + 1;
+                let highestRow = row;
+                let offset++;
             }
-        } else {
-            throw new \ZEXcel\Exception("Parameter $source should be an array.");
+            
+            let row++;
+        }
+        
+        if (highestRow > 0) {
+            if (\ZExcel\Cell::columnIndexFromString(this->cachedHighestColumn) < highestColumn) {
+                let this->cachedHighestColumn = \ZExcel\Cell::stringFromColumnIndex(highestColumn - 1);
+            }
+            
+            let this->cachedHighestRow = max(this->cachedHighestRow, highestRow);
+            
+            // Typed values bypass the cell, so invalidate calculated values once for the whole block
+            this->cellValueChanged(
+                \ZExcel\Cell\Coordinate::format(\ZExcel\Cell\Coordinate::pack(startColumn, startRow))
+                . ":" . \ZExcel\Cell\Coordinate::format(\ZExcel\Cell\Coordinate::pack(highestColumn, highestRow))
+            );
         }
         
         return this;
@@ -2748,6 +3259,220 @@ class Worksheet implements IComparable
         return this->rangeToArray("A1:" . maxCol . maxRow, nullValue, calculateFormulas, formatData, returnCellRef);
     }
 
+    /**
+     * Extract a range of cells as typed column vectors
+     *
+     * Each entry of the returned array holds the values of one column of the range, in row order.
+     * Unlike rangeToArray(), the default is to return raw (unformatted) values.
+     *
+     * Supported options:
+     *     nullValue          Value returned for empty or missing cells (default null)
+     *     calculateFormulas  Should formulas be calculated? (default true)
+     *     formatData         Should formatting be applied to cell values? (default false)
+     *     rawDoubles         Return every numeric value as a double (default false)
+     *     returnCellRef      Index by column letter and row number instead of counting from zero (default false)
+     *
+     * @param string pRange Range of cells (i.e. "A1:B10"), or just one cell (i.e. "A1")
+     * @param array options Extraction options
+     * @return array
+     */
+    public function rangeToColumnVectors(string pRange = "A1", array options = []) -> array
+    {
+        var tmp, rangeStart, rangeEnd;
+        
+        let tmp = \ZExcel\Cell::rangeBoundaries(pRange);
+        let rangeStart = tmp[0];
+        let rangeEnd = tmp[1];
+        
+        return this->extractRangeBlock(rangeStart[0], rangeEnd[0], rangeStart[1], rangeEnd[1], options, true);
+    }
+
+    /**
+     * Extract a range of cells as a packed batch of rows
+     *
+     * Accepts the same options as rangeToColumnVectors().
+     *
+     * @param string pRange Range of cells (i.e. "A1:B10"), or just one cell (i.e. "A1")
+     * @param array options Extraction options
+     * @return array
+     */
+    public function rangeToRowBatch(string pRange = "A1", array options = []) -> array
+    {
+        var tmp, rangeStart, rangeEnd;
+        
+        let tmp = \ZExcel\Cell::rangeBoundaries(pRange);
+        let rangeStart = tmp[0];
+        let rangeEnd = tmp[1];
+        
+        return this->extractRangeBlock(rangeStart[0], rangeEnd[0], rangeStart[1], rangeEnd[1], options, false);
+    }
+
+    /**
+     * Get an iterator returning a range of cells as successive packed row batches
+     *
+     * @param string pRange Range of cells (i.e. "A1:B10")
+     * @param int batchSize Number of rows per batch
+     * @param array options Extraction options, as for rangeToColumnVectors()
+     * @return \ZExcel\Worksheet\RowBatchIterator
+     */
+    public function getRowBatchIterator(string pRange, int batchSize = 1000, array options = []) -> <\ZExcel\Worksheet\RowBatchIterator>
+    {
+        return new \ZExcel\Worksheet\RowBatchIterator(this, pRange, batchSize, options);
+    }
+
+    /**
+     * Extract a rectangular block of cells
+     *
+     * Columns are walked by index with their letters resolved once, and number format codes
+     * are resolved once per xf index rather than once per cell.
+     *
+     * @param int minCol First column index (1-based)
+     * @param int maxCol Last column index (1-based)
+     * @param int minRow First row
+     * @param int maxRow Last row
+     * @param array options Extraction options, as for rangeToColumnVectors()
+     * @param boolean columnMajor True to return column vectors, false to return rows
+     * @return array
+     */
+    public function extractRangeBlock(int minCol, int maxCol, int minRow, int maxRow, array options = [], boolean columnMajor = false) -> array
+    {
+        var nullValue, cell, value, xfIndex, style, rRef, cRef;
+        boolean calculateFormulas, formatData, rawDoubles, returnCellRef;
+        int row, col, r, c;
+        array columns = [], formatCodes = [], returnValue = [];
+        
+        let nullValue = isset(options["nullValue"]) ? options["nullValue"] : null;
+        let calculateFormulas = isset(options["calculateFormulas"]) ? (boolean) options["calculateFormulas"] : true;
+        let formatData = isset(options["formatData"]) ? (boolean) options["formatData"] : false;
+        let rawDoubles = isset(options["rawDoubles"]) ? (boolean) options["rawDoubles"] : false;
+        let returnCellRef = isset(options["returnCellRef"]) ? (boolean) options["returnCellRef"] : false;
+        
+        for col in range(minCol, maxCol) {
+            let columns[col] = \ZExcel\Cell::stringFromColumnIndex(col - 1);
+        }
+        
+        let r = 0;
+        
+        for row in range(minRow, maxRow) {
+            let rRef = returnCellRef ? row : r;
+            let c = 0;
+            
+            for col in range(minCol, maxCol) {
+                let cRef = returnCellRef ? columns[col] : c;
+                let c = c + 1;
+                let value = nullValue;
+                
+                // getCacheData() returns null for missing cells, so no separate isDataSet() lookup is needed
+                let cell = this->cellCollection->getCacheData(columns[col] . row);
+                
+                if (cell !== null && cell->getValue() !== null) {
+                    if (calculateFormulas) {
+                        let value = cell->getCalculatedValue(false);
+                    } else {
+                        let value = cell->getValue();
+                    }
+                    
+                    if (is_object(value) && value instanceof \ZExcel\RichText) {
+                        let value = value->getPlainText();
+                    }
+                    
+                    if (formatData) {
+                        let xfIndex = cell->getXfIndex();
+                        if (!isset(formatCodes[xfIndex])) {
+                            let style = this->parent->getCellXfByIndex(xfIndex);
+                            let formatCodes[xfIndex] = (style && style->getNumberFormat()) ? style->getNumberFormat()->getFormatCode() : \ZExcel\Style\NumberFormat::FORMAT_GENERAL;
+                        }
+                        let value = \ZExcel\Style\NumberFormat::toFormattedString(value, formatCodes[xfIndex]);
+                    } elseif (rawDoubles && (is_int(value) || is_float(value))) {
+                        let value = (double) value;
+                    }
+                }
+                
+                if (columnMajor) {
+                    let returnValue[cRef][rRef] = value;
+                } else {
+                    let returnValue[rRef][cRef] = value;
+                }
+            }
+            
+            let r = r + 1;
+        }
+        
+        return returnValue;
+    }
+
+    /**
+     * Read a block of cell values for the calculation engine, indexed by row number and column letter
+     *
+     * Rows below the highest row of the worksheet are empty: they are left out of the block (only the first row
+     * of the block is always returned), and \ZExcel\Calculation::extractCellRange() adds them back. Cells beyond
+     * the highest column are never looked up. Formula cells are evaluated in a second pass, once the plain values
+     * have been read.
+     *
+     * @param    integer    minCol      First column index (1-based)
+     * @param    integer    maxCol      Last column index (1-based)
+     * @param    integer    minRow      First row
+     * @param    integer    maxRow      Last row
+     * @param    boolean    resetLog    Passed on to \ZExcel\Cell::getCalculatedValue()
+     * @return    array    Values, null for empty cells (e.g. [1 => ["A" => 1, "B" => null]])
+     */
+    public function extractCalculationBlock(int minCol, int maxCol, int minRow, int maxRow, boolean resetLog = true) -> array
+    {
+        var cell, value, coordinate, position, emptyRow;
+        int row, col, dataMaxRow, dataMaxCol;
+        array columns = [], formulaCells = [], returnValue;
+
+        for col in range(minCol, maxCol) {
+            let columns[col] = \ZExcel\Cell::stringFromColumnIndex(col - 1);
+        }
+
+        //    Only the rows that can hold data are built, starting with every cell empty
+        let dataMaxRow = min(maxRow, (int) this->cachedHighestRow);
+        let dataMaxCol = min(maxCol, \ZExcel\Cell::columnIndexFromString(this->cachedHighestColumn));
+        let emptyRow = array_fill_keys(array_values(columns), null);
+
+        if (dataMaxRow < minRow || dataMaxCol < minCol) {
+            let returnValue = [];
+            let returnValue[minRow] = emptyRow;
+            
+            return returnValue;
+        }
+
+        let returnValue = array_fill_keys(range(minRow, dataMaxRow), emptyRow);
+
+        for row in range(minRow, dataMaxRow) {
+            for col in range(minCol, dataMaxCol) {
+                let coordinate = columns[col] . row;
+                let cell = this->cellCollection->getCacheData(coordinate);
+
+                if (cell === null) {
+                    continue;
+                }
+
+                if (cell->getDataType() == \ZExcel\Cell\DataType::TYPE_FORMULA) {
+                    let formulaCells[coordinate] = [row, columns[col]];
+                    continue;
+                }
+
+                let value = cell->getValue();
+
+                if (is_object(value) && value instanceof \ZExcel\RichText) {
+                    let value = value->getPlainText();
+                }
+
+                let returnValue[row][columns[col]] = value;
+            }
+        }
+
+        //    Cells may be detached from the cell cache while others are read, so formula cells are fetched again
+        for coordinate, position in formulaCells {
+            let cell = this->cellCollection->getCacheData(coordinate);
+            let returnValue[position[0]][position[1]] = cell->getCalculatedValue(resetLog);
+        }
+
+        return returnValue;
+    }
+
     /**
      * Get row iterator
      *
@@ -2781,7 +3506,7 @@ class Worksheet implements IComparable
      */
     public function garbageCollect() -> <\ZExcel\Worksheet>
     {
-        var colRow, highestRow, highestColumn, dimension;
+        var colRow, highestRow, highestColumn;
         
         // Flush cache
         this->cellCollection->getCacheData("A1");
@@ -2791,15 +3516,9 @@ class Worksheet implements IComparable
         let highestRow = colRow["row"];
         let highestColumn = \ZExcel\Cell::columnIndexFromString(colRow["column"]);
 
-        // Loop through column dimensions
-        for dimension in this->columnDimensions {
-            let highestColumn = max(highestColumn, \ZExcel\Cell::columnIndexFromString(dimension->getColumnIndex()));
-        }
-
-        // Loop through row dimensions
-        for dimension in this->rowDimensions {
-            let highestRow = max(highestRow, dimension->getRowIndex());
-        }
+        // Dimension records count as well
+        let highestColumn = max(highestColumn, this->columnDimensionStore->getHighest());
+        let highestRow = max(highestRow, this->rowDimensionStore->getHighest());
 
         // Cache values
         if (highestColumn < 0) {
@@ -2918,17 +3637,24 @@ class Worksheet implements IComparable
     /**
      * Get data validation
      *
-     * @param string pCellCoordinate Cell coordinate to get data validation for
+     * A cell covered by a range list gets the data validation of that range list;
+     * a new data validation is only created for a cell or range list without one
+     *
+     * @param string pCellCoordinate Cell coordinate or range list to get data validation for
      */
     public function getDataValidation(string pCellCoordinate = "A1")
     {
+        var rangeList;
+
         // return data validation if we already have one
-        if (isset(this->_dataValidationCollection[pCellCoordinate])) {
-            return this->_dataValidationCollection[pCellCoordinate];
+        let rangeList = this->findCoveringRangeList(this->getDataValidationIndex(), this->_dataValidationCollection, pCellCoordinate);
+
+        if (rangeList !== null) {
+            return this->_dataValidationCollection[rangeList];
         }
 
         // else create data validation
-        let this->_dataValidationCollection[pCellCoordinate] = new \ZExcel\Cell\DataValidation();
+        this->setDataValidation(pCellCoordinate, new \ZExcel\Cell\DataValidation());
         
         return this->_dataValidationCollection[pCellCoordinate];
     }
@@ -2936,16 +3662,28 @@ class Worksheet implements IComparable
     /**
      * Set data validation
      *
-     * @param string pCellCoordinate    Cell coordinate to insert data validation
+     * The data validation is stored once for the whole range list, and takes precedence
+     * over the data validations set earlier on overlapping cells
+     *
+     * @param string pCellCoordinate    Cell coordinate or range list (e.g. "A1:A100 C1:C100") to insert data validation
      * @param    \ZExcel\Cell\DataValidation    pDataValidation
      * @return \ZExcel\Worksheet
      */
     public function setDataValidation(string pCellCoordinate = "A1", <\ZExcel\Cell\DataValidation> pDataValidation = null)
     {
+        // Move the entry to the end of the collection, so that a rebuilt index keeps the same precedence
+        unset(this->_dataValidationCollection[pCellCoordinate]);
+
         if (pDataValidation === null) {
-            unset(this->_dataValidationCollection[pCellCoordinate]);
+            if (this->dataValidationIndex !== null) {
+                this->dataValidationIndex->remove(pCellCoordinate);
+            }
         } else {
             let this->_dataValidationCollection[pCellCoordinate] = pDataValidation;
+
+            if (this->dataValidationIndex !== null) {
+                this->dataValidationIndex->add(pCellCoordinate);
+            }
         }
         return this;
     }
@@ -2953,12 +3691,26 @@ class Worksheet implements IComparable
     /**
      * Data validation at a specific coordinate exists?
      *
-     * @param string pCoordinate
+     * @param string pCoordinate Cell coordinate, or range list as used in setDataValidation
      * @return boolean
      */
     public function dataValidationExists(string pCoordinate = "A1")
     {
-        return isset(this->_dataValidationCollection[pCoordinate]);
+        return this->findCoveringRangeList(this->getDataValidationIndex(), this->_dataValidationCollection, pCoordinate) !== null;
+    }
+
+    /**
+     * Get the spatial index over the data validation collection
+     *
+     * @return \ZExcel\Worksheet\RangeIndex
+     */
+    private function getDataValidationIndex() -> <\ZExcel\Worksheet\RangeIndex>
+    {
+        if (this->dataValidationIndex === null) {
+            let this->dataValidationIndex = new \ZExcel\Worksheet\RangeIndex(this->_dataValidationCollection);
+        }
+
+        return this->dataValidationIndex;
     }
 
     /**
@@ -30,6 +30,20 @@ abstract class Dimension
      */
     private xfIndex;
 
+    /**
+     * Dimension store holding the values of this dimension, if any
+     *
+     * @var \ZExcel\Worksheet\DimensionStore|null
+     */
+    protected store = null;
+
+    /**
+     * Row number or column letters of this dimension in its store
+     *
+     * @var int|string
+     */
+    protected storeKey = null;
+
     /**
      * Create a new \ZExcel\Worksheet\Dimension
      *
@@ -48,6 +62,10 @@ abstract class Dimension
      */
     public function getVisible()
     {
+        if (this->store !== null) {
+            return !this->store->hasFlag(this->storeKey, \ZExcel\Worksheet\DimensionStore::FLAG_HIDDEN);
+        }
+
         return this->visible;
     }
 
@@ -59,6 +77,11 @@ abstract class Dimension
      */
     public function setVisible(boolean pValue = true) -> <\ZExcel\Worksheet\Dimension>
     {
+        if (this->store !== null) {
+            this->store->setFlag(this->storeKey, \ZExcel\Worksheet\DimensionStore::FLAG_HIDDEN, !pValue);
+            return this;
+        }
+
         let this->visible = pValue;
         
         return this;
@@ -71,6 +94,10 @@ abstract class Dimension
      */
     public function getOutlineLevel()
     {
+        if (this->store !== null) {
+            return this->store->getOutlineLevel(this->storeKey);
+        }
+
         return this->outlineLevel;
     }
 
@@ -89,6 +116,11 @@ abstract class Dimension
             throw new \ZExcel\Exception("Outline level must range between 0 and 7.");
         }
 
+        if (this->store !== null) {
+            this->store->setOutlineLevel(this->storeKey, pValue);
+            return this;
+        }
+
         let this->outlineLevel = pValue;
         
         return this;
@@ -101,6 +133,10 @@ abstract class Dimension
      */
     public function getCollapsed()
     {
+        if (this->store !== null) {
+            return this->store->hasFlag(this->storeKey, \ZExcel\Worksheet\DimensionStore::FLAG_COLLAPSED);
+        }
+
         return this->collapsed;
     }
 
@@ -112,6 +148,11 @@ abstract class Dimension
      */
     public function setCollapsed(boolean pValue = true) -> <\ZExcel\Worksheet\Dimension>
     {
+        if (this->store !== null) {
+            this->store->setFlag(this->storeKey, \ZExcel\Worksheet\DimensionStore::FLAG_COLLAPSED, pValue);
+            return this;
+        }
+
         let this->collapsed = pValue;
         
         return this;
@@ -124,6 +165,10 @@ abstract class Dimension
      */
     public function getXfIndex()
     {
+        if (this->store !== null) {
+            return this->store->getXfIndex(this->storeKey);
+        }
+
         return this->xfIndex;
     }
 
@@ -135,17 +180,66 @@ abstract class Dimension
      */
     public function setXfIndex(int pValue = 0) -> <\ZExcel\Worksheet\Dimension>
     {
+        if (this->store !== null) {
+            this->store->setXfIndex(this->storeKey, pValue);
+            return this;
+        }
+
         let this->xfIndex = pValue;
         
         return this;
     }
 
+    /**
+     * Read and write the values of this dimension from a dimension store
+     *
+     * @param \ZExcel\Worksheet\DimensionStore store
+     * @param int|string                        key   Row number or column letters
+     * @return \ZExcel\Worksheet\Dimension
+     */
+    public function setStore(<\ZExcel\Worksheet\DimensionStore> store, var key) -> <\ZExcel\Worksheet\Dimension>
+    {
+        let this->store = store;
+        let this->storeKey = key;
+
+        return this;
+    }
+
+    /**
+     * Copy the values of this dimension out of its dimension store, and stop using the store
+     *
+     * @return \ZExcel\Worksheet\Dimension
+     */
+    protected function detach() -> <\ZExcel\Worksheet\Dimension>
+    {
+        var store, key;
+
+        let store = this->store;
+        let key = this->storeKey;
+
+        if (store === null) {
+            return this;
+        }
+
+        let this->visible = !store->hasFlag(key, \ZExcel\Worksheet\DimensionStore::FLAG_HIDDEN);
+        let this->collapsed = store->hasFlag(key, \ZExcel\Worksheet\DimensionStore::FLAG_COLLAPSED);
+        let this->outlineLevel = store->getOutlineLevel(key);
+        let this->xfIndex = store->getXfIndex(key);
+        let this->store = null;
+        let this->storeKey = null;
+
+        return this;
+    }
+
     /**
      * Implement PHP __clone to create a deep clone, not just a shallow copy.
      */
     public function __clone()
     {
         var vars, key, value;
+
+        // A clone does not belong to any worksheet: it keeps its own values
+        this->detach();
         
         let vars = get_object_vars(this);
         
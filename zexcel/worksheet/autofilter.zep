@@ -308,21 +308,20 @@ class AutoFilter
      *    Test if cell value is in the defined set of values
      *
      *    @param    mixed        cellValue
-     *    @param    mixed[]        dataSet
+     *    @param    mixed[]        dataSet        filterValues holds the accepted values as keys
      *    @return boolean
      */
-    private static function _filterTestInSimpleDataSet(var cellValue, array dataSet)
+    private static function _filterTestInSimpleDataSet(var cellValue, array dataSet) -> boolean
     {
-        var dataSetValues, blanks;
-        
-        let dataSetValues = dataSet["filterValues"];
-        let blanks = dataSet["blanks"];
+        var key;
         
         if ((cellValue == "") || (cellValue === null)) {
-            return blanks;
+            return dataSet["blanks"];
         }
         
-        return in_array(cellValue, dataSetValues);
+        let key = (string) cellValue;
+        
+        return isset(dataSet["filterValues"][key]);
     }
 
     /**
@@ -332,34 +331,31 @@ class AutoFilter
      *    @param    mixed[]        dataSet
      *    @return boolean
      */
-    private static function _filterTestInDateGroupSet(var cellValue, array dataSet)
+    private static function _filterTestInDateGroupSet(var cellValue, array dataSet) -> boolean
     {
-        var dateSet, blanks, dateValue, dtVal;
+        var dateSet, dateValue, dtVal, civil;
         
         let dateSet = dataSet["filterValues"];
-        let blanks = dataSet["blanks"];
         
         if ((cellValue == "") || (cellValue === null)) {
-            return blanks;
+            return dataSet["blanks"];
         }
 
         if (is_numeric(cellValue)) {
-            let dateValue = \ZExcel\Shared\Date::ExcelToPHP(cellValue);
+            let civil = \ZExcel\Shared\Date::excelToCivil(cellValue);
             
             if (cellValue < 1) {
                 //    Just the time part
-                let dtVal = date("His",dateValue);
+                let dtVal = sprintf("%02d%02d%02d", civil[3], civil[4], civil[5]);
                 let dateSet = dateSet["time"];
+            } elseif (cellValue == floor(cellValue)) {
+                //    Just the date part
+                let dtVal = sprintf("%04d%02d%02d", civil[0], civil[1], civil[2]);
+                let dateSet = dateSet["date"];
             } else {
-                if (cellValue == floor(cellValue)) {
-                    //    Just the date part
-                    let dtVal = date("Ymd",dateValue);
-                    let dateSet = dateSet["date"];
-                } else {
-                    //    date and time parts
-                    let dtVal = date("YmdHis",dateValue);
-                    let dateSet = dateSet["dateTime"];
-                }
+                //    date and time parts
+                let dtVal = sprintf("%04d%02d%02d%02d%02d%02d", civil[0], civil[1], civil[2], civil[3], civil[4], civil[5]);
+                let dateSet = dateSet["dateTime"];
             }
             
             for dateValue in dateSet {
@@ -380,9 +376,77 @@ class AutoFilter
      *    @param    mixed[]        ruleSet
      *    @return boolean
      */
-    private static function _filterTestInCustomDataSet(cellValue, array ruleSet)
+    private static function _filterTestInCustomDataSet(var cellValue, array ruleSet) -> boolean
     {
-        throw new \Exception("Not implemented yet!");
+        var rule, join;
+        boolean customRuleForBlanks, returnVal, retVal;
+        
+        let join = ruleSet["join"];
+        let customRuleForBlanks = isset(ruleSet["customRuleForBlanks"]) ? ruleSet["customRuleForBlanks"] : false;
+
+        if (!customRuleForBlanks) {
+            //    Blank cells are always ignored, so return a FALSE
+            if ((cellValue == "") || (cellValue === null)) {
+                return false;
+            }
+        }
+        
+        let returnVal = (join == \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_COLUMN_JOIN_AND);
+        
+        for rule in ruleSet["filterRules"] {
+            let retVal = false;
+            
+            if (is_numeric(rule["value"])) {
+                //    Numeric values are tested using the appropriate operator
+                switch (rule["operator"]) {
+                    case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_EQUAL:
+                        let retVal = (cellValue == rule["value"]);
+                        break;
+                    case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_NOTEQUAL:
+                        let retVal = (cellValue != rule["value"]);
+                        break;
+                    case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_GREATERTHAN:
+                        let retVal = (cellValue > rule["value"]);
+                        break;
+                    case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_GREATERTHANOREQUAL:
+                        let retVal = (cellValue >= rule["value"]);
+                        break;
+                    case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_LESSTHAN:
+                        let retVal = (cellValue < rule["value"]);
+                        break;
+                    case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_LESSTHANOREQUAL:
+                        let retVal = (cellValue <= rule["value"]);
+                        break;
+                }
+            } elseif (rule["value"] == "") {
+                switch (rule["operator"]) {
+                    case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_EQUAL:
+                        let retVal = ((cellValue == "") || (cellValue === null));
+                        break;
+                    case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_NOTEQUAL:
+                        let retVal = ((cellValue != "") && (cellValue !== null));
+                        break;
+                    default:
+                        let retVal = true;
+                        break;
+                }
+            } else {
+                //    String values are always tested for equality, factoring in for wildcards (hence a regexp test)
+                let retVal = (preg_match(rule["pattern"], cellValue) > 0);
+            }
+            
+            //    If there are multiple conditions, then we need to test both using the appropriate join operator
+            if (join == \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_COLUMN_JOIN_OR) {
+                //    Return as soon as we have a TRUE match for OR joins
+                if (retVal) {
+                    return true;
+                }
+            } else {
+                let returnVal = returnVal && retVal;
+            }
+        }
+
+        return returnVal;
     }
 
     /**
@@ -392,9 +456,9 @@ class AutoFilter
      *    @param    mixed[]        monthSet
      *    @return boolean
      */
-    private static function _filterTestInPeriodDateSet(cellValue, array monthSet)
+    private static function _filterTestInPeriodDateSet(var cellValue, array monthSet) -> boolean
     {
-        var dateValue;
+        var civil;
         
         //    Blank cells are always ignored, so return a FALSE
         if ((cellValue == "") || (cellValue === null)) {
@@ -402,60 +466,507 @@ class AutoFilter
         }
 
         if (is_numeric(cellValue)) {
-            let dateValue = date("m", \ZExcel\Shared\Date::ExcelToPHP(cellValue));
+            let civil = \ZExcel\Shared\Date::excelToCivil(cellValue);
             
-            if (in_array(dateValue, monthSet)) {
-                return true;
-            }
+            return in_array(civil[1], monthSet);
         }
 
         return false;
     }
 
+    /**
+     *    Run a compiled column filter test against a cell value
+     *
+     *    @param    mixed        cellValue
+     *    @param    mixed[]        test        Compiled test, as returned by _compileColumnFilter()
+     *    @return boolean
+     */
+    private static function _filterTest(var cellValue, array test) -> boolean
+    {
+        switch (test["method"]) {
+            case "simple":
+                return self::_filterTestInSimpleDataSet(cellValue, test["arguments"]);
+            case "dateGroup":
+                return self::_filterTestInDateGroupSet(cellValue, test["arguments"]);
+            case "custom":
+                return self::_filterTestInCustomDataSet(cellValue, test["arguments"]);
+            case "period":
+                return self::_filterTestInPeriodDateSet(cellValue, test["arguments"]);
+        }
+        
+        return false;
+    }
 
     /**
-     *    Convert a dynamic rule daterange to a custom filter range expression for ease of calculation
+     *    Build a custom filter test from a list of operator/value rules
      *
-     *    @FIXME filterColumn is a reference (not manage by Zephir)
+     *    @param    mixed[]        ruleValues
+     *    @param    string        join
+     *    @param    boolean        customRuleForBlanks
+     *    @return mixed[]
+     */
+    private static function _customFilterTest(array ruleValues, string join, boolean customRuleForBlanks = false) -> array
+    {
+        return [
+            "method": "custom",
+            "arguments": ["filterRules": ruleValues, "join": join, "customRuleForBlanks": customRuleForBlanks]
+        ];
+    }
+
+    /**
+     *    Convert a dynamic rule daterange to a custom filter range expression for ease of calculation
      *
      *    @param    string                                        dynamicRuleType
-     *    @param    \ZExcel\Worksheet\AutoFilter\Column        &filterColumn
+     *    @param    \ZExcel\Worksheet\AutoFilter\Column        filterColumn
      *    @return mixed[]
      */
-    private function _dynamicFilterDateRange(string dynamicRuleType, <\ZExcel\Worksheet\AutoFilter\Column> filterColumn)
+    private function _dynamicFilterDateRange(string dynamicRuleType, <\ZExcel\Worksheet\AutoFilter\Column> filterColumn) -> array
     {
-        throw new \Exception("Not implemented yet!");
+        var range;
+        int today;
+        array ruleValues = [];
+        
+        //    Today as a serial date, in the local timezone
+        let today = (int) floor(\ZExcel\Shared\Date::timestampToExcel(time() + (int) date("Z")));
+        let range = self::_dynamicDateRange(dynamicRuleType, today);
+
+        //    Set the filter column rule attributes ready for writing
+        filterColumn->setAttributes(["val": range[0], "maxVal": range[1]]);
+
+        //    Set the rules for identifying rows for hide/show
+        let ruleValues[] = ["operator": \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_GREATERTHANOREQUAL, "value": range[0]];
+        let ruleValues[] = ["operator": \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_LESSTHAN, "value": range[1]];
+
+        return self::_customFilterTest(ruleValues, \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_COLUMN_JOIN_AND);
     }
 
-    private function _calculateTopTenValue(columnID, startRow, endRow, ruleType, ruleValue)
+    /**
+     *    Serial date range selected by a dynamic rule daterange
+     *
+     *    @param    string        dynamicRuleType
+     *    @param    int            today            Today as a serial date
+     *    @return int[]        First serial date in the range, and first serial date after it
+     */
+    private static function _dynamicDateRange(string dynamicRuleType, int today) -> array
     {
-        var range, dataValues;
+        var civil;
+        int year, month, val = 0, maxVal = 0, dayOfWeek;
         
-        let range = columnID . startRow . ":" . columnID . endRow;
-        let dataValues = \ZExcel\Calculation\Functions::flattenArray(
-            this->_workSheet->rangeToArray(range, null, true, false)
-        );
+        let civil = \ZExcel\Shared\Date::excelToCivil(today);
+        let year = civil[0];
+        let month = civil[1];
+        
+        switch (dynamicRuleType) {
+            case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_TODAY:
+                let val = today;
+                let maxVal = today + 1;
+                break;
+            case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_YESTERDAY:
+                let val = today - 1;
+                let maxVal = today;
+                break;
+            case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_TOMORROW:
+                let val = today + 1;
+                let maxVal = today + 2;
+                break;
+            case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_YEARTODATE:
+                let val = self::_serialDate(year, 1);
+                let maxVal = today + 1;
+                break;
+            case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_THISYEAR:
+                let val = self::_serialDate(year, 1);
+                let maxVal = self::_serialDate(year + 1, 1);
+                break;
+            case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_LASTYEAR:
+                let val = self::_serialDate(year - 1, 1);
+                let maxVal = self::_serialDate(year, 1);
+                break;
+            case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_NEXTYEAR:
+                let val = self::_serialDate(year + 1, 1);
+                let maxVal = self::_serialDate(year + 2, 1);
+                break;
+            case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_THISQUARTER:
+            case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_LASTQUARTER:
+            case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_NEXTQUARTER:
+                //    First month of the current quarter
+                let month = month - ((month - 1) % 3);
+                
+                if (dynamicRuleType == \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_LASTQUARTER) {
+                    let month = month - 3;
+                } elseif (dynamicRuleType == \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_NEXTQUARTER) {
+                    let month = month + 3;
+                }
+                
+                let val = self::_serialDate(year, month);
+                let maxVal = self::_serialDate(year, month + 3);
+                break;
+            case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_THISMONTH:
+                let val = self::_serialDate(year, month);
+                let maxVal = self::_serialDate(year, month + 1);
+                break;
+            case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_LASTMONTH:
+                let val = self::_serialDate(year, month - 1);
+                let maxVal = self::_serialDate(year, month);
+                break;
+            case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_NEXTMONTH:
+                let val = self::_serialDate(year, month + 1);
+                let maxVal = self::_serialDate(year, month + 2);
+                break;
+            case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_THISWEEK:
+            case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_LASTWEEK:
+            case \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_NEXTWEEK:
+                //    Weeks start on a Sunday
+                let dayOfWeek = (int) gmdate("w", \ZExcel\Shared\Date::ExcelToPHP(today));
+                let val = today - dayOfWeek;
+                
+                if (dynamicRuleType == \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_LASTWEEK) {
+                    let val = val - 7;
+                } elseif (dynamicRuleType == \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_NEXTWEEK) {
+                    let val = val + 7;
+                }
+                
+                let maxVal = val + 7;
+                break;
+        }
 
-        let dataValues = array_filter(dataValues);
+        return [val, maxVal];
+    }
+
+    /**
+     *    Serial date of the first day of a month; months outside 1-12 roll over into adjacent years
+     *
+     *    @param    int        year
+     *    @param    int        month
+     *    @return int
+     */
+    private static function _serialDate(int year, int month) -> int
+    {
+        let year = year + (int) floor((month - 1) / 12);
+        let month = month - (int) floor((month - 1) / 12) * 12;
+        
+        return (int) \ZExcel\Shared\Date::FormattedPHPToExcel(year, month, 1);
+    }
+
+    /**
+     *    Find the threshold value for a top-10 rule
+     *
+     *    Only the ruleValue best values are kept in a heap, rather than sorting the whole column.
+     *
+     *    @param    mixed[]        values        Column values
+     *    @param    string        ruleType      Top or bottom
+     *    @param    int            ruleValue     Number of values to select
+     *    @return mixed
+     */
+    private static function _calculateTopTenValue(array values, string ruleType, int ruleValue)
+    {
+        var heap, value;
         
         if (ruleType == \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_TOPTEN_TOP) {
-            rsort(dataValues);
+            let heap = new \SplMinHeap();
         } else {
-            sort(dataValues);
+            let heap = new \SplMaxHeap();
         }
+        
+        for value in values {
+            //    Empty and zero values are ignored
+            if (!value || !is_numeric(value)) {
+                continue;
+            }
+            
+            heap->insert(value);
+            
+            if (heap->count() > ruleValue) {
+                heap->extract();
+            }
+        }
+        
+        if (heap->isEmpty()) {
+            return null;
+        }
+        
+        return heap->top();
+    }
 
-        return array_pop(array_slice(dataValues, 0, ruleValue));
+    /**
+     *    Compile the rules of a filter column into a single test
+     *
+     *    @param    \ZExcel\Worksheet\AutoFilter\Column        filterColumn
+     *    @param    mixed[]        values            The calculated values of the column
+     *    @param    int            dataRowCount    Number of data rows in the range
+     *    @return mixed[]|null    Null if the column holds no rule
+     */
+    private function _compileColumnFilter(<\ZExcel\Worksheet\AutoFilter\Column> filterColumn, array values, int dataRowCount)
+    {
+        var rules, rule, ruleType = null, ruleValue = null, ruleValues, ruleDataSet, dateArguments, filterValues,
+            dateKey, timeKey, dynamicRuleType, value, numericCount, sum, operator, toptenRuleType = null, ruleOperator = null, maxVal, period;
+        boolean blanks, customRuleForBlanks;
+        
+        let rules = filterColumn->getRules();
+        
+        if (count(rules) == 0) {
+            return null;
+        }
+        
+        switch (filterColumn->getFilterType()) {
+            case \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_FILTER:
+                //    Build a list of the filter value selections
+                let ruleValues = [];
+                
+                for rule in rules {
+                    let ruleType = rule->getRuleType();
+                    let ruleValues[] = rule->getValue();
+                }
+                
+                //    Test if we want to include blanks in our filter criteria
+                let ruleDataSet = array_filter(ruleValues);
+                let blanks = (count(ruleValues) != count(ruleDataSet));
+                
+                if (ruleType == \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_FILTER) {
+                    //    Filter on absolute values, looked up by key
+                    let filterValues = [];
+                    
+                    for ruleValue in ruleDataSet {
+                        let value = (string) ruleValue;
+                        let filterValues[value] = true;
+                    }
+                    
+                    return ["method": "simple", "arguments": ["filterValues": filterValues, "blanks": blanks]];
+                }
+                
+                //    Filter on date group values
+                let dateArguments = ["date": [], "time": [], "dateTime": []];
+                
+                for ruleValue in ruleDataSet {
+                    let dateKey = "";
+                    let timeKey = "";
+                    
+                    if (isset(ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_YEAR]) && ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_YEAR] !== "") {
+                        let dateKey .= sprintf("%04d", ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_YEAR]);
+                    }
+                    if (isset(ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_MONTH]) && ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_MONTH] != "") {
+                        let dateKey .= sprintf("%02d", ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_MONTH]);
+                    }
+                    if (isset(ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_DAY]) && ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_DAY] !== "") {
+                        let dateKey .= sprintf("%02d", ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_DAY]);
+                    }
+                    if (isset(ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_HOUR]) && ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_HOUR] !== "") {
+                        let timeKey .= sprintf("%02d", ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_HOUR]);
+                    }
+                    if (isset(ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_MINUTE]) && ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_MINUTE] !== "") {
+                        let timeKey .= sprintf("%02d", ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_MINUTE]);
+                    }
+                    if (isset(ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_SECOND]) && ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_SECOND] !== "") {
+                        let timeKey .= sprintf("%02d", ruleValue[\ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DATEGROUP_SECOND]);
+                    }
+                    
+                    let dateArguments["date"][] = dateKey;
+                    let dateArguments["time"][] = timeKey;
+                    let dateArguments["dateTime"][] = dateKey . timeKey;
+                }
+                
+                //    Remove empty elements
+                let dateArguments["date"] = array_filter(dateArguments["date"]);
+                let dateArguments["time"] = array_filter(dateArguments["time"]);
+                let dateArguments["dateTime"] = array_filter(dateArguments["dateTime"]);
+                
+                return ["method": "dateGroup", "arguments": ["filterValues": dateArguments, "blanks": blanks]];
+                
+            case \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_CUSTOMFILTER:
+                let customRuleForBlanks = false;
+                let ruleValues = [];
+                
+                //    Build a list of the filter value selections
+                for rule in rules {
+                    let ruleValue = rule->getValue();
+                    let value = ["operator": rule->getOperator(), "value": ruleValue];
+                    
+                    if (!is_numeric(ruleValue)) {
+                        //    Convert to a regexp allowing for regexp reserved characters, wildcards and escaped wildcards
+                        let ruleValue = preg_quote(ruleValue, "/");
+                        let ruleValue = str_replace(self::_fromReplace, self::_toReplace, ruleValue);
+                        
+                        if (trim(ruleValue) == "") {
+                            let customRuleForBlanks = true;
+                            let ruleValue = trim(ruleValue);
+                        }
+                        
+                        let value["value"] = ruleValue;
+                        let value["pattern"] = "/^" . ruleValue . "$/i";
+                    }
+                    
+                    let ruleValues[] = value;
+                }
+                
+                return self::_customFilterTest(ruleValues, filterColumn->getJoin(), customRuleForBlanks);
+                
+            case \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_DYNAMICFILTER:
+                //    We should only ever have one Dynamic Filter Rule anyway
+                let rule = end(rules);
+                let dynamicRuleType = rule->getGrouping();
+                
+                if ((dynamicRuleType == \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_ABOVEAVERAGE) ||
+                    (dynamicRuleType == \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_BELOWAVERAGE)) {
+                    //    Average of the numeric values in the column, as AVERAGE() would calculate it
+                    let sum = 0;
+                    let numericCount = 0;
+                    
+                    for value in values {
+                        if (is_int(value) || is_float(value)) {
+                            let sum = sum + value;
+                            let numericCount = numericCount + 1;
+                        }
+                    }
+                    
+                    if (numericCount == 0) {
+                        //    AVERAGE() of no values is #DIV/0!, which matches nothing
+                        return ["method": "none", "arguments": []];
+                    }
+                    
+                    let operator = (dynamicRuleType === \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_RULETYPE_DYNAMIC_ABOVEAVERAGE)
+                        ? \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_GREATERTHAN
+                        : \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_LESSTHAN;
+                    
+                    return self::_customFilterTest(
+                        [["operator": operator, "value": sum / numericCount]],
+                        \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_COLUMN_JOIN_OR
+                    );
+                }
+                
+                if (substr(dynamicRuleType, 0, 1) == "M" || substr(dynamicRuleType, 0, 1) == "Q") {
+                    //    Month or Quarter
+                    let period = (int) substr(dynamicRuleType, 1);
+                    
+                    if (substr(dynamicRuleType, 0, 1) == "M") {
+                        let ruleValues = [period];
+                    } else {
+                        let ruleValues = range(period * 3 - 2, period * 3);
+                    }
+                    
+                    filterColumn->setAttributes([]);
+                    
+                    return ["method": "period", "arguments": ruleValues];
+                }
+                
+                //    Date Range
+                return this->_dynamicFilterDateRange(dynamicRuleType, filterColumn);
+                
+            case \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_FILTERTYPE_TOPTENFILTER:
+                //    We should only ever have one Top-10 Filter Rule anyway
+                for rule in rules {
+                    let toptenRuleType = rule->getGrouping();
+                    let ruleValue = rule->getValue();
+                    let ruleOperator = rule->getOperator();
+                }
+                
+                if (ruleOperator === \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_TOPTEN_PERCENT) {
+                    let ruleValue = floor(ruleValue * (dataRowCount / 100));
+                }
+                
+                if (ruleValue < 1) {
+                    let ruleValue = 1;
+                }
+                
+                if (ruleValue > 500) {
+                    let ruleValue = 500;
+                }
+                
+                let maxVal = self::_calculateTopTenValue(values, toptenRuleType, (int) ruleValue);
+                
+                let operator = (toptenRuleType == \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_TOPTEN_TOP)
+                    ? \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_GREATERTHANOREQUAL
+                    : \ZExcel\Worksheet\AutoFilter\Column\Rule::AUTOFILTER_COLUMN_RULE_LESSTHANOREQUAL;
+                
+                filterColumn->setAttributes(["maxVal": maxVal]);
+                
+                return self::_customFilterTest(
+                    [["operator": operator, "value": maxVal]],
+                    \ZExcel\Worksheet\AutoFilter\Column::AUTOFILTER_COLUMN_JOIN_OR
+                );
+        }
+        
+        return null;
     }
 
     /**
      *    Apply the AutoFilter rules to the AutoFilter Range
      *
+     *    Each filtered column is read once as a vector of calculated values, and its rules are compiled into
+     *    a single test. The selection of visible rows is then narrowed column by column (an AND of the column
+     *    selections), and row visibility is applied in one final pass.
+     *
      *    @throws    \ZExcel\Exception
      *    @return \ZExcel\Worksheet\AutoFilter
      */
     public function showHideRows()
     {
-        throw new \Exception("Not implemented yet!");
+        var tmp, rangeStart, rangeEnd, columnID, filterColumn, test, values, offset, rowDimension;
+        array columnValues = [], columnFilterTests = [], selected, passed;
+        int firstRow, lastRow, columnIndex, row;
+        
+        if (empty(this->_range)) {
+            throw new \ZExcel\Exception("No autofilter range is defined.");
+        }
+        
+        let tmp = \ZExcel\Cell::rangeBoundaries(this->_range);
+        let rangeStart = tmp[0];
+        let rangeEnd = tmp[1];
+        let firstRow = rangeStart[1] + 1;
+        let lastRow = rangeEnd[1];
+
+        //    The heading row should always be visible
+        this->_workSheet->getRowDimension(rangeStart[1])->setVisible(true);
+        
+        if (lastRow < firstRow) {
+            return this;
+        }
+        
+        for columnID, filterColumn in this->_columns {
+            let columnIndex = \ZExcel\Cell::columnIndexFromString(columnID);
+            let tmp = this->_workSheet->extractRangeBlock(columnIndex, columnIndex, firstRow, lastRow, [], true);
+            let values = tmp[0];
+            
+            let test = this->_compileColumnFilter(filterColumn, values, lastRow - rangeStart[1]);
+            
+            if (test !== null) {
+                let columnValues[columnID] = values;
+                let columnFilterTests[columnID] = test;
+            }
+        }
+        
+        //    Start with every data row selected, then AND each column selection into it
+        let selected = array_fill(0, lastRow - firstRow + 1, true);
+        
+        for columnID, test in columnFilterTests {
+            let values = columnValues[columnID];
+            let passed = [];
+            
+            for offset, _ in selected {
+                if (self::_filterTest(values[offset], test)) {
+                    let passed[offset] = true;
+                }
+            }
+            
+            let selected = passed;
+            
+            if (empty(selected)) {
+                break;
+            }
+        }
+        
+        //    Set show/hide for the rows; visible rows without a row dimension do not need one
+        for row in range(firstRow, lastRow) {
+            if (isset(selected[row - firstRow])) {
+                let rowDimension = this->_workSheet->getRowDimension(row, false);
+                
+                if (rowDimension !== null) {
+                    rowDimension->setVisible(true);
+                }
+            } else {
+                this->_workSheet->getRowDimension(row)->setVisible(false);
+            }
+        }
+
+        return this;
     }
 
 
@@ -274,9 +274,9 @@ class Rule
     /**
      * Get AutoFilter Rule Value
      *
-     * @return string
+     * @return string|string[]
      */
-    public function getValue() -> string
+    public function getValue()
     {
         return this->_value;
     }
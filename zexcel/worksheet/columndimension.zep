@@ -69,6 +69,10 @@ class ColumnDimension extends \ZExcel\Worksheet\Dimension
      */
     public function getWidth()
     {
+        if (this->store !== null) {
+            return this->store->getSize(this->storeKey);
+        }
+
         return this->width;
     }
 
@@ -80,6 +84,11 @@ class ColumnDimension extends \ZExcel\Worksheet\Dimension
      */
     public function setWidth(double pValue = -1) -> <\ZExcel\Worksheet\ColumnDimension>
     {
+        if (this->store !== null) {
+            this->store->setSize(this->storeKey, pValue);
+            return this;
+        }
+
         let this->width = pValue;
         
         return this;
@@ -92,6 +101,10 @@ class ColumnDimension extends \ZExcel\Worksheet\Dimension
      */
     public function getAutoSize()
     {
+        if (this->store !== null) {
+            return this->store->hasFlag(this->storeKey, \ZExcel\Worksheet\DimensionStore::FLAG_EXTRA);
+        }
+
         return this->autoSize;
     }
 
@@ -103,8 +116,28 @@ class ColumnDimension extends \ZExcel\Worksheet\Dimension
      */
     public function setAutoSize(boolean pValue = false) -> <\ZExcel\Worksheet\ColumnDimension>
     {
+        if (this->store !== null) {
+            this->store->setFlag(this->storeKey, \ZExcel\Worksheet\DimensionStore::FLAG_EXTRA, pValue);
+            return this;
+        }
+
         let this->autoSize = pValue;
         
         return this;
     }
+
+    /**
+     * Copy the values of this dimension out of its dimension store, and stop using the store
+     *
+     * @return \ZExcel\Worksheet\ColumnDimension
+     */
+    protected function detach() -> <\ZExcel\Worksheet\Dimension>
+    {
+        if (this->store !== null) {
+            let this->width = this->store->getSize(this->storeKey);
+            let this->autoSize = this->store->hasFlag(this->storeKey, \ZExcel\Worksheet\DimensionStore::FLAG_EXTRA);
+        }
+
+        return parent::detach();
+    }
 }
@@ -0,0 +1,480 @@
+namespace ZExcel\Worksheet;
+
+class DimensionStore
+{
+    /* Dimension kinds */
+    const ROWS    = "row";
+    const COLUMNS = "column";
+
+    /* Flags */
+    const FLAG_HIDDEN    = 1;
+    const FLAG_COLLAPSED = 2;
+    const FLAG_EXTRA     = 4;    // Zero height for rows, auto size for columns
+
+    /**
+     * Kind of dimension held (ROWS or COLUMNS)
+     *
+     * @var string
+     */
+    private kind;
+
+    /**
+     * Index to cellXf of a dimension without explicit format
+     *
+     * @var int|null
+     */
+    private defaultXfIndex;
+
+    /**
+     * Position of each dimension (row number, or column index for columns), indexed by row number or column letters
+     * Also lists the dimensions held, in the order they were created
+     *
+     * @var int[]
+     */
+    private positions = [];
+
+    /**
+     * Row heights or column widths (in pt), only for dimensions with an explicit size
+     *
+     * @var double[]
+     */
+    private sizes = [];
+
+    /**
+     * Indexes to cellXf, only for dimensions with an explicit format
+     *
+     * @var int[]
+     */
+    private xfIndexes = [];
+
+    /**
+     * FLAG_* bitmasks, only for dimensions with a flag set
+     *
+     * @var int[]
+     */
+    private flags = [];
+
+    /**
+     * Outline levels, only for dimensions with a non-zero outline level
+     *
+     * @var int[]
+     */
+    private outlineLevels = [];
+
+    /**
+     * Dimension objects handed out, viewing the data held here
+     *
+     * @var \ZExcel\Worksheet\Dimension[]
+     */
+    private views = [];
+
+    /**
+     * Highest position of the dimensions held
+     *
+     * @var int
+     */
+    private highest = 0;
+
+    /**
+     * Create a new dimension store
+     *
+     * @param string kind           ROWS or COLUMNS
+     * @param int    defaultXfIndex Index to cellXf of a dimension without explicit format
+     */
+    public function __construct(string kind = self::ROWS, var defaultXfIndex = null)
+    {
+        let this->kind = kind;
+        let this->defaultXfIndex = defaultXfIndex;
+    }
+
+    /**
+     * Is there a dimension record for a row or column?
+     *
+     * @param int|string key Row number or column letters
+     * @return boolean
+     */
+    public function has(var key) -> boolean
+    {
+        return isset(this->positions[key]);
+    }
+
+    /**
+     * Create the dimension record of a row or column, if it does not exist yet
+     *
+     * @param int|string key Row number or column letters
+     * @return \ZExcel\Worksheet\DimensionStore
+     */
+    public function touch(var key) -> <\ZExcel\Worksheet\DimensionStore>
+    {
+        int position;
+
+        if (isset(this->positions[key])) {
+            return this;
+        }
+
+        if (this->kind == self::ROWS) {
+            let position = (int) key;
+        } else {
+            let position = \ZExcel\Cell::columnIndexFromString(key);
+        }
+
+        let this->positions[key] = position;
+
+        if (position > this->highest) {
+            let this->highest = position;
+        }
+
+        return this;
+    }
+
+    /**
+     * Number of dimension records
+     *
+     * @return int
+     */
+    public function count() -> int
+    {
+        return count(this->positions);
+    }
+
+    /**
+     * Highest row number or column index with a dimension record
+     *
+     * @return int 0 if there is no record
+     */
+    public function getHighest() -> int
+    {
+        return this->highest;
+    }
+
+    /**
+     * Row numbers or column letters of the dimension records, in the order they were created
+     *
+     * @return array
+     */
+    public function getKeys() -> array
+    {
+        return array_keys(this->positions);
+    }
+
+    /**
+     * Get the dimension object of a row or column, creating the record if needed
+     *
+     * Dimension objects are views: their values are read from and written to this store
+     *
+     * @param int|string key Row number or column letters
+     * @return \ZExcel\Worksheet\Dimension
+     */
+    public function getView(var key) -> <\ZExcel\Worksheet\Dimension>
+    {
+        var view;
+
+        if (isset(this->views[key])) {
+            return this->views[key];
+        }
+
+        this->touch(key);
+
+        if (this->kind == self::ROWS) {
+            let view = new \ZExcel\Worksheet\RowDimension((int) key);
+        } else {
+            let view = new \ZExcel\Worksheet\ColumnDimension(key);
+        }
+
+        view->setStore(this, key);
+        let this->views[key] = view;
+
+        return view;
+    }
+
+    /**
+     * Get the dimension objects of every record, indexed by row number or column letters
+     *
+     * @return \ZExcel\Worksheet\Dimension[]
+     */
+    public function getViews() -> array
+    {
+        var key;
+        array views = [];
+
+        for key, _ in this->positions {
+            let views[key] = this->getView(key);
+        }
+
+        return views;
+    }
+
+    /**
+     * Move the records whose dimension object now has another index (e.g. after rows were inserted)
+     *
+     * @return \ZExcel\Worksheet\DimensionStore
+     */
+    public function reindexViews() -> <\ZExcel\Worksheet\DimensionStore>
+    {
+        var key, view, newKey, moved, record;
+        array pending = [];
+
+        for key, view in this->views {
+            if (this->kind == self::ROWS) {
+                let newKey = view->getRowIndex();
+            } else {
+                let newKey = view->getColumnIndex();
+            }
+
+            if (newKey != key) {
+                let pending[] = [view, newKey, this->export(key)];
+                this->remove(key);
+            }
+        }
+
+        for moved in pending {
+            let record = moved[2];
+            this->import(moved[1], record);
+            moved[0]->setStore(this, moved[1]);
+            let this->views[moved[1]] = moved[0];
+        }
+
+        return this;
+    }
+
+    /**
+     * Remove the dimension record of a row or column
+     *
+     * @param int|string key Row number or column letters
+     * @return \ZExcel\Worksheet\DimensionStore
+     */
+    public function remove(var key) -> <\ZExcel\Worksheet\DimensionStore>
+    {
+        var position;
+        int removed;
+
+        if (!isset(this->positions[key])) {
+            return this;
+        }
+
+        let removed = this->positions[key];
+
+        unset(this->positions[key]);
+        unset(this->sizes[key]);
+        unset(this->xfIndexes[key]);
+        unset(this->flags[key]);
+        unset(this->outlineLevels[key]);
+        unset(this->views[key]);
+
+        if (removed == this->highest) {
+            let this->highest = 0;
+
+            for position in this->positions {
+                if (position > this->highest) {
+                    let this->highest = position;
+                }
+            }
+        }
+
+        return this;
+    }
+
+    /**
+     * Get the values of a dimension record
+     *
+     * @param int|string key Row number or column letters
+     * @return array
+     */
+    private function export(var key) -> array
+    {
+        return [
+            isset(this->sizes[key]) ? this->sizes[key] : null,
+            isset(this->xfIndexes[key]) ? this->xfIndexes[key] : null,
+            isset(this->flags[key]) ? this->flags[key] : null,
+            isset(this->outlineLevels[key]) ? this->outlineLevels[key] : null
+        ];
+    }
+
+    /**
+     * Replace a dimension record with exported values
+     *
+     * @param int|string key    Row number or column letters
+     * @param array      record Values, as returned by export()
+     */
+    private function import(var key, array record)
+    {
+        this->remove(key);
+        this->touch(key);
+
+        if (record[0] !== null) {
+            let this->sizes[key] = record[0];
+        }
+        if (record[1] !== null) {
+            let this->xfIndexes[key] = record[1];
+        }
+        if (record[2] !== null) {
+            let this->flags[key] = record[2];
+        }
+        if (record[3] !== null) {
+            let this->outlineLevels[key] = record[3];
+        }
+    }
+
+    /**
+     * Get the row height or column width
+     *
+     * @param int|string key Row number or column letters
+     * @return double -1 if there is no explicit size
+     */
+    public function getSize(var key) -> double
+    {
+        if (isset(this->sizes[key])) {
+            return this->sizes[key];
+        }
+
+        return -1;
+    }
+
+    /**
+     * Set the row height or column width
+     *
+     * @param int|string key   Row number or column letters
+     * @param double     value Size, or a negative value for no explicit size
+     * @return \ZExcel\Worksheet\DimensionStore
+     */
+    public function setSize(var key, double value) -> <\ZExcel\Worksheet\DimensionStore>
+    {
+        this->touch(key);
+
+        if (value < 0) {
+            unset(this->sizes[key]);
+        } else {
+            let this->sizes[key] = value;
+        }
+
+        return this;
+    }
+
+    /**
+     * Get the index to cellXf
+     *
+     * @param int|string key Row number or column letters
+     * @return int|null
+     */
+    public function getXfIndex(var key)
+    {
+        if (isset(this->xfIndexes[key])) {
+            return this->xfIndexes[key];
+        }
+
+        return this->defaultXfIndex;
+    }
+
+    /**
+     * Set the index to cellXf
+     *
+     * @param int|string key   Row number or column letters
+     * @param int        value
+     * @return \ZExcel\Worksheet\DimensionStore
+     */
+    public function setXfIndex(var key, int value) -> <\ZExcel\Worksheet\DimensionStore>
+    {
+        this->touch(key);
+
+        let this->xfIndexes[key] = value;
+
+        return this;
+    }
+
+    /**
+     * Is a FLAG_* flag set?
+     *
+     * @param int|string key  Row number or column letters
+     * @param int        flag
+     * @return boolean
+     */
+    public function hasFlag(var key, int flag) -> boolean
+    {
+        if (!isset(this->flags[key])) {
+            return false;
+        }
+
+        return (this->flags[key] & flag) != 0;
+    }
+
+    /**
+     * Set or clear a FLAG_* flag
+     *
+     * @param int|string key   Row number or column letters
+     * @param int        flag
+     * @param boolean    value
+     * @return \ZExcel\Worksheet\DimensionStore
+     */
+    public function setFlag(var key, int flag, boolean value = true) -> <\ZExcel\Worksheet\DimensionStore>
+    {
+        int flags = 0;
+
+        this->touch(key);
+
+        if (isset(this->flags[key])) {
+            let flags = this->flags[key];
+        }
+
+        if (value) {
+            let flags = flags | flag;
+        } else {
+            let flags = flags & ~flag;
+        }
+
+        if (flags == 0) {
+            unset(this->flags[key]);
+        } else {
+            let this->flags[key] = flags;
+        }
+
+        return this;
+    }
+
+    /**
+     * Get the outline level
+     *
+     * @param int|string key Row number or column letters
+     * @return int
+     */
+    public function getOutlineLevel(var key) -> int
+    {
+        if (isset(this->outlineLevels[key])) {
+            return this->outlineLevels[key];
+        }
+
+        return 0;
+    }
+
+    /**
+     * Set the outline level
+     *
+     * @param int|string key   Row number or column letters
+     * @param int        value Outline level, between 0 and 7
+     * @throws \ZExcel\Exception
+     * @return \ZExcel\Worksheet\DimensionStore
+     */
+    public function setOutlineLevel(var key, int value) -> <\ZExcel\Worksheet\DimensionStore>
+    {
+        if (value < 0 || value > 7) {
+            throw new \ZExcel\Exception("Outline level must range between 0 and 7.");
+        }
+
+        this->touch(key);
+
+        if (value == 0) {
+            unset(this->outlineLevels[key]);
+        } else {
+            let this->outlineLevels[key] = value;
+        }
+
+        return this;
+    }
+
+    /**
+     * Implement PHP __clone: dimension objects handed out keep viewing the original store
+     */
+    public function __clone()
+    {
+        let this->views = [];
+    }
+}
@@ -0,0 +1,203 @@
+namespace ZExcel\Worksheet;
+
+class MergeIndex
+{
+    /**
+     * Column intervals covered by merge ranges, indexed by row and sorted by first column
+     * Each interval is [first column index, last column index, range]
+     *
+     * @var array
+     */
+    private rows = [];
+
+    /**
+     * Number of merge ranges held in the index
+     *
+     * @var int
+     */
+    private count = 0;
+
+    /**
+     * Whether some merge ranges overlap (Excel does not allow it, but nothing prevents it here)
+     *
+     * @var boolean
+     */
+    private overlapping = false;
+
+    /**
+     * Create a new merge index
+     *
+     * @param array mergeCells Merge ranges (e.g. ["A1:E1" => "A1:E1"])
+     */
+    public function __construct(array mergeCells = [])
+    {
+        var mergeRange;
+
+        for mergeRange in mergeCells {
+            this->add(mergeRange);
+        }
+    }
+
+    /**
+     * Add a merge range to the index
+     *
+     * The intervals of each row are kept sorted by their first column
+     *
+     * @param string mergeRange Cell range (e.g. A1:E1)
+     * @return \ZExcel\Worksheet\MergeIndex
+     */
+    public function add(string mergeRange) -> <\ZExcel\Worksheet\MergeIndex>
+    {
+        var boundaries, intervals;
+        int row, position;
+
+        let boundaries = \ZExcel\Cell::rangeBoundaries(mergeRange);
+
+        for row in range(boundaries[0][1], boundaries[1][1]) {
+            if (!isset(this->rows[row])) {
+                let this->rows[row] = [[boundaries[0][0], boundaries[1][0], mergeRange]];
+                continue;
+            }
+
+            let intervals = this->rows[row];
+            let position = self::search(intervals, boundaries[0][0]) + 1;
+
+            if ((position > 0 && intervals[position - 1][1] >= boundaries[0][0])
+                    || (position < count(intervals) && intervals[position][0] <= boundaries[1][0])) {
+                let this->overlapping = true;
+            }
+
+            array_splice(intervals, position, 0, [[boundaries[0][0], boundaries[1][0], mergeRange]]);
+            let this->rows[row] = intervals;
+        }
+
+        let this->count = this->count + 1;
+
+        return this;
+    }
+
+    /**
+     * Remove a merge range from the index
+     *
+     * @param string mergeRange Cell range (e.g. A1:E1)
+     * @return \ZExcel\Worksheet\MergeIndex
+     */
+    public function remove(string mergeRange) -> <\ZExcel\Worksheet\MergeIndex>
+    {
+        var boundaries, key, interval, intervals;
+        int row;
+        boolean found = false;
+
+        let boundaries = \ZExcel\Cell::rangeBoundaries(mergeRange);
+
+        for row in range(boundaries[0][1], boundaries[1][1]) {
+            if (!isset(this->rows[row])) {
+                continue;
+            }
+
+            let intervals = this->rows[row];
+
+            for key, interval in intervals {
+                if (interval[2] === mergeRange) {
+                    unset(intervals[key]);
+                    let found = true;
+                }
+            }
+
+            if (empty(intervals)) {
+                unset(this->rows[row]);
+            } else {
+                let this->rows[row] = array_values(intervals);
+            }
+        }
+
+        if (found) {
+            let this->count = this->count - 1;
+        }
+
+        return this;
+    }
+
+    /**
+     * Find the merge range containing a cell
+     *
+     * @param int column Column index (1-based, e.g. A = 1)
+     * @param int row    Row number
+     * @return string|null Merge range, or null if the cell is not merged
+     */
+    public function find(int column, int row)
+    {
+        var intervals;
+        int position;
+
+        if (!isset(this->rows[row])) {
+            return null;
+        }
+
+        let intervals = this->rows[row];
+        let position = self::search(intervals, column);
+
+        while (position >= 0) {
+            if (intervals[position][1] >= column) {
+                return intervals[position][2];
+            }
+
+            // Without overlaps, no interval starting further left can reach this column
+            if (!this->overlapping) {
+                break;
+            }
+
+            let position--;
+        }
+
+        return null;
+    }
+
+    /**
+     * Position of the last interval starting at or before a column
+     *
+     * @param array intervals Intervals of a row, sorted by first column
+     * @param int   column    Column index
+     * @return int Position, or -1 if every interval starts after the column
+     */
+    private static function search(array intervals, int column) -> int
+    {
+        int low = 0, high, middle;
+
+        let high = count(intervals) - 1;
+
+        while (low <= high) {
+            let middle = (low + high) >> 1;
+
+            if (intervals[middle][0] <= column) {
+                let low = middle + 1;
+            } else {
+                let high = middle - 1;
+            }
+        }
+
+        return high;
+    }
+
+    /**
+     * Is a cell part of a merge range?
+     *
+     * @param int column Column index (1-based, e.g. A = 1)
+     * @param int row    Row number
+     * @return boolean
+     */
+    public function contains(int column, int row) -> boolean
+    {
+        return this->find(column, row) !== null;
+    }
+
+    /**
+     * Does the index hold any merge range?
+     *
+     * @return boolean
+     */
+    public function isEmpty() -> boolean
+    {
+        return this->count == 0;
+    }
+}
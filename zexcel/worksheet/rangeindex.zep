@@ -0,0 +1,324 @@
+namespace ZExcel\Worksheet;
+
+class RangeIndex
+{
+    /* Rows covered by the index: 2 ^ ROW_LEVELS, the last row of a worksheet */
+    const ROW_LEVELS = 20;
+
+    /**
+     * Column intervals of the indexed areas, held by the nodes of a segment tree over rows
+     * Node 1 covers every row, and the rows of node n are split between nodes 2n and 2n + 1; row r is node
+     * 2 ^ ROW_LEVELS + r - 1. An area is held by the few nodes whose rows it covers entirely, so a lookup
+     * checks the nodes on the path from a row to the root
+     * Each node is [intervals sorted by first column, whether some intervals overlap], and each interval
+     * [first column index, last column index, range list, sequence]
+     *
+     * @var array
+     */
+    private nodes = [];
+
+    /**
+     * Areas of each indexed range list, as [first column index, first row, last column index, last row]
+     *
+     * @var array
+     */
+    private areas = [];
+
+    /**
+     * Sequence number of each indexed range list, indexed by range list
+     * A range list added later takes precedence over the ones it overlaps
+     *
+     * @var int[]
+     */
+    private sequences = [];
+
+    /**
+     * Next sequence number
+     *
+     * @var int
+     */
+    private sequence = 0;
+
+    /**
+     * Create a new range index
+     *
+     * @param array rangeLists Range lists (e.g. ["A1:A100 C1" => ...]), indexed in key order
+     */
+    public function __construct(array rangeLists = [])
+    {
+        var rangeList;
+
+        for rangeList, _ in rangeLists {
+            this->add(rangeList);
+        }
+    }
+
+    /**
+     * Add a range list to the index, or move it on top of the range lists it overlaps
+     *
+     * @param string rangeList Space separated cell ranges (e.g. "A1:A100 C1:D2 F5")
+     * @return \ZExcel\Worksheet\RangeIndex
+     */
+    public function add(string rangeList) -> <\ZExcel\Worksheet\RangeIndex>
+    {
+        var cellRange, boundaries, area, node;
+        int sequence, lastRow;
+        array areas = [];
+
+        if (isset(this->sequences[rangeList])) {
+            this->remove(rangeList);
+        }
+
+        let sequence = this->sequence;
+        let this->sequence = sequence + 1;
+        let this->sequences[rangeList] = sequence;
+        let lastRow = 1 << self::ROW_LEVELS;
+
+        for cellRange in explode(" ", rangeList) {
+            if (cellRange === "") {
+                continue;
+            }
+
+            let boundaries = \ZExcel\Cell::rangeBoundaries(cellRange);
+            let area = [
+                min(boundaries[0][0], boundaries[1][0]),
+                max(1, min(boundaries[0][1], boundaries[1][1])),
+                max(boundaries[0][0], boundaries[1][0]),
+                min(lastRow, max(boundaries[0][1], boundaries[1][1]))
+            ];
+
+            if (area[1] > area[3]) {
+                continue;
+            }
+
+            let areas[] = area;
+
+            for node in self::nodesCovering(area[1], area[3]) {
+                this->insertInterval(node, [area[0], area[2], rangeList, sequence]);
+            }
+        }
+
+        let this->areas[rangeList] = areas;
+
+        return this;
+    }
+
+    /**
+     * Remove a range list from the index
+     *
+     * @param string rangeList Space separated cell ranges (e.g. "A1:A100 C1:D2 F5")
+     * @return \ZExcel\Worksheet\RangeIndex
+     */
+    public function remove(string rangeList) -> <\ZExcel\Worksheet\RangeIndex>
+    {
+        var area, node;
+
+        if (!isset(this->sequences[rangeList])) {
+            return this;
+        }
+
+        for area in this->areas[rangeList] {
+            for node in self::nodesCovering(area[1], area[3]) {
+                this->removeInterval(node, rangeList);
+            }
+        }
+
+        unset(this->sequences[rangeList]);
+        unset(this->areas[rangeList]);
+
+        return this;
+    }
+
+    /**
+     * Find the range list covering a cell
+     *
+     * When several range lists cover the cell, the one added last is returned
+     *
+     * @param int column Column index (1-based, e.g. A = 1)
+     * @param int row    Row number
+     * @return string|null Range list, or null if no range list covers the cell
+     */
+    public function find(int column, int row)
+    {
+        var entry, intervals, interval, found = null;
+        int node, position, best = -1;
+
+        if (row < 1 || row > (1 << self::ROW_LEVELS)) {
+            return null;
+        }
+
+        let node = (1 << self::ROW_LEVELS) + row - 1;
+
+        while (node >= 1) {
+            if (isset(this->nodes[node])) {
+                let entry = this->nodes[node];
+                let intervals = entry[0];
+                let position = self::search(intervals, column);
+
+                while (position >= 0) {
+                    let interval = intervals[position];
+
+                    if (interval[1] >= column && interval[3] > best) {
+                        let best = interval[3];
+                        let found = interval[2];
+                    }
+
+                    // Without overlaps, no interval starting further left can reach this column
+                    if (!entry[1]) {
+                        break;
+                    }
+
+                    let position--;
+                }
+            }
+
+            let node = node >> 1;
+        }
+
+        return found;
+    }
+
+    /**
+     * Nodes of the segment tree whose rows make up a block of rows
+     *
+     * @param int firstRow
+     * @param int lastRow
+     * @return int[]
+     */
+    private static function nodesCovering(int firstRow, int lastRow) -> array
+    {
+        int low, high;
+        array nodes = [];
+
+        // Leaves from low (included) to high (excluded), then their parents, level by level
+        let low = (1 << self::ROW_LEVELS) + firstRow - 1;
+        let high = (1 << self::ROW_LEVELS) + lastRow;
+
+        while (low < high) {
+            if (low & 1) {
+                let nodes[] = low;
+                let low++;
+            }
+
+            if (high & 1) {
+                let high--;
+                let nodes[] = high;
+            }
+
+            let low = low >> 1;
+            let high = high >> 1;
+        }
+
+        return nodes;
+    }
+
+    /**
+     * Add a column interval to a node, keeping its intervals sorted by first column
+     *
+     * @param int   node
+     * @param array interval [first column index, last column index, range list, sequence]
+     */
+    private function insertInterval(int node, array interval)
+    {
+        var entry, intervals;
+        int position;
+
+        if (!isset(this->nodes[node])) {
+            let this->nodes[node] = [[interval], false];
+            return;
+        }
+
+        let entry = this->nodes[node];
+        let intervals = entry[0];
+        let position = self::search(intervals, interval[0]) + 1;
+
+        // Overlapping intervals always include a pair of neighbours
+        if ((position > 0 && intervals[position - 1][1] >= interval[0])
+                || (position < count(intervals) && intervals[position][0] <= interval[1])) {
+            let entry[1] = true;
+        }
+
+        array_splice(intervals, position, 0, [interval]);
+        let entry[0] = intervals;
+        let this->nodes[node] = entry;
+    }
+
+    /**
+     * Remove the column intervals of a range list from a node
+     *
+     * @param int    node
+     * @param string rangeList
+     */
+    private function removeInterval(int node, string rangeList)
+    {
+        var entry, intervals, key, interval;
+
+        if (!isset(this->nodes[node])) {
+            return;
+        }
+
+        let entry = this->nodes[node];
+        let intervals = entry[0];
+
+        for key, interval in intervals {
+            if (interval[2] === rangeList) {
+                unset(intervals[key]);
+            }
+        }
+
+        if (empty(intervals)) {
+            unset(this->nodes[node]);
+        } else {
+            let entry[0] = array_values(intervals);
+            let this->nodes[node] = entry;
+        }
+    }
+
+    /**
+     * Position of the last interval starting at or before a column
+     *
+     * @param array intervals Intervals of a node, sorted by first column
+     * @param int   column    Column index
+     * @return int Position, or -1 if every interval starts after the column
+     */
+    private static function search(array intervals, int column) -> int
+    {
+        int low = 0, high, middle;
+
+        let high = count(intervals) - 1;
+
+        while (low <= high) {
+            let middle = (low + high) >> 1;
+
+            if (intervals[middle][0] <= column) {
+                let low = middle + 1;
+            } else {
+                let high = middle - 1;
+            }
+        }
+
+        return high;
+    }
+
+    /**
+     * Is a cell covered by an indexed range list?
+     *
+     * @param int column Column index (1-based, e.g. A = 1)
+     * @param int row    Row number
+     * @return boolean
+     */
+    public function contains(int column, int row) -> boolean
+    {
+        return this->find(column, row) !== null;
+    }
+
+    /**
+     * Does the index hold any range list?
+     *
+     * @return boolean
+     */
+    public function isEmpty() -> boolean
+    {
+        return empty(this->sequences);
+    }
+}
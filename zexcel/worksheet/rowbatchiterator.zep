@@ -0,0 +1,152 @@
+namespace ZExcel\Worksheet;
+
+class RowBatchIterator implements \Iterator
+{
+    /**
+     * \ZExcel\Worksheet to iterate
+     *
+     * @var \ZExcel\Worksheet
+     */
+    private subject;
+
+    /**
+     * First row of the current batch
+     *
+     * @var int
+     */
+    private position = 1;
+
+    /**
+     * First column index (1-based)
+     *
+     * @var int
+     */
+    private startColumn = 1;
+
+    /**
+     * Last column index (1-based)
+     *
+     * @var int
+     */
+    private endColumn = 1;
+
+    /**
+     * Start row
+     *
+     * @var int
+     */
+    private startRow = 1;
+
+    /**
+     * End row
+     *
+     * @var int
+     */
+    private endRow = 1;
+
+    /**
+     * Number of rows per batch
+     *
+     * @var int
+     */
+    private batchSize = 1000;
+
+    /**
+     * Extraction options passed to \ZExcel\Worksheet::extractRangeBlock()
+     *
+     * @var array
+     */
+    private options = [];
+
+    /**
+     * Create a new row batch iterator
+     *
+     * @param    \ZExcel\Worksheet    subject      The worksheet to iterate over
+     * @param    string               pRange       Range of cells (i.e. "A1:B10")
+     * @param    integer              batchSize    Number of rows returned per batch
+     * @param    array                options      Extraction options, as for \ZExcel\Worksheet::rangeToColumnVectors()
+     * @throws   \ZExcel\Exception
+     */
+    public function __construct(<\ZExcel\Worksheet> subject, string pRange, int batchSize = 1000, array options = [])
+    {
+        var tmp, rangeStart, rangeEnd;
+
+        if (batchSize < 1) {
+            throw new \ZExcel\Exception("Batch size must be at least 1.");
+        }
+
+        let tmp = \ZExcel\Cell::rangeBoundaries(pRange);
+        let rangeStart = tmp[0];
+        let rangeEnd = tmp[1];
+
+        let this->subject = subject;
+        let this->startColumn = rangeStart[0];
+        let this->endColumn = rangeEnd[0];
+        let this->startRow = rangeStart[1];
+        let this->endRow = rangeEnd[1];
+        let this->batchSize = batchSize;
+        let this->options = options;
+        let this->position = this->startRow;
+    }
+
+    /**
+     * Destructor
+     */
+    public function __destruct()
+    {
+        unset(this->subject);
+    }
+
+    /**
+     * Rewind the iterator to the first batch
+     */
+    public function rewind()
+    {
+        let this->position = this->startRow;
+    }
+
+    /**
+     * Return the rows of the current batch
+     *
+     * @return array
+     */
+    public function current() -> array
+    {
+        return this->subject->extractRangeBlock(
+            this->startColumn,
+            this->endColumn,
+            this->position,
+            min(this->position + this->batchSize - 1, this->endRow),
+            this->options,
+            false
+        );
+    }
+
+    /**
+     * Return the first row number of the current batch
+     *
+     * @return int
+     */
+    public function key() -> int
+    {
+        return this->position;
+    }
+
+    /**
+     * Move to the next batch
+     */
+    public function next()
+    {
+        let this->position = this->position + this->batchSize;
+    }
+
+    /**
+     * Indicate if more rows remain in the range
+     *
+     * @return boolean
+     */
+    public function valid() -> boolean
+    {
+        return this->position <= this->endRow;
+    }
+}
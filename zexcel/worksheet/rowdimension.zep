@@ -69,6 +69,10 @@ class RowDimension extends \ZExcel\Worksheet\Dimension
      */
     public function getRowHeight()
     {
+        if (this->store !== null) {
+            return this->store->getSize(this->storeKey);
+        }
+
         return this->height;
     }
 
@@ -80,6 +84,11 @@ class RowDimension extends \ZExcel\Worksheet\Dimension
      */
     public function setRowHeight(double pValue = -1) -> <\ZExcel\Worksheet\RowDimension>
     {
+        if (this->store !== null) {
+            this->store->setSize(this->storeKey, pValue);
+            return this;
+        }
+
         let this->height = pValue;
         
         return this;
@@ -92,6 +101,10 @@ class RowDimension extends \ZExcel\Worksheet\Dimension
      */
     public function getZeroHeight()
     {
+        if (this->store !== null) {
+            return this->store->hasFlag(this->storeKey, \ZExcel\Worksheet\DimensionStore::FLAG_EXTRA);
+        }
+
         return this->zeroHeight;
     }
 
@@ -103,8 +116,28 @@ class RowDimension extends \ZExcel\Worksheet\Dimension
      */
     public function setZeroHeight(boolean pValue = false) -> <\ZExcel\Worksheet\RowDimension>
     {
+        if (this->store !== null) {
+            this->store->setFlag(this->storeKey, \ZExcel\Worksheet\DimensionStore::FLAG_EXTRA, pValue);
+            return this;
+        }
+
         let this->zeroHeight = pValue;
         
         return this;
     }
+
+    /**
+     * Copy the values of this dimension out of its dimension store, and stop using the store
+     *
+     * @return \ZExcel\Worksheet\RowDimension
+     */
+    protected function detach() -> <\ZExcel\Worksheet\Dimension>
+    {
+        if (this->store !== null) {
+            let this->height = this->store->getSize(this->storeKey);
+            let this->zeroHeight = this->store->hasFlag(this->storeKey, \ZExcel\Worksheet\DimensionStore::FLAG_EXTRA);
+        }
+
+        return parent::detach();
+    }
 }